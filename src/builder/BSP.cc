@@ -954,20 +954,20 @@ void BSP::check() const
   if (usedNodes.get(0)) {
     OZ_ERROR("BSP root node referenced");
   }
-  for (int i = 1; i < nodes.size(); ++i) {
-    if (!usedNodes.get(i)) {
-      OZ_ERROR("BSP node %d not referenced", i);
-    }
+
+  // Bitsets are padded to whole units, so a clear bit past the end is not an unreferenced element.
+  int unusedNode  = usedNodes.findNextClear(1);
+  int unusedLeaf  = usedLeaves.findNextClear(0);
+  int unusedBrush = usedBrushes.findNextClear(0);
+
+  if (unusedNode != -1 && unusedNode < nodes.size()) {
+    OZ_ERROR("BSP node %d not referenced", unusedNode);
   }
-  for (int i = 0; i < leaves.size(); ++i) {
-    if (!usedLeaves.get(i)) {
-      OZ_ERROR("BSP leaf %d not referenced", i);
-    }
+  if (unusedLeaf != -1 && unusedLeaf < leaves.size()) {
+    OZ_ERROR("BSP leaf %d not referenced", unusedLeaf);
   }
-  for (int i = 0; i < brushes.size(); ++i) {
-    if (!usedBrushes.get(i)) {
-      OZ_ERROR("BSP brush %d not referenced", i);
-    }
+  if (unusedBrush != -1 && unusedBrush < brushes.size()) {
+    OZ_ERROR("BSP brush %d not referenced", unusedBrush);
   }
 
   for (int i = 0; i < planes.size(); ++i) {
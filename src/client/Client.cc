@@ -54,6 +54,22 @@ static const PPB_InputEvent*      ppbInputEvent      = nullptr;
 static const PPB_MouseInputEvent* ppbMouseInputEvent = nullptr;
 #endif
 
+static void writeProfilerTrace()
+{
+  File traceFile = appConfig["dir.config"].get(File::CONFIG) + "/trace.json";
+
+  Log::print("Writing profiler trace to '%s' ...", traceFile.c());
+  Log::printEnd(Profiler::exportTrace(traceFile) ? " OK" : " Failed");
+}
+
+static void writeAllocSamples()
+{
+  File samplesFile = appConfig["dir.config"].get(File::CONFIG) + "/allocs.json";
+
+  Log::print("Writing allocation samples to '%s' ...", samplesFile.c());
+  Log::printEnd(Alloc::exportSamples(samplesFile) ? " OK" : " Failed");
+}
+
 void Client::printUsage()
 {
   Log::printRaw(
@@ -169,7 +185,10 @@ int Client::main()
         case SDL_KEYDOWN: {
           const SDL_Keysym& keysym = event.key.keysym;
 
-          if (keysym.sym == SDLK_F9) {
+          if (keysym.sym == SDLK_F6) {
+            writeProfilerTrace();
+          }
+          else if (keysym.sym == SDLK_F9) {
             if (keysym.mod & KMOD_CTRL) {
               ui::ui.isVisible = !ui::ui.isVisible;
             }
@@ -266,9 +285,15 @@ int Client::main()
 
     timer.tick();
 
+    // Transient per-tick lists of the main thread are allocated here.
+    FrameArena::local().reset();
+
     isAlive &= !isBenchmark || timer.time < benchmarkTime;
     isAlive &= stage->update();
 
+    // GL and AL jobs pinned to the main thread.
+    JobSystem::processMain();
+
     if (Stage::nextStage != nullptr) {
       stage->unload();
 
@@ -428,7 +453,7 @@ int Client::init(int argc, char** argv)
   configDir.mkdir();
   dataDir.mkdir();
 
-  if (Log::init(configDir / "client.log", true)) {
+  if (Log::init(configDir / "client.log", true, true)) {
     Log::println("Log file '%s'", Log::file().c());
   }
 
@@ -483,6 +508,9 @@ int Client::init(int argc, char** argv)
   appConfig.include("dir.pictures", picturesDir).get(String::EMPTY);
   appConfig.include("dir.music", musicDir).get(String::EMPTY);
   appConfig.include("dir.prefix", prefixDir).get(String::EMPTY);
+  appConfig.include("profiler.trace", false).get(false);
+
+  Alloc::setSampleInterval(size_t(appConfig.include("profiler.allocSampleInterval", 0).get(0)));
 
   windowWidth  = appConfig.include("window.windowWidth",  1280).get(0);
   windowHeight = appConfig.include("window.windowHeight", 720 ).get(0);
@@ -602,6 +630,30 @@ int Client::init(int argc, char** argv)
 
   Log::println("Random generator seed set to: %u", seed);
 
+  const System::CpuTopology& topology = System::cpuTopology();
+
+  Log::println("CPU: %d packages, %d cores, %d threads, L1d %d KiB, L2 %d KiB, L3 %d KiB",
+               topology.nPackages, topology.nCores, topology.nCpus,
+               topology.l1DataCacheSize / 1024, topology.l2CacheSize / 1024,
+               topology.l3CacheSize / 1024);
+
+  const String& placement = appConfig.include("thread.placement", "FREE").get(String::EMPTY);
+  int nCriticalCores = appConfig.include("thread.criticalCores", 3).get(3);
+
+  if (placement == "SEPARATE_CORES") {
+    Thread::setPlacement(Thread::SEPARATE_CORES, nCriticalCores);
+    Thread::place(Thread::CRITICAL, 0);
+  }
+  else if (placement != "FREE") {
+    OZ_ERROR("Configuration variable 'thread.placement' must be either \"FREE\" or"
+             " \"SEPARATE_CORES\"");
+  }
+
+  initFlags |= INIT_JOBS;
+  JobSystem::init(appConfig.include("jobs.workers", -1).get(-1));
+
+  Log::println("Job system started with %d workers", JobSystem::nWorkers());
+
   sound.initLibs();
 
   initFlags |= INIT_LIBRARY;
@@ -672,6 +724,9 @@ void Client::shutdown()
     gameStage.destroy();
     menuStage.destroy();
   }
+  if (initFlags & INIT_JOBS) {
+    JobSystem::destroy();
+  }
   if (initFlags & INIT_AUDIO) {
     sound.destroy();
   }
@@ -702,6 +757,13 @@ void Client::shutdown()
   if (initFlags & INIT_MAIN_LOOP) {
     File configFile = appConfig["dir.config"].get(File::CONFIG) + "/client.json";
 
+    if (appConfig["profiler.trace"].get(false)) {
+      writeProfilerTrace();
+    }
+    if (Alloc::sampleInterval() != 0) {
+      writeAllocSamples();
+    }
+
     if (!(initFlags & INIT_CONFIG)) {
       appConfig.exclude("dir.config");
       appConfig.exclude("dir.data");
@@ -725,6 +787,9 @@ void Client::shutdown()
     Log::println("OpenZone " OZ_VERSION " finished on %s", Time::local().toString().c());
   }
 
+  // The log file stays open for the memory leak report, `main()` closes it.
+  Log::stopAsync();
+
 #ifdef __native_client__
   Pepper::post("quit");
 #endif
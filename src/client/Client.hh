@@ -39,6 +39,7 @@ class Client
 private:
 
   static const int INIT_CONFIG     = 0x0001;
+  static const int INIT_JOBS       = 0x0002;
   static const int INIT_WINDOW     = 0x0008;
   static const int INIT_INPUT      = 0x0010;
   static const int INIT_NETWORK    = 0x0020;
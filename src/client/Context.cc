@@ -685,8 +685,8 @@ void Context::load()
   maxBotAudios          = 0;
   maxVehicleAudios      = 0;
 
-  imagines = HashMap<int, Imago*>(4096);
-  audios   = HashMap<int, Audio*>(1024);
+  imagines = FlatHashMap<int, Imago*>(4096);
+  audios   = FlatHashMap<int, Audio*>(1024);
 
   if (!dynamicLoading) {
     loadResources();
@@ -110,50 +110,50 @@ private:
 
 private:
 
-  static int               speakSampleRate;       // Set from Sound class.
-  static SpeakSource       speakSource;
+  static int                   speakSampleRate;   // Set from Sound class.
+  static SpeakSource           speakSource;
 
-  Imago::CreateFunc**      imagoClasses;
-  Audio::CreateFunc**      audioClasses;
-  FragPool**               fragPools;
+  Imago::CreateFunc**          imagoClasses;
+  Audio::CreateFunc**          audioClasses;
+  FragPool**                   fragPools;
 
-  TextureResource*         textures;
-  SoundResource*           sounds;
+  TextureResource*             textures;
+  SoundResource*               sounds;
 
-  Chain<Source>            sources;               // Non-looping sources.
-  HashMap<int, ContSource> contSources;           // Looping sources.
+  Chain<Source>                sources;           // Non-looping sources.
+  FlatHashMap<int, ContSource> contSources;       // Looping sources.
 
-  Chain<PartGen>           partGens;
+  Chain<PartGen>               partGens;
 
-  Resource<Model*>*        models;
-  Resource<PartClass>*     partClasses;
+  Resource<Model*>*            models;
+  Resource<PartClass>*         partClasses;
 
-  Resource<BSPImago*>*     bspImagines;
-  Resource<BSPAudio*>*     bspAudios;
+  Resource<BSPImago*>*         bspImagines;
+  Resource<BSPAudio*>*         bspAudios;
 
-  HashMap<int, Imago*>     imagines;              // Currently loaded graphics models.
-  HashMap<int, Audio*>     audios;                // Currently loaded audio models.
+  FlatHashMap<int, Imago*>     imagines;          // Currently loaded graphics models.
+  FlatHashMap<int, Audio*>     audios;            // Currently loaded audio models.
 
-  int                      maxImagines;
-  int                      maxAudios;
-  int                      maxSources;
-  int                      maxContSources;
-  int                      maxPartGens;
+  int                          maxImagines;
+  int                          maxAudios;
+  int                          maxSources;
+  int                          maxContSources;
+  int                          maxPartGens;
 
-  int                      maxSMMImagines;
-  int                      maxSMMVehicleImagines;
-  int                      maxExplosionImagines;
-  int                      maxMD2Imagines;
-  int                      maxMD2WeaponImagines;
+  int                          maxSMMImagines;
+  int                          maxSMMVehicleImagines;
+  int                          maxExplosionImagines;
+  int                          maxMD2Imagines;
+  int                          maxMD2WeaponImagines;
 
-  int                      maxBasicAudios;
-  int                      maxBotAudios;
-  int                      maxVehicleAudios;
+  int                          maxBasicAudios;
+  int                          maxBotAudios;
+  int                          maxVehicleAudios;
 
 public:
 
-  int                      textureLod;
-  bool                     dynamicLoading;
+  int                          textureLod;
+  bool                         dynamicLoading;
 
 private:
 
@@ -76,25 +76,39 @@ void EditStage::write() const
 
 void EditStage::auxMain(void*)
 {
+  Thread::place(Thread::CRITICAL, 1);
   editStage.auxRun();
 }
 
 void EditStage::auxRun()
 {
-  auxSemaphore.wait();
+  for (;;) {
+    phaseBarrier.wait();
+
+    if (!isAuxAlive.load<ATOMIC_RELAXED>()) {
+      break;
+    }
+
+    /*
+     * PHASE 1
+     *
+     * Nothing, main thread may manipulate world here.
+     */
+
+    phaseBarrier.wait();
 
-  while (isAuxAlive.load<ATOMIC_RELAXED>()) {
     /*
      * PHASE 2
      *
      * World is being updated, other threads should not access world structures here.
      */
 
+    FrameArena::local().reset();
+
     // update world
     matrix.update();
 
-    mainSemaphore.post();
-    auxSemaphore.wait();
+    phaseBarrier.wait();
 
     /*
      * PHASE 3
@@ -107,20 +121,12 @@ void EditStage::auxRun()
 
     // we can now manipulate world from the main thread after synapse lists have been cleared
     // and nirvana is not accessing matrix any more
-    mainSemaphore.post();
-    auxSemaphore.wait();
-
-    /*
-     * PHASE 1
-     *
-     * Nothing, main thread may manipulate world here.
-     */
   }
 }
 
 bool EditStage::update()
 {
-  mainSemaphore.wait();
+  phaseBarrier.wait();
 
   /*
    * PHASE 1
@@ -159,7 +165,7 @@ bool EditStage::update()
 
   camera.prepare();
 
-  auxSemaphore.post();
+  phaseBarrier.wait();
 
   /*
    * PHASE 2
@@ -171,8 +177,7 @@ bool EditStage::update()
   context.updateLoad();
   loader.update();
 
-  auxSemaphore.post();
-  mainSemaphore.wait();
+  phaseBarrier.wait();
 
   /*
    * PHASE 3
@@ -245,8 +250,6 @@ void EditStage::load()
 
   isAuxAlive.store<ATOMIC_RELAXED>(true);
 
-  mainSemaphore.post();
-
   auxThread = Thread("aux", auxMain);
 
   ui::ui.showLoadingScreen(false);
@@ -271,8 +274,7 @@ void EditStage::unload()
 
   isAuxAlive.store<ATOMIC_RELAXED>(false);
 
-  auxSemaphore.post();
-  mainSemaphore.wait();
+  phaseBarrier.wait();
   auxThread.join();
 
   ui::ui.root->remove(editFrame);
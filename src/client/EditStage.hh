@@ -37,8 +37,7 @@ class EditStage : public Stage
 private:
 
   Thread         auxThread;
-  Semaphore      mainSemaphore;
-  Semaphore      auxSemaphore;
+  PhaseBarrier   phaseBarrier{2};
   Atomic<bool>   isAuxAlive;
 
 public:
@@ -26,6 +26,15 @@ namespace oz
 namespace client
 {
 
+int Frustum::visibleSpheres(const Batch::Coords& centres, const float* radii, int count,
+                            int* indices) const
+{
+  // Front plane normal points out of the frustum, unlike the others.
+  Plane planes[] = {left_, right_, up_, down_, Plane(-front_.n, -front_.d)};
+
+  return Batch::spheresInPlanes(centres, radii, count, planes, 5, indices);
+}
+
 void Frustum::getExtrems(Span& span, const Point& p)
 {
   span.minX = max(int((p.x - radius_ + Orbis::DIM) / Cell::SIZE), 0);
@@ -72,6 +72,10 @@ public:
            (mins * front_ < +radius || maxs * front_ < +radius);
   }
 
+  // indices of spheres that are visible, written to `indices`
+  int visibleSpheres(const Batch::Coords& centres, const float* radii, int count,
+                     int* indices) const;
+
   // get min and max index for cells per each axis, which should be included in PVS
   void getExtrems(Span& span, const Point& p);
 
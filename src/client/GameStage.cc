@@ -45,9 +45,13 @@ const uint GameStage::AUTOSAVE_INTERVAL = 150 * Timer::TICKS_PER_SEC;
 
 void GameStage::saveMain(void*)
 {
+  Thread::place(Thread::BACKGROUND);
+
+  OZ_PROFILER_ZONE("GameStage::saveMain");
+
   Log::print("Saving state to %s ...", gameStage.saveFile.c());
 
-  if (!gameStage.saveFile.write(gameStage.saveStream.compress())) {
+  if (!gameStage.saveFile.write(gameStage.saveStream.compress(Stream::LZ4))) {
     Log::printEnd(" Failed");
     System::bell();
   }
@@ -63,7 +67,7 @@ void GameStage::read()
 {
   Log::print("Loading state from '%s' ...", stateFile.c());
 
-  Stream is = stateFile.read().decompress();
+  Stream is = stateFile.map().decompress();
   if (is.available() == 0) {
     OZ_ERROR("Reading saved state '%s' failed", stateFile.c());
   }
@@ -106,31 +110,53 @@ void GameStage::write()
 
 void GameStage::auxMain(void*)
 {
+  Thread::place(Thread::CRITICAL, 1);
   gameStage.auxRun();
 }
 
 void GameStage::auxRun()
 {
-  auxSemaphore.wait();
+  for (;;) {
+    phaseBarrier.wait();
+
+    if (!isAuxAlive.load<ATOMIC_RELAXED>()) {
+      break;
+    }
+
+    /*
+     * PHASE 1
+     *
+     * Nothing, main thread may manipulate world here.
+     */
+
+    phaseBarrier.wait();
 
-  while (isAuxAlive.load<ATOMIC_RELAXED>()) {
     /*
      * PHASE 2
      *
      * World is being updated, other threads should not access world structures here.
      */
 
+    FrameArena::local().reset();
+
     Instant beginInstant = Instant::now();
 
-    network.update();
+    {
+      OZ_PROFILER_ZONE("network.update");
+
+      network.update();
+    }
+    {
+      OZ_PROFILER_ZONE("matrix.update");
+      Alloc::Tag allocTag("matrix");
 
-    // update world
-    matrix.update();
+      // update world
+      matrix.update();
+    }
 
     matrixDuration += Instant::now() - beginInstant;
 
-    mainSemaphore.post();
-    auxSemaphore.wait();
+    phaseBarrier.wait();
 
     /*
      * PHASE 3
@@ -140,33 +166,32 @@ void GameStage::auxRun()
 
     beginInstant = Instant::now();
 
-    // sync nirvana
-    nirvana.sync();
+    {
+      OZ_PROFILER_ZONE("nirvana.update");
+      Alloc::Tag allocTag("nirvana");
 
-    // now synapse lists are not needed any more
-    synapse.update();
+      // sync nirvana
+      nirvana.sync();
 
-    // update minds
-    nirvana.update();
+      // now synapse lists are not needed any more
+      synapse.update();
+
+      // update minds
+      nirvana.update();
+    }
 
     nirvanaDuration += Instant::now() - beginInstant;
 
     // we can now manipulate world from the main thread after synapse lists have been cleared
     // and nirvana is not accessing matrix any more
-    mainSemaphore.post();
-    auxSemaphore.wait();
-
-    /*
-     * PHASE 1
-     *
-     * Nothing, main thread may manipulate world here.
-     */
   }
 }
 
 bool GameStage::update()
 {
-  mainSemaphore.wait();
+  Alloc::Tag allocTag("client");
+
+  phaseBarrier.wait();
 
   /*
    * PHASE 1
@@ -174,6 +199,8 @@ bool GameStage::update()
    * UI update, world may be updated from the main thread during this phase.
    */
 
+  OZ_PROFILER_ZONE("GameStage::update");
+
   Instant beginInstant = Instant::now();
 
   if (input.keys[Input::KEY_QUIT]) {
@@ -214,7 +241,7 @@ bool GameStage::update()
 
   uiDuration += Instant::now() - beginInstant;
 
-  auxSemaphore.post();
+  phaseBarrier.wait();
 
   /*
    * PHASE 2
@@ -225,13 +252,16 @@ bool GameStage::update()
 
   beginInstant = Instant::now();
 
-  context.updateLoad();
-  loader.update();
+  {
+    OZ_PROFILER_ZONE("loader.update");
+
+    context.updateLoad();
+    loader.update();
+  }
 
   loaderDuration += Instant::now() - beginInstant;
 
-  auxSemaphore.post();
-  mainSemaphore.wait();
+  phaseBarrier.wait();
 
   /*
    * PHASE 3
@@ -239,13 +269,19 @@ bool GameStage::update()
    * AI is processed in auxiliary thread here, world is rendered later in this phase in present().
    */
 
-  camera.update();
+  {
+    OZ_PROFILER_ZONE("camera.update");
+
+    camera.update();
+  }
 
   return true;
 }
 
 void GameStage::present(bool isFull)
 {
+  OZ_PROFILER_ZONE("GameStage::present");
+
   Instant beginInstant   = Instant::now();
   Instant currentInstant;
 
@@ -332,7 +368,8 @@ void GameStage::load()
 
   ui::ui.questFrame->enable(true);
 
-  startTicks = timer.ticks;
+  startTicks      = timer.ticks;
+  startAllocCount = Alloc::sumCount;
 
   ui::ui.showLoadingScreen(true);
 
@@ -343,8 +380,6 @@ void GameStage::load()
 
   isAuxAlive.store<ATOMIC_RELAXED>(true);
 
-  mainSemaphore.post();
-
   auxThread = Thread("aux", auxMain);
 
   ui::ui.showLoadingScreen(false);
@@ -376,11 +411,11 @@ void GameStage::unload()
 
   isAuxAlive.store<ATOMIC_RELAXED>(false);
 
-  auxSemaphore.post();
-  mainSemaphore.wait();
+  phaseBarrier.wait();
   auxThread.join();
 
   ulong64  ticks                 = timer.ticks - startTicks;
+  int      nAllocs               = Alloc::sumCount - startAllocCount;
   Duration soundMicros           = sound.effectsDuration + sound.musicDuration;
   Duration renderMicros          = render.prepareDuration + render.caelumDuration + render.terraDuration +
                                    render.meshesDuration + render.miscDuration +
@@ -450,6 +485,11 @@ void GameStage::unload()
   Log::println("frame rate in run time  %6.2f Hz", float(timer.nFrames) / runTime             );
   Log::println("frame drop rate         %6.2f %%", frameDropRate * 100.0f                     );
   Log::println("frame drops           %8lu",       ulong(nFrameDrops)                         );
+#ifdef OZ_ALLOCATOR
+  Log::println("allocations per tick  %8.2f",      float(nAllocs) / float(ticks)              );
+#else
+  static_cast<void>(nAllocs);
+#endif
   Log::println("Run time usage {");
   Log::indent();
   Log::println("Ph0  %6.2f %%  [M] sleep",            sleepTime             / runTime * 100.0f);
@@ -39,6 +39,7 @@ private:
   static const uint AUTOSAVE_INTERVAL;
 
   ulong64      startTicks;
+  int          startAllocCount;
   Duration     sleepDuration;
   Duration     loadingDuration;
   Duration     uiDuration;
@@ -54,8 +55,7 @@ private:
   Thread       saveThread;
 
   Thread       auxThread;
-  Semaphore    mainSemaphore;
-  Semaphore    auxSemaphore;
+  PhaseBarrier phaseBarrier{2};
   Atomic<bool> isAuxAlive;
 
 public:
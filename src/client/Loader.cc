@@ -31,6 +31,7 @@ namespace client
 
 void Loader::preloadMain(void*)
 {
+  Thread::place(Thread::BACKGROUND);
   loader.preloadRun();
 }
 
@@ -296,7 +297,11 @@ void Loader::preloadRun()
   preloadAuxSemaphore.wait();
 
   while (isPreloadAlive.load<ATOMIC_RELAXED>()) {
-    preloadRender();
+    {
+      OZ_PROFILER_ZONE("Loader::preloadRun");
+
+      preloadRender();
+    }
 
     preloadMainSemaphore.post();
     preloadAuxSemaphore.wait();
@@ -31,6 +31,8 @@ static LuaClient& lua = luaClient;
 
 void LuaClient::staticCall(const char* functionName)
 {
+  Alloc::Tag allocTag("lua");
+
   lua_State* l = l_;
 
   ms.obj      = nullptr;
@@ -234,6 +236,7 @@ void LuaClient::init()
 
   IMPORT_FUNC(ozError);
   IMPORT_FUNC(ozPrintln);
+  IMPORT_FUNC(ozAtom);
 
   IMPORT_FUNC(ozGettext);
 
@@ -400,7 +400,7 @@ const File* Model::preload()
   preloadData = new PreloadData();
   preloadData->modelFile = path;
 
-  Stream is = preloadData->modelFile.read(Endian::LITTLE);
+  Stream is = preloadData->modelFile.map(Endian::LITTLE);
 
   if (is.available() == 0) {
     OZ_ERROR("Failed to read '%s'", path.c());
@@ -564,7 +564,7 @@ void Model::load()
   OZ_NACL_IS_MAIN(true);
 
   OZ_ASSERT(preloadData != nullptr);
-  Stream is = preloadData->modelFile.read(Endian::LITTLE);
+  Stream is = preloadData->modelFile.map(Endian::LITTLE);
 
   is.readInt();
   is.read<Vec3>();
@@ -38,11 +38,11 @@ void Profile::save()
 
   profileConfig.add("_version", OZ_VERSION);
   profileConfig.add("name", name);
-  profileConfig.add("class", clazz == nullptr ? String::EMPTY : clazz->name);
+  profileConfig.add("class", clazz == nullptr ? "" : clazz->name.c());
 
   Json& itemsConfig = profileConfig.add("items", Json::ARRAY);
   for (const ObjectClass* item : items) {
-    itemsConfig.add(item->name);
+    itemsConfig.add(item->name.c());
   }
 
   profileConfig.add("weaponItem", weaponItem);
@@ -124,7 +124,7 @@ void Profile::init()
                    weaponItem, weaponClazz->name.c());
         }
 
-        if (!clazz->name.beginsWith(weaponClazz->userBase)) {
+        if (!String::beginsWith(clazz->name.c(), weaponClazz->userBase)) {
           OZ_ERROR("Invalid weapon class '%s' for player class '%s' in profile",
                    weaponClazz->name.c(), clazz->name.c());
         }
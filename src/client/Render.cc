@@ -81,10 +81,20 @@ struct Render::DrawEntry
   {
     return distance < de.distance;
   }
+
+  struct Distance
+  {
+    OZ_ALWAYS_INLINE
+    float operator()(const DrawEntry& de) const
+    {
+      return de.distance;
+    }
+  };
 };
 
 void Render::effectsMain(void*)
 {
+  Thread::place(Thread::CRITICAL, 2);
   render.effectsRun();
 }
 
@@ -122,11 +132,15 @@ void Render::effectsRun()
   effectsAuxSemaphore.wait();
 
   while (areEffectsAlive.load<ATOMIC_RELAXED>()) {
-    Span span = orbis.getInters(camera.p, EFFECTS_DISTANCE);
+    {
+      OZ_PROFILER_ZONE("Render::effectsRun");
+
+      Span span = orbis.getInters(camera.p, EFFECTS_DISTANCE);
 
-    for (int x = span.minX ; x <= span.maxX; ++x) {
-      for (int y = span.minY; y <= span.maxY; ++y) {
-        cellEffects(x, y);
+      for (int x = span.minX ; x <= span.maxX; ++x) {
+        for (int y = span.minY; y <= span.maxY; ++y) {
+          cellEffects(x, y);
+        }
       }
     }
 
@@ -154,33 +168,67 @@ void Render::scheduleCell(int cellX, int cellY)
     }
   }
 
-  for (const Object& obj : cell.objects) {
-    float radius = obj.dim.fastN();
+  for (const Frag& frag : cell.frags) {
+    float dist = (frag.p - camera.p) * camera.at;
 
-    if (obj.flags & Object::WIDE_CULL_BIT) {
-      radius *= WIDE_CULL_FACTOR;
+    if (dist <= FRAG_VISIBILITY_RANGE2 && frustum.isVisible(frag.p, FragPool::FRAG_RADIUS)) {
+      context.drawFrag(&frag);
     }
+  }
+}
 
-    if (frustum.isVisible(obj.p, radius)) {
-      float distance = (obj.p - camera.p).fastN();
-
-      if (radius / (distance * camera.mag) >= OBJECT_VISIBILITY_COEF) {
-        objects.add(DrawEntry(distance, &obj));
+void Render::scheduleObjects(const Cell* const* cells, int nCells, int nObjects)
+{
+  FrameArena& arena = FrameArena::local();
+
+  // Bounding spheres of all objects in visible cells are gathered into arrays and culled at once.
+  const Object** candidates = static_cast<const Object**>(arena.allocate(size_t(nObjects) *
+                                                                          sizeof(const Object*)));
+  float*         x          = static_cast<float*>(arena.allocate(size_t(nObjects) * sizeof(float)));
+  float*         y          = static_cast<float*>(arena.allocate(size_t(nObjects) * sizeof(float)));
+  float*         z          = static_cast<float*>(arena.allocate(size_t(nObjects) * sizeof(float)));
+  float*         radii      = static_cast<float*>(arena.allocate(size_t(nObjects) * sizeof(float)));
+  int*           indices    = static_cast<int*>(arena.allocate(size_t(nObjects) * sizeof(int)));
+  int            n          = 0;
+
+  for (int i = 0; i < nCells; ++i) {
+    for (const Object& obj : cells[i]->objects) {
+      float radius = obj.dim.fastN();
+
+      if (obj.flags & Object::WIDE_CULL_BIT) {
+        radius *= WIDE_CULL_FACTOR;
       }
+
+      candidates[n] = &obj;
+      x[n]          = obj.p.x;
+      y[n]          = obj.p.y;
+      z[n]          = obj.p.z;
+      radii[n]      = radius;
+      ++n;
     }
   }
 
-  for (const Frag& frag : cell.frags) {
-    float dist = (frag.p - camera.p) * camera.at;
+  Batch::Coords centres  = {x, y, z};
+  int           nVisible = frustum.visibleSpheres(centres, radii, nObjects, indices);
 
-    if (dist <= FRAG_VISIBILITY_RANGE2 && frustum.isVisible(frag.p, FragPool::FRAG_RADIUS)) {
-      context.drawFrag(&frag);
+  // Objects list is allocated last so it does not need to grow.
+  objects.reserve(nVisible);
+
+  for (int i = 0; i < nVisible; ++i) {
+    const Object* obj      = candidates[indices[i]];
+    float         radius   = radii[indices[i]];
+    float         distance = (obj->p - camera.p).fastN();
+
+    if (radius / (distance * camera.mag) >= OBJECT_VISIBILITY_COEF) {
+      objects.add(DrawEntry(distance, obj));
     }
   }
 }
 
 void Render::prepareDraw()
 {
+  OZ_PROFILER_ZONE("Render::prepareDraw");
+
   Instant currentInstant = Instant::now();
   Instant beginInstant   = currentInstant;
 
@@ -239,6 +287,14 @@ void Render::prepareDraw()
   // drawnStructs
   drawnStructs.clear();
 
+  structs.reserve(64);
+
+  int          maxCells = (span.maxX - span.minX + 1) * (span.maxY - span.minY + 1);
+  const Cell** cells    = static_cast<const Cell**>(FrameArena::local().allocate(size_t(maxCells) *
+                                                                                 sizeof(Cell*)));
+  int          nCells   = 0;
+  int          nObjects = 0;
+
   float minXCentre = float((span.minX - Orbis::CELLS / 2) * Cell::SIZE + Cell::SIZE / 2);
   float minYCentre = float((span.minY - Orbis::CELLS / 2) * Cell::SIZE + Cell::SIZE / 2);
 
@@ -248,16 +304,27 @@ void Render::prepareDraw()
     for (int j = span.minY; j <= span.maxY; ++j, y = y + Cell::SIZE) {
       if (frustum.isVisible(x, y, CELL_RADIUS)) {
         scheduleCell(i, j);
+
+        cells[nCells] = &orbis.cells[i][j];
+        nObjects     += cells[nCells]->objects.size();
+        ++nCells;
       }
     }
   }
 
-  structs.sort();
+  scheduleObjects(cells, nCells, nObjects);
+
+  // Draw lists are nearly sorted from frame to frame, radix sort is linear regardless of that.
+  sortBuffer.resize(max(structs.size(), objects.size()), true);
+
+  Arrays::radixSort<DrawEntry, DrawEntry::Distance>(structs.begin(), structs.size(),
+                                                    sortBuffer.begin());
   for (int i = 0; i < structs.size(); ++i) {
     context.drawBSP(structs[i].str);
   }
 
-  objects.sort();
+  Arrays::radixSort<DrawEntry, DrawEntry::Distance>(objects.begin(), objects.size(),
+                                                    sortBuffer.begin());
   for (int i = 0; i < objects.size(); ++i) {
     context.drawImago(objects[i].obj, nullptr);
   }
@@ -268,6 +335,8 @@ void Render::prepareDraw()
 
 void Render::drawGeometry()
 {
+  OZ_PROFILER_ZONE("Render::drawGeometry");
+
   Instant currentInstant = Instant::now();
   Instant beginInstant = currentInstant;
 
@@ -398,8 +467,15 @@ void Render::drawGeometry()
 
   OZ_GL_CHECK_ERROR();
 
+  // Draw lists live in the main thread's frame arena, release them before it is reset.
   structs.clear();
+  structs.trim();
+
   objects.clear();
+  objects.trim();
+
+  sortBuffer.clear();
+  sortBuffer.trim();
 
   currentInstant = Instant::now();
   miscDuration += currentInstant - beginInstant;
@@ -486,6 +562,8 @@ void Render::drawOrbis()
 
 void Render::drawUI()
 {
+  OZ_PROFILER_ZONE("Render::drawUI");
+
   Instant beginInstant = Instant::now();
 
   ui::ui.draw();
@@ -649,9 +727,6 @@ void Render::load()
 
   effectsThread = Thread("effects", effectsMain);
 
-  structs.reserve(64);
-  objects.reserve(8192);
-
   prepareDuration     = Duration::ZERO;
   caelumDuration      = Duration::ZERO;
   terraDuration       = Duration::ZERO;
@@ -678,6 +753,9 @@ void Render::unload()
   objects.clear();
   objects.trim();
 
+  sortBuffer.clear();
+  sortBuffer.trim();
+
   areEffectsAlive.store<ATOMIC_RELAXED>(false);
 
   effectsAuxSemaphore.post();
@@ -72,10 +72,11 @@ private:
 
   struct DrawEntry;
 
-  SBitset<Orbis::MAX_STRUCTS> drawnStructs;
+  HBitset<Orbis::MAX_STRUCTS> drawnStructs;
 
-  List<DrawEntry>             structs;
-  List<DrawEntry>             objects;
+  FrameList<DrawEntry>        structs;
+  FrameList<DrawEntry>        objects;
+  FrameList<DrawEntry>        sortBuffer;
 
   float                       visibilityRange;
   float                       visibility;
@@ -127,6 +128,7 @@ private:
   void effectsRun();
 
   void scheduleCell(int cellX, int cellY);
+  void scheduleObjects(const Cell* const* cells, int nCells, int nObjects);
   void prepareDraw();
   void drawGeometry();
 
@@ -71,7 +71,7 @@ class Transform
 
 private:
 
-  SList<Mat4, 8> stack;
+  SmallList<Mat4, 8> stack;
 
 public:
 
@@ -34,11 +34,13 @@ const float Sound::SOUND_DISTANCE = 192.0f;
 
 void Sound::musicMain(void*)
 {
+  Thread::place(Thread::BACKGROUND);
   sound.musicRun();
 }
 
 void Sound::soundMain(void*)
 {
+  Thread::place(Thread::BACKGROUND);
   sound.soundRun();
 }
 
@@ -50,6 +52,8 @@ void Sound::musicRun()
     musicMainSemaphore.post();
     musicAuxSemaphore.wait();
 
+    OZ_PROFILER_ZONE("Sound::musicRun");
+
     int oldSelectedTrack = selectedTrack.exchange<ATOMIC_RELAXED>(-1);
     if (oldSelectedTrack != -1) {
       if (streamedTrack >= 0) {
@@ -214,12 +218,14 @@ void Sound::soundRun()
 
     currentInstant = Instant::now();
     effectsDuration += currentInstant - beginInstant ;
+    Profiler::record("Sound::playCells", beginInstant, currentInstant);
     beginInstant  = currentInstant;
 
     updateMusic();
 
     currentInstant = Instant::now();
     musicDuration += currentInstant - beginInstant ;
+    Profiler::record("Sound::updateMusic", beginInstant, currentInstant);
 
     soundMainSemaphore.post();
     soundAuxSemaphore.wait();
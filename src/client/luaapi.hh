@@ -256,7 +256,7 @@ static int ozProfileGetClass(lua_State* l)
 {
   ARG(0);
 
-  l_pushstring(profile.clazz == nullptr ? String::EMPTY : profile.clazz->name);
+  l_pushstring(profile.clazz == nullptr ? "" : profile.clazz->name.c());
   return 1;
 }
 
@@ -283,7 +283,7 @@ static int ozProfileGetItems(lua_State* l)
   for (int i = 0; i < profile.items.size(); ++i) {
     const ObjectClass* clazz = profile.items[i];
 
-    l_pushstring(clazz->name);
+    l_pushstring(clazz->name.c());
     l_rawseti(-2, i);
   }
 
@@ -339,7 +339,7 @@ static int ozProfileSetWeaponItem(lua_State* l)
     }
 
     const WeaponClass* weaponClazz = static_cast<const WeaponClass*>(clazz);
-    if (profile.clazz->name.beginsWith(weaponClazz->userBase)) {
+    if (String::beginsWith(profile.clazz->name.c(), weaponClazz->userBase)) {
       profile.weaponItem = item;
     }
   }
@@ -73,8 +73,8 @@ void BuildFrame::overlayCallback(Area* area, const Vec3& ray)
     Bounds    bounds   = rotate(*bsp, heading) + (position - Point::ORIGIN);
     BSPImago* bspModel = context.requestBSP(bsp);
 
-    List<Struct*> strs;
-    List<Object*> objs;
+    FrameList<Struct*> strs;
+    FrameList<Object*> objs;
 
     collider.getOverlaps(bounds.toAABB(), &strs, &objs, 2.0f * EPSILON);
     overlaps  = !strs.isEmpty() || !objs.isEmpty();
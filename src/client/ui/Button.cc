@@ -91,7 +91,7 @@ Button::Button(const char* s, Callback* callback_, int width, int height)
 
 void Button::setText(const char* s)
 {
-  text.setText("%s", s);
+  text.setPlainText(s);
 }
 
 void Button::setCallback(Callback* callback_)
@@ -97,7 +97,7 @@ CheckBox::CheckBox(const char* text, int width, int height)
 
 void CheckBox::setLabel(const char* text)
 {
-  label.setText("%s", text);
+  label.setPlainText(text);
 }
 
 }
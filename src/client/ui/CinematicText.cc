@@ -51,7 +51,7 @@ CinematicText::CinematicText()
 
 void CinematicText::set(const char* text)
 {
-  text_.setText("%s", text);
+  text_.setPlainText(text);
 }
 
 }
@@ -29,63 +29,111 @@ namespace client
 namespace ui
 {
 
+// Debug line, built in a fixed buffer with `String::formatInt()` and `String::formatFloat()`
+// instead of vsnprintf, since all lines are refreshed every frame.
+struct DebugLine
+{
+  char buffer[256] = "";
+  int  length      = 0;
+
+  DebugLine& add(const char* s)
+  {
+    int sLength = min<int>(String::length(s), 255 - length);
+
+    memcpy(buffer + length, s, size_t(sLength));
+    length += sLength;
+    buffer[length] = '\0';
+    return *this;
+  }
+
+  // Same as `%d`.
+  DebugLine& add(int i)
+  {
+    char number[String::INT_BUFFER_SIZE];
+    String::formatInt(number, i);
+
+    return add(number);
+  }
+
+  // Same as `%d`.
+  DebugLine& add(bool b)
+  {
+    return add(int(b));
+  }
+
+  // Same as `%+.*f`.
+  DebugLine& add(float f, int precision = 2)
+  {
+    char number[String::FLOAT_BUFFER_SIZE];
+    String::formatFloat(number, f, precision);
+
+    return add(number[0] == '-' ? "" : "+").add(number);
+  }
+
+  // Same as `(%+.2f %+.2f %+.2f)`.
+  DebugLine& add(const VectorBase3& v)
+  {
+    return add("(").add(v.x).add(" ").add(v.y).add(" ").add(v.z).add(")");
+  }
+
+  // Same as `(%+.2f %+.2f %+.2f %+.2f)`.
+  DebugLine& add(const VectorBase4& v)
+  {
+    return add("(").add(v.x).add(" ").add(v.y).add(" ").add(v.z).add(" ").add(v.w).add(")");
+  }
+
+  // Same as `d %d fl %d lw %d fr %d bl %d lq %d sl %d ld %d`.
+  DebugLine& addFlags(const Dynamic* dyn)
+  {
+    return add("d ").add((dyn->flags & Object::DISABLED_BIT) != 0)
+           .add(" fl ").add((dyn->flags & Object::ON_FLOOR_BIT) != 0)
+           .add(" lw ").add(dyn->lower)
+           .add(" fr ").add((dyn->flags & Object::FRICTING_BIT) != 0)
+           .add(" bl ").add((dyn->flags & Object::BELOW_BIT) != 0)
+           .add(" lq ").add((dyn->flags & Object::IN_LIQUID_BIT) != 0)
+           .add(" sl ").add((dyn->flags & Object::ON_SLICK_BIT) != 0)
+           .add(" ld ").add((dyn->flags & Object::ON_LADDER_BIT) != 0);
+  }
+};
+
 void DebugFrame::onDraw()
 {
   Frame::onDraw();
 
-  camPosRot.setText("cam.p(%+.2f %+.2f %+.2f) cam.rot(%+.2f %+.2f %+.2f %+.2f)",
-                    camera.p.x, camera.p.y, camera.p.z,
-                    camera.rot.x, camera.rot.y, camera.rot.z, camera.rot.w);
+  camPosRot.setPlainText(DebugLine().add("cam.p").add(camera.p)
+                                    .add(" cam.rot").add(camera.rot).buffer);
   camPosRot.draw(this);
 
   if (camera.bot != -1) {
     const Bot* bot = static_cast<const Bot*>(camera.botObj);
 
-    botPosRot.setText("bot.pos(%+.2f %+.2f %+.2f) bot.rot(%+.2f %+.2f)",
-                      bot->p.x, bot->p.y, bot->p.z,
-                      Math::deg(bot->h), Math::deg(bot->v));
+    botPosRot.setPlainText(DebugLine().add("bot.pos").add(bot->p)
+                                      .add(" bot.rot(").add(Math::deg(bot->h))
+                                      .add(" ").add(Math::deg(bot->v)).add(")").buffer);
     botPosRot.draw(this);
 
-    botVelMom.setText("bot.vel(%+.2f %+.2f %+.2f) bot.mom(%+.2f %+.2f %+.2f) bot.wd %+.2f",
-                      bot->velocity.x, bot->velocity.y, bot->velocity.z,
-                      bot->momentum.x, bot->momentum.y, bot->momentum.z,
-                      bot->depth);
+    botVelMom.setPlainText(DebugLine().add("bot.vel").add(bot->velocity)
+                                      .add(" bot.mom").add(bot->momentum)
+                                      .add(" bot.wd ").add(bot->depth).buffer);
     botVelMom.draw(this);
 
-    botFlagsState.setText("d %d fl %d lw %d fr %d bl %d lq %d sl %d ld %d ovlp %d sr %+.3f",
-                          (bot->flags & Object::DISABLED_BIT) != 0,
-                          (bot->flags & Object::ON_FLOOR_BIT) != 0,
-                          bot->lower,
-                          (bot->flags & Object::FRICTING_BIT) != 0,
-                          (bot->flags & Object::BELOW_BIT) != 0,
-                          (bot->flags & Object::IN_LIQUID_BIT) != 0,
-                          (bot->flags & Object::ON_SLICK_BIT) != 0,
-                          (bot->flags & Object::ON_LADDER_BIT) != 0,
-                          collider.overlaps(bot),
-                          bot->stairRate);
+    botFlagsState.setPlainText(DebugLine().addFlags(bot)
+                                          .add(" ovlp ").add(collider.overlaps(bot))
+                                          .add(" sr ").add(bot->stairRate, 3).buffer);
     botFlagsState.draw(this);
   }
 
   if (camera.object != -1 && (camera.objectObj->flags & Object::DYNAMIC_BIT)) {
     const Dynamic* dyn = static_cast<const Dynamic*>(camera.objectObj);
 
-    tagPos.setText("tagDyn.pos(%+.2f %+.2f %+.2f)", dyn->p.x, dyn->p.y, dyn->p.z);
+    tagPos.setPlainText(DebugLine().add("tagDyn.pos").add(dyn->p).buffer);
     tagPos.draw(this);
 
-    tagVelMom.setText("tagDyn.vel(%+.2f %+.2f %+.2f) tagDyn.mom(%+.2f %+.2f %+.2f)",
-                      dyn->velocity.x, dyn->velocity.y, dyn->velocity.z,
-                      dyn->momentum.x, dyn->momentum.y, dyn->momentum.z);
+    tagVelMom.setPlainText(DebugLine().add("tagDyn.vel").add(dyn->velocity)
+                                      .add(" tagDyn.mom").add(dyn->momentum).buffer);
     tagVelMom.draw(this);
 
-    tagFlags.setText("d %d fl %d lw %d fr %d bl %d lq %d sl %d ld %d",
-                     (dyn->flags & Object::DISABLED_BIT) != 0,
-                     (dyn->flags & Object::ON_FLOOR_BIT) != 0,
-                     dyn->lower,
-                     (dyn->flags & Object::FRICTING_BIT) != 0,
-                     (dyn->flags & Object::BELOW_BIT) != 0,
-                     (dyn->flags & Object::IN_LIQUID_BIT) != 0,
-                     (dyn->flags & Object::ON_SLICK_BIT) != 0,
-                     (dyn->flags & Object::ON_LADDER_BIT) != 0);
+    tagFlags.setPlainText(DebugLine().addFlags(dyn).buffer);
     tagFlags.draw(this);
   }
 }
@@ -167,7 +167,7 @@ void EditFrame::onDraw()
       ownerModels[i]->setModel(item == nullptr ? -1 : item->clazz->imagoModel);
     }
     else {
-      ownerModels[i]->show(id < owner->items.capacity());
+      ownerModels[i]->show(id < owner->clazz->nItems);
       ownerModels[i]->setModel(-1);
     }
   }
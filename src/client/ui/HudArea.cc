@@ -66,7 +66,7 @@ void HudArea::drawBotCrosshair()
     }
 
     if (ent != nullptr) {
-      title.setText("%s", entClazz->title.c());
+      title.setPlainText(entClazz->title);
       title.draw(this);
 
       shape.colour(1.0f, 1.0f, 1.0f, 1.0f);
@@ -100,7 +100,7 @@ void HudArea::drawBotCrosshair()
         taggedStatus.draw(this, healthBarX, healthBarY + 7, ICON_SIZE + 16, 8, status);
       }
 
-      title.setText("%s", obj->title().c());
+      title.setPlainText(obj->title());
       title.draw(this);
 
       shape.colour(1.0f, 1.0f, 1.0f, 1.0f);
@@ -192,13 +192,16 @@ void HudArea::drawBotStatus()
     weaponName.setPosition(pos.x + 4, pos.y + 2);
     weaponRounds.setPosition(pos.x + style.botWeapon.w - 4, pos.y + 2);
 
-    weaponName.setText("%s", weaponObj->clazz->title.c());
+    weaponName.setPlainText(weaponObj->clazz->title);
 
     if (weaponObj->nRounds == -1) {
-      weaponRounds.setText("∞");
+      weaponRounds.setPlainText("∞");
     }
     else {
-      weaponRounds.setText("%d", weaponObj->nRounds);
+      char buffer[String::INT_BUFFER_SIZE];
+      String::formatInt(buffer, weaponObj->nRounds);
+
+      weaponRounds.setPlainText(buffer);
     }
 
     weaponName.draw(this);
@@ -246,13 +249,16 @@ void HudArea::drawVehicleStatus()
     nameLabel.setPosition(pos.x + 2, pos.y + 2);
     roundsLabel.setPosition(pos.x + areaStyle.w - 4, pos.y + 2);
 
-    nameLabel.setText("%s", vehClazz->weaponTitles[i].c());
+    nameLabel.setPlainText(vehClazz->weaponTitles[i]);
 
     if (vehicle->nRounds[i] == -1) {
-      roundsLabel.setText("∞");
+      roundsLabel.setPlainText("∞");
     }
     else {
-      roundsLabel.setText("%d", vehicle->nRounds[i]);
+      char buffer[String::INT_BUFFER_SIZE];
+      String::formatInt(buffer, vehicle->nRounds[i]);
+
+      roundsLabel.setPlainText(buffer);
     }
 
     nameLabel.draw(this);
@@ -201,7 +201,7 @@ void Inventory::drawComponent(int height, const Object* container, const Dynamic
 noIcon:
 
   itemDesc.setPosition(-ICON_SIZE - 8, height - FOOTER_SIZE / 2);
-  itemDesc.setText("%s", taggedClazz->title.c());
+  itemDesc.setPlainText(taggedClazz->title);
   itemDesc.draw(this);
 }
 
@@ -252,7 +252,7 @@ void Inventory::onDraw()
   const Object*  container  = other == nullptr ? owner : other;
   const Dynamic* taggedItem = orbis.obj<const Dynamic>(taggedItemIndex);
 
-  title.setText("%s", container->title().c());
+  title.setPlainText(container->title());
 
   for (int i = 0; i < COLS; ++i) {
     int id = scrollOwner * COLS + i;
@@ -264,7 +264,7 @@ void Inventory::onDraw()
       ownerModels[i]->setModel(item == nullptr ? -1 : item->clazz->imagoModel);
     }
     else {
-      ownerModels[i]->show(id < owner->items.capacity());
+      ownerModels[i]->show(id < owner->clazz->nItems);
       ownerModels[i]->setModel(-1);
     }
   }
@@ -279,7 +279,7 @@ void Inventory::onDraw()
       otherModels[i]->setModel(item == nullptr ? -1 : item->clazz->imagoModel);
     }
     else {
-      otherModels[i]->show(other != nullptr && id < other->items.capacity());
+      otherModels[i]->show(other != nullptr && id < other->clazz->nItems);
       otherModels[i]->setModel(-1);
     }
   }
@@ -65,15 +65,15 @@ Text::~Text()
 }
 
 Text::Text(Text&& l) noexcept
-  : x(l.x), y(l.y), width(l.width), align(l.align), font(l.font), lastHash(l.lastHash),
-    texX(l.texX), texY(l.texY), texWidth(l.texWidth), texHeight(l.texHeight), texId(l.texId)
+  : x(l.x), y(l.y), width(l.width), align(l.align), font(l.font),
+    lastText(static_cast<List<char>&&>(l.lastText)), texX(l.texX), texY(l.texY),
+    texWidth(l.texWidth), texHeight(l.texHeight), texId(l.texId)
 {
   l.x         = 0;
   l.y         = 0;
   l.width     = 0;
   l.align     = Area::ALIGN_NONE;
   l.font      = nullptr;
-  l.lastHash  = Hash<const char*>::EMPTY;
   l.texX      = 0;
   l.texY      = 0;
   l.texWidth  = 0;
@@ -91,7 +91,7 @@ Text& Text::operator=(Text&& l) noexcept
     width     = l.width;
     align     = l.align;
     font      = l.font;
-    lastHash  = l.lastHash;
+    lastText  = static_cast<List<char>&&>(l.lastText);
     texX      = l.texX;
     texY      = l.texY;
     texWidth  = l.texWidth;
@@ -103,7 +103,6 @@ Text& Text::operator=(Text&& l) noexcept
     l.width     = 0;
     l.align     = Area::ALIGN_NONE;
     l.font      = nullptr;
-    l.lastHash  = Hash<const char*>::EMPTY;
     l.texX      = 0;
     l.texY      = 0;
     l.texWidth  = 0;
@@ -123,16 +122,16 @@ void Text::setPosition(int x_, int y_)
 
 void Text::setWidth(int width_)
 {
-  width    = width_;
-  lastHash = Hash<const char*>::EMPTY;
+  width = width_;
+  lastText.clear();
 
   realign();
 }
 
 void Text::setAlign(int align_)
 {
-  align    = align_;
-  lastHash = Hash<const char*>::EMPTY;
+  align = align_;
+  lastText.clear();
 
   realign();
 }
@@ -150,42 +149,55 @@ void Text::setTextv(const char* s, va_list ap)
   vsnprintf(buffer, 1024, s, ap);
   buffer[1023] = '\0';
 
-  if (buffer[0] == '\0') {
+  setPlainText(buffer);
+}
+
+void Text::setText(const char* s, ...)
+{
+  va_list ap;
+  va_start(ap, s);
+  setTextv(s, ap);
+  va_end(ap);
+}
+
+void Text::setPlainText(const char* s)
+{
+  OZ_ASSERT(s != nullptr);
+
+  if (s[0] == '\0') {
     clear();
   }
   else {
-    int newHash = Hash<const char*>()(buffer);
+    int length = String::length(s);
 
-    if (newHash != lastHash) {
-      lastHash = newHash;
-      texWidth = width;
+    // Only re-render when the text actually changes, most labels are updated every frame. The
+    // buffer keeps its capacity, so updating the text does not allocate either.
+    if (lastText.size() == length && Arrays::equals<char>(s, length, lastText.begin())) {
+      return;
+    }
 
-      MainCall() << [&]
-      {
-        if (texId == 0) {
-          glGenTextures(1, &texId);
-        }
+    lastText.resize(length);
+    memcpy(lastText.begin(), s, size_t(length));
 
-        glBindTexture(GL_TEXTURE_2D, texId);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    texWidth = width;
 
-        font->upload(buffer, &texWidth, &texHeight);
+    MainCall() << [&]
+    {
+      if (texId == 0) {
+        glGenTextures(1, &texId);
+      }
 
-        glBindTexture(GL_TEXTURE_2D, shader.defaultTexture);
+      glBindTexture(GL_TEXTURE_2D, texId);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
-        realign();
-      };
-    }
-  }
-}
+      font->upload(s, &texWidth, &texHeight);
 
-void Text::setText(const char* s, ...)
-{
-  va_list ap;
-  va_start(ap, s);
-  setTextv(s, ap);
-  va_end(ap);
+      glBindTexture(GL_TEXTURE_2D, shader.defaultTexture);
+
+      realign();
+    };
+  }
 }
 
 void Text::draw(const Area* area)
@@ -215,12 +227,13 @@ void Text::clear()
       glDeleteTextures(1, &texId);
     };
 
-    lastHash  = Hash<const char*>::EMPTY;
     texX      = x;
     texY      = y;
     texWidth  = 0;
     texHeight = 0;
     texId     = 0;
+
+    lastText.clear();
   }
 }
 
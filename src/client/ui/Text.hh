@@ -36,18 +36,18 @@ class Text
 {
 private:
 
-  int   x         = 0;
-  int   y         = 0;
-  int   width     = 0;
-  int   align     = Area::ALIGN_NONE;
-  Font* font      = nullptr;
-  int   lastHash  = Hash<const char*>::EMPTY;
-
-  int   texX      = 0;
-  int   texY      = 0;
-  int   texWidth  = 0;
-  int   texHeight = 0;
-  uint  texId     = 0;
+  int        x         = 0;
+  int        y         = 0;
+  int        width     = 0;
+  int        align     = Area::ALIGN_NONE;
+  Font*      font      = nullptr;
+  List<char> lastText;
+
+  int        texX      = 0;
+  int        texY      = 0;
+  int        texWidth  = 0;
+  int        texHeight = 0;
+  uint       texId     = 0;
 
 private:
 
@@ -72,6 +72,7 @@ public:
   void setTextv(const char* s, va_list ap);
   OZ_PRINTF_FORMAT(2, 3)
   void setText(const char* s, ...);
+  void setPlainText(const char* s);
 
   void draw(const Area* area);
 
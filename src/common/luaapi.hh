@@ -84,6 +84,25 @@ static int ozPrintln(lua_State* l)
   return 0;
 }
 
+/**
+ * Intern a string.
+ *
+ * @code atom ozAtom(string name) @endcode
+ *
+ * The returned handle can be passed to functions that take class, pool or BSP names instead of a
+ * string. Scripts that spawn the same names repeatedly should cache it, so lookups compare
+ * pointers instead of hashing strings.
+ */
+static int ozAtom(lua_State* l)
+{
+  ARG(1);
+
+  Atom atom = l_toatom(1);
+
+  l_pushatom(atom);
+  return 1;
+}
+
 /// @}
 
 }
@@ -346,6 +346,14 @@
 #define l_tostring(i) \
   lua_tolstring(l, i, nullptr)
 
+/**
+ * @def l_toatom
+ * Read `Atom` from either a string or an atom handle returned by `ozAtom()`
+ */
+#define l_toatom(i) \
+  (lua_type(l, i) == LUA_TLIGHTUSERDATA ? Atom::fromHandle(lua_touserdata(l, i)) \
+                                        : Atom(lua_tolstring(l, i, nullptr)))
+
 /**
  * @def l_tolstring
  * Shorthand for lua_tolstring
@@ -395,6 +403,13 @@
 #define l_pushstring(s) \
   lua_pushstring(l, s)
 
+/**
+ * @def l_pushatom
+ * Push `Atom` handle as a light userdata
+ */
+#define l_pushatom(a) \
+  lua_pushlightuserdata(l, const_cast<void*>(a.handle()))
+
 /**
  * @def l_pushvalue
  * Shorthand for lua_pushvalue
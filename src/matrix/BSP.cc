@@ -25,6 +25,154 @@
 namespace oz
 {
 
+/**
+ * Brush reference used while building the BVH.
+ */
+struct BVHBrush
+{
+  Point centre;
+  int   index;
+};
+
+template <int AXIS>
+struct BVHBrushLess
+{
+  OZ_ALWAYS_INLINE
+  bool operator()(const BVHBrush& a, const BVHBrush& b) const
+  {
+    return a.centre[AXIS] < b.centre[AXIS];
+  }
+};
+
+/**
+ * Bounds of a brush from vertices, i.e. intersections of side plane triples that lie in the brush.
+ */
+static Bounds calcBrushBounds(const BSP* bsp, const BSP::Brush& brush)
+{
+  Bounds bounds(Point(+Math::INF, +Math::INF, +Math::INF),
+                Point(-Math::INF, -Math::INF, -Math::INF));
+
+  for (int i = 0; i < brush.nSides; ++i) {
+    const Plane& a = bsp->planes[bsp->brushSides[brush.firstSide + i]];
+
+    for (int j = i + 1; j < brush.nSides; ++j) {
+      const Plane& b = bsp->planes[bsp->brushSides[brush.firstSide + j]];
+
+      for (int k = j + 1; k < brush.nSides; ++k) {
+        const Plane& c = bsp->planes[bsp->brushSides[brush.firstSide + k]];
+
+        Vec3  bc  = b.n ^ c.n;
+        float det = a.n * bc;
+
+        if (abs(det) < 1e-6f) {
+          continue;
+        }
+
+        Point vertex = Point::ORIGIN + (a.d * bc + b.d * (c.n ^ a.n) + c.d * (a.n ^ b.n)) / det;
+        bool  isIn   = true;
+
+        for (int l = 0; l < brush.nSides && isIn; ++l) {
+          isIn = vertex * bsp->planes[bsp->brushSides[brush.firstSide + l]] <= 4.0f * EPSILON;
+        }
+
+        if (isIn) {
+          bounds.mins = min(bounds.mins, vertex);
+          bounds.maxs = max(bounds.maxs, vertex);
+        }
+      }
+    }
+  }
+
+  // Degenerate brushes (should not happen) are conservatively bounded by the whole BSP.
+  if (bounds.mins.x > bounds.maxs.x) {
+    return *bsp;
+  }
+  return Bounds(bounds, 2.0f * EPSILON);
+}
+
+/**
+ * Recursively build a BVH node over a range of brushes, splitting it by the median centre along
+ * the longest axis of the centres' bounds.
+ */
+static void buildBVHNode(BSP* bsp, BVHBrush* brushes, int first, int count)
+{
+  int nodeIndex = bsp->nBVHNodes;
+  ++bsp->nBVHNodes;
+
+  BSP::BVHNode& node = bsp->bvhNodes[nodeIndex];
+  Bounds centres(Point(+Math::INF, +Math::INF, +Math::INF),
+                 Point(-Math::INF, -Math::INF, -Math::INF));
+
+  node.mins = centres.mins;
+  node.maxs = centres.maxs;
+
+  for (int i = first; i < first + count; ++i) {
+    const Bounds& bounds = bsp->brushBounds[brushes[i].index];
+
+    node.mins    = min(node.mins, bounds.mins);
+    node.maxs    = max(node.maxs, bounds.maxs);
+    centres.mins = min(centres.mins, brushes[i].centre);
+    centres.maxs = max(centres.maxs, brushes[i].centre);
+  }
+
+  if (count <= BSP::BVH_LEAF_SIZE) {
+    node.first    = first;
+    node.nBrushes = count;
+
+    for (int i = first; i < first + count; ++i) {
+      bsp->bvhBrushes[i] = brushes[i].index;
+    }
+    return;
+  }
+
+  Vec3 extent = centres.maxs - centres.mins;
+
+  if (extent.x >= extent.y && extent.x >= extent.z) {
+    Arrays::sort<BVHBrush, BVHBrushLess<0>>(brushes + first, count);
+  }
+  else if (extent.y >= extent.z) {
+    Arrays::sort<BVHBrush, BVHBrushLess<1>>(brushes + first, count);
+  }
+  else {
+    Arrays::sort<BVHBrush, BVHBrushLess<2>>(brushes + first, count);
+  }
+
+  int half = count / 2;
+
+  node.nBrushes = 0;
+
+  buildBVHNode(bsp, brushes, first, half);
+  bsp->bvhNodes[nodeIndex].first = bsp->nBVHNodes;
+  buildBVHNode(bsp, brushes, first + half, count - half);
+}
+
+/**
+ * Build hierarchy over brushes referenced from BSP leaves (entities' brushes are not among them).
+ */
+static void buildBVH(BSP* bsp)
+{
+  SBitset<BSP::MAX_BRUSHES> isStatic;
+  List<BVHBrush>            brushes;
+
+  for (int i = 0; i < bsp->nLeafBrushes; ++i) {
+    int index = bsp->leafBrushes[i];
+
+    if (!isStatic.get(index)) {
+      const Bounds& bounds = bsp->brushBounds[index];
+
+      isStatic.set(index);
+      brushes.add(BVHBrush{bounds.p(), index});
+    }
+  }
+
+  bsp->nBVHNodes   = 0;
+  bsp->nBVHBrushes = brushes.size();
+
+  if (!brushes.isEmpty()) {
+    buildBVHNode(bsp, brushes.begin(), 0, brushes.size());
+  }
+}
+
 BSP::BSP(const char* name_, int id_)
   : data(nullptr), name(name_), id(id_)
 {}
@@ -32,7 +180,7 @@ BSP::BSP(const char* name_, int id_)
 void BSP::load()
 {
   File   file = String::format("@bsp/%s.ozBSP", name.c());
-  Stream is   = file.read(Endian::LITTLE);
+  Stream is   = file.map(Endian::LITTLE);
 
   if (is.available() == 0) {
     OZ_ERROR("BSP file '%s' read failed", file.c());
@@ -72,6 +220,10 @@ void BSP::load()
   size += Alloc::alignUp(nBrushSides   * sizeof(brushSides[0]));
   size += Alloc::alignUp(nEntities     * sizeof(entities[0]));
   size += Alloc::alignUp(nBoundObjects * sizeof(boundObjects[0]));
+  size += Alloc::alignUp(nBrushes      * sizeof(brushBounds[0]));
+  size += Alloc::alignUp(nBrushSides   * sizeof(float)) * 4;
+  size += Alloc::alignUp(nBrushes      * 2 * sizeof(bvhNodes[0]));
+  size += Alloc::alignUp(nBrushes      * sizeof(bvhBrushes[0]));
 
   OZ_ASSERT(data == nullptr);
 
@@ -112,6 +264,10 @@ void BSP::load()
     brushes[i].nSides    = is.readInt();
     brushes[i].flags     = is.readInt();
 
+    if (brushes[i].nSides > MAX_BRUSH_SIDES) {
+      OZ_ERROR("BSP '%s' brush #%d has too many sides", name.c(), i);
+    }
+
     if (brushes[i].flags & Medium::SEA_BIT) {
       brushes[i].flags |= orbis.terra.liquid & Medium::LIQUID_MASK;
     }
@@ -171,8 +327,39 @@ void BSP::load()
       OZ_ERROR("BSP '%s' bound object '%s' is not static", name.c(), clazz->name.c());
     }
   }
+  p = Alloc::alignUp(p + nBoundObjects * sizeof(boundObjects[0]));
 
   OZ_ASSERT(is.available() == 0);
+
+  brushBounds = new(p) Bounds[nBrushes];
+  for (int i = 0; i < nBrushes; ++i) {
+    brushBounds[i] = calcBrushBounds(this, brushes[i]);
+  }
+  p = Alloc::alignUp(p + nBrushes * sizeof(brushBounds[0]));
+
+  // Side planes as a structure of arrays, so brush tests can be vectorised.
+  float* sideArrays[4];
+  for (int i = 0; i < 4; ++i) {
+    sideArrays[i] = new(p) float[nBrushSides];
+    p = Alloc::alignUp(p + nBrushSides * sizeof(float));
+  }
+  for (int i = 0; i < nBrushSides; ++i) {
+    const Plane& plane = planes[brushSides[i]];
+
+    sideArrays[0][i] = plane.n.x;
+    sideArrays[1][i] = plane.n.y;
+    sideArrays[2][i] = plane.n.z;
+    sideArrays[3][i] = plane.d;
+  }
+  sideNormals = {sideArrays[0], sideArrays[1], sideArrays[2]};
+  sideOffsets = sideArrays[3];
+
+  bvhNodes = new(p) BVHNode[2 * nBrushes];
+  p = Alloc::alignUp(p + nBrushes * 2 * sizeof(bvhNodes[0]));
+
+  bvhBrushes = new(p) int[nBrushes];
+
+  buildBVH(this);
 }
 
 void BSP::unload()
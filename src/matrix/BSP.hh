@@ -100,6 +100,12 @@ public:
 
   static const int MAX_BRUSHES = 1024;
 
+  /// Maximum number of sides of a single brush.
+  static const int MAX_BRUSH_SIDES = 128;
+
+  /// Maximum number of brushes in a BVH leaf.
+  static const int BVH_LEAF_SIZE = 4;
+
   /**
    * %BSP node.
    */
@@ -131,6 +137,17 @@ public:
     int flags;     ///< %Material and medium bits (look `matrix::Material` and `matrix::Medium`).
   };
 
+  /**
+   * Node of bounding volume hierarchy over static brushes (the ones not belonging to entities).
+   *
+   * Nodes are stored in depth-first order, the first child of an inner node directly follows it.
+   */
+  struct BVHNode : Bounds
+  {
+    int first;    ///< First index in `bvhBrushes` for a leaf, index of the second child otherwise.
+    int nBrushes; ///< Number of brushes in a leaf, 0 for inner nodes.
+  };
+
   struct BoundObject
   {
     const ObjectClass* clazz;
@@ -149,6 +166,12 @@ public:
   int*            brushSides;
   BoundObject*    boundObjects;
 
+  Bounds*         brushBounds;   ///< Bounds of brushes, computed on load.
+  Batch::Coords   sideNormals;   ///< Normals of brush side planes, in `brushSides` order.
+  const float*    sideOffsets;   ///< Offsets of brush side planes, in `brushSides` order.
+  BVHNode*        bvhNodes;      ///< Hierarchy over static brushes, root is the first node.
+  int*            bvhBrushes;    ///< Brush indices referenced from BVH leaves.
+
   int             nPlanes;
   int             nNodes;
   int             nLeaves;
@@ -157,6 +180,8 @@ public:
   int             nBrushes;
   int             nBrushSides;
   int             nBoundObjects;
+  int             nBVHNodes;
+  int             nBVHBrushes;
 
   String          name;          ///< Name.
   String          title;         ///< Title.
@@ -56,7 +56,7 @@ const float Bot::GRAB_MOM_MAX_SQ      =  1.00f;
 const float Bot::STEP_MOVE_AHEAD      =  0.20f;
 const float Bot::CLIMB_MOVE_AHEAD     =  0.40f;
 
-Pool<Bot> Bot::pool(1024);
+ConcurrentPool<Bot> Bot::pool("Bot", 1024);
 
 bool Bot::hasAttribute(int attribute) const
 {
@@ -107,7 +107,7 @@ bool Bot::canEquip(const Weapon* weaponObj) const
 
   const WeaponClass* weaponClazz = static_cast<const WeaponClass*>(weaponObj->clazz);
 
-  return clazz->name.beginsWith(weaponClazz->userBase);
+  return String::beginsWith(clazz->name.c(), weaponClazz->userBase);
 }
 
 bool Bot::trigger(const Entity* entity)
@@ -357,6 +357,10 @@ void Bot::kill()
 
   state     |= DEAD_BIT;
 
+  if (cell != nullptr) {
+    orbis.reposition(this);
+  }
+
   if (clazz->nItems != 0) {
     flags |= BROWSABLE_BIT;
   }
@@ -913,7 +917,8 @@ stepSucceeded:
 
           momDiff.z          -= physics.gravity * Timer::TICK_TIME;
 
-          cargoObj->flags    &= ~DISABLED_BIT;
+          physics.wake(cargoObj);
+
           cargoObj->momentum += momDiff;
         }
       }
@@ -161,7 +161,7 @@ public:
 
 public:
 
-  static Pool<Bot> pool;
+  static ConcurrentPool<Bot> pool;
 
   float  h, v;
   int    actions, oldActions;
@@ -32,11 +32,88 @@ static const Vec3 NORMALS[] =
   Vec3( 0.0f,  0.0f, -1.0f)
 };
 
-inline bool Collider::visitBrush(int index)
+void Collider::resetVisitedStructs()
 {
-  bool isTested = visitedBrushes.get(index);
-  visitedBrushes.set(index);
-  return isTested;
+  ++structStamp;
+
+  // On wrap-around, marks left from 2^32 queries ago would look like fresh ones.
+  if (structStamp == 0) {
+    Arrays::fill<uint, uint>(structMarks, Orbis::MAX_STRUCTS, 0);
+    structStamp = 1;
+  }
+}
+
+inline bool Collider::visitStruct(int index)
+{
+  bool isVisited = structMarks[index] == structStamp;
+  structMarks[index] = structStamp;
+  return isVisited;
+}
+
+template <class Func>
+inline bool Collider::forEachBrush(const Bounds& localTrace, Func func) const
+{
+  if (bsp->nBVHNodes == 0) {
+    return false;
+  }
+
+  // Median splits keep the depth at about log2(MAX_BRUSHES / BVH_LEAF_SIZE).
+  int stack[32];
+  int nStacked  = 0;
+  int nodeIndex = 0;
+
+  while (true) {
+    const BSP::BVHNode& node = bsp->bvhNodes[nodeIndex];
+
+    if (localTrace.overlaps(node)) {
+      if (node.nBrushes == 0) {
+        OZ_ASSERT(nStacked < Arrays::size(stack));
+
+        stack[nStacked] = node.first;
+        ++nStacked;
+        ++nodeIndex;
+        continue;
+      }
+
+      for (int i = 0; i < node.nBrushes; ++i) {
+        int index = bsp->bvhBrushes[node.first + i];
+
+        if (localTrace.overlaps(bsp->brushBounds[index]) && func(index)) {
+          return true;
+        }
+      }
+    }
+
+    if (nStacked == 0) {
+      return false;
+    }
+
+    --nStacked;
+    nodeIndex = stack[nStacked];
+  }
+}
+
+inline int Collider::filterObjects(const Cell& cell)
+{
+  const Cell::ObjectBounds& bounds = cell.objBounds;
+
+  if (bounds.size == 0) {
+    return 0;
+  }
+
+  // Enlarged a bit, so rounding in centre-extents form cannot reject anything `trace` overlaps.
+  AABB query = trace.toAABB(EPSILON);
+
+  candidates.resize(bounds.size);
+
+  int  nCandidates = Batch::boxesOverlapBox(bounds.centres(), bounds.dims(), bounds.size, query.p,
+                                            query.dim, &candidates[0]);
+  int* indices     = bounds.indices();
+
+  for (int i = 0; i < nCandidates; ++i) {
+    candidates[i] = indices[candidates[i]];
+  }
+  return nCandidates;
 }
 
 //***********************************
@@ -63,53 +140,44 @@ bool Collider::overlapsAABBObj(const Object* sObj) const
   }
 }
 
-bool Collider::overlapsAABBBrush(const BSP::Brush* brush) const
+/**
+ * Distances of a box from the brush's side planes, see `Batch::boxPlaneDistances()`.
+ */
+OZ_ALWAYS_INLINE
+static inline void brushDistances(const BSP* bsp, const BSP::Brush* brush, const Point& p,
+                                  const Vec3& dim, float* distances)
 {
-  bool result = true;
+  int           first   = brush->firstSide;
+  Batch::Coords normals = {
+    bsp->sideNormals.x + first, bsp->sideNormals.y + first, bsp->sideNormals.z + first
+  };
 
-  for (int i = 0; i < brush->nSides; ++i) {
-    const Plane& plane = bsp->planes[bsp->brushSides[brush->firstSide + i]];
+  Batch::boxPlaneDistances(normals, bsp->sideOffsets + first, brush->nSides, p, dim, distances);
+}
 
-    float offset = localDim * abs(plane.n);
-    float dist   = startPos * plane - offset;
+bool Collider::overlapsAABBBrush(const BSP::Brush* brush) const
+{
+  float dists[BSP::MAX_BRUSH_SIDES];
+  bool  result = true;
+
+  brushDistances(bsp, brush, startPos, localDim, dists);
 
-    result &= dist <= EPSILON;
+  for (int i = 0; i < brush->nSides; ++i) {
+    result &= dists[i] <= EPSILON;
   }
   return result;
 }
 
-bool Collider::overlapsAABBNode(int nodeIndex)
+bool Collider::overlapsAABBBrushes()
 {
-  if (nodeIndex < 0) {
-    const BSP::Leaf& leaf = bsp->leaves[~nodeIndex];
-
-    for (int i = 0; i < leaf.nBrushes; ++i) {
-      int index = bsp->leafBrushes[leaf.firstBrush + i];
-      const BSP::Brush& brush = bsp->brushes[index];
-
-      if (!visitBrush(index) && (brush.flags & Material::STRUCT_BIT) && overlapsAABBBrush(&brush)) {
-        return true;
-      }
-    }
-    return false;
-  }
-  else {
-    const BSP::Node& node  = bsp->nodes[nodeIndex];
-    const Plane&     plane = bsp->planes[node.plane];
+  Bounds localTrace = Bounds(AABB(startPos, localDim), 2.0f * EPSILON);
 
-    float offset = localDim * abs(plane.n) + 2.0f * EPSILON;
-    float dist   = startPos * plane;
+  return forEachBrush(localTrace, [this](int index)
+  {
+    const BSP::Brush& brush = bsp->brushes[index];
 
-    if (dist > offset) {
-      return overlapsAABBNode(node.front);
-    }
-    else if (dist < -offset) {
-      return overlapsAABBNode(node.back);
-    }
-    else {
-      return overlapsAABBNode(node.front) || overlapsAABBNode(node.back);
-    }
-  }
+    return (brush.flags & Material::STRUCT_BIT) && overlapsAABBBrush(&brush);
+  });
 }
 
 bool Collider::overlapsAABBEntities()
@@ -129,8 +197,6 @@ bool Collider::overlapsAABBEntities()
         int index = entity->clazz->firstBrush + j;
         const BSP::Brush& brush = bsp->brushes[index];
 
-        OZ_ASSERT(!visitBrush(index));
-
         startPos = originalStartPos - entity->offset;
 
         if ((brush.flags & Material::STRUCT_BIT) && overlapsAABBBrush(&brush)) {
@@ -152,7 +218,7 @@ bool Collider::overlapsAABBOrbis()
     return true;
   }
 
-  visitedStructs.clear();
+  resetVisitedStructs();
 
   for (int x = span.minX; x <= span.maxX; ++x) {
     for (int y = span.minY; y <= span.maxY; ++y) {
@@ -163,23 +229,24 @@ bool Collider::overlapsAABBOrbis()
 
         str = orbis.str(strIndex);
 
-        if (visitedStructs.get(strIndex) || !trace.overlaps(*str)) {
+        if (visitStruct(strIndex) || !trace.overlaps(*str)) {
           continue;
         }
 
-        visitedStructs.set(strIndex);
-        visitedBrushes.clear();
-
         startPos = str->toStructCS(aabb.p);
         localDim = str->swapDimCS(aabb.dim);
         bsp      = str->bsp;
 
-        if (overlapsAABBNode(0) || overlapsAABBEntities()) {
+        if (overlapsAABBBrushes() || overlapsAABBEntities()) {
           return true;
         }
       }
 
-      for (const Object* sObj = cell.objects.first(); sObj != nullptr; sObj = sObj->next[0]) {
+      int nCandidates = filterObjects(cell);
+
+      for (int i = 0; i < nCandidates; ++i) {
+        const Object* sObj = orbis.obj(candidates[i]);
+
         if (sObj != exclObj && (sObj->flags & mask) && overlapsAABBObj(sObj)) {
           return true;
         }
@@ -199,7 +266,11 @@ bool Collider::overlapsEntityObjects()
     for (int y = span.minY; y <= span.maxY; ++y) {
       const Cell& cell = orbis.cells[x][y];
 
-      for (const Object* sObj = cell.objects.first(); sObj != nullptr; sObj = sObj->next[0]) {
+      int nCandidates = filterObjects(cell);
+
+      for (int j = 0; j < nCandidates; ++j) {
+        const Object* sObj = orbis.obj(candidates[j]);
+
         if (trace.overlaps(*sObj)) {
           startPos = str->toStructCS(sObj->p) - entity->offset;
           localDim = str->swapDimCS(sObj->dim + Vec3(margin, margin, margin));
@@ -380,16 +451,18 @@ void Collider::trimAABBObj(const Object* sObj)
 
 void Collider::trimAABBBrush(const BSP::Brush* brush)
 {
-  float minRatio   = -1.0f;
-  float maxRatio   = +1.0f;
-  Vec3  lastNormal = Vec3::ZERO;
+  float startDists[BSP::MAX_BRUSH_SIDES];
+  float endDists[BSP::MAX_BRUSH_SIDES];
+  float minRatio = -1.0f;
+  float maxRatio = +1.0f;
+  int   lastSide = -1;
 
-  for (int i = 0; i < brush->nSides; ++i) {
-    const Plane& plane = bsp->planes[bsp->brushSides[brush->firstSide + i]];
+  brushDistances(bsp, brush, startPos, localDim, startDists);
+  brushDistances(bsp, brush, endPos, localDim, endDists);
 
-    float offset    = localDim * abs(plane.n);
-    float startDist = startPos * plane - offset;
-    float endDist   = endPos   * plane - offset;
+  for (int i = 0; i < brush->nSides; ++i) {
+    float startDist = startDists[i];
+    float endDist   = endDists[i];
 
     if (endDist > EPSILON) {
       if (startDist < 0.0f) {
@@ -403,15 +476,17 @@ void Collider::trimAABBBrush(const BSP::Brush* brush)
       float ratio = (startDist - EPSILON) / max(startDist - endDist, Math::FLOAT_EPS);
 
       if (ratio > minRatio) {
-        minRatio   = ratio;
-        lastNormal = plane.n;
+        minRatio = ratio;
+        lastSide = i;
       }
     }
   }
 
   if (minRatio != -1.0f && minRatio <= maxRatio && minRatio < hit.ratio) {
+    const Plane& plane = bsp->planes[bsp->brushSides[brush->firstSide + lastSide]];
+
     hit.ratio    = max(0.0f, minRatio);
-    hit.normal   = str->toAbsoluteCS(lastNormal);
+    hit.normal   = str->toAbsoluteCS(plane.n);
     hit.obj      = nullptr;
     hit.str      = const_cast<Struct*>(str);
     hit.entity   = const_cast<Entity*>(entity);
@@ -454,13 +529,12 @@ void Collider::trimAABBLiquid(const BSP::Brush* brush)
 
 void Collider::trimAABBArea(const BSP::Brush* brush)
 {
-  for (int i = 0; i < brush->nSides; ++i) {
-    const Plane& plane = bsp->planes[bsp->brushSides[brush->firstSide + i]];
+  float dists[BSP::MAX_BRUSH_SIDES];
 
-    float offset = localDim * abs(plane.n);
-    float dist   = startPos * plane - offset;
+  brushDistances(bsp, brush, startPos, localDim, dists);
 
-    if (dist > 0.0f) {
+  for (int i = 0; i < brush->nSides; ++i) {
+    if (dists[i] > 0.0f) {
       return;
     }
   }
@@ -469,47 +543,25 @@ void Collider::trimAABBArea(const BSP::Brush* brush)
   hit.medium   |= brush->flags & Medium::MASK;
 }
 
-void Collider::trimAABBNode(int nodeIndex)
+void Collider::trimAABBBrushes()
 {
-  if (nodeIndex < 0) {
-    const BSP::Leaf& leaf = bsp->leaves[~nodeIndex];
-
-    for (int i = 0; i < leaf.nBrushes; ++i) {
-      int index = bsp->leafBrushes[leaf.firstBrush + i];
-      const BSP::Brush& brush = bsp->brushes[index];
+  Bounds localTrace = Bounds(AABB(startPos, localDim), 2.0f * EPSILON).expand(endPos - startPos);
 
-      if (!visitBrush(index)) {
-        if (brush.flags & Material::STRUCT_BIT) {
-          trimAABBBrush(&brush);
-        }
-        else if (brush.flags & Medium::LIQUID_MASK) {
-          trimAABBLiquid(&brush);
-        }
-        else {
-          trimAABBArea(&brush);
-        }
-      }
-    }
-  }
-  else {
-    const BSP::Node& node  = bsp->nodes[nodeIndex];
-    const Plane&     plane = bsp->planes[node.plane];
-
-    float offset    = localDim * abs(plane.n) + 2.0f * EPSILON;
-    float startDist = startPos * plane;
-    float endDist   = endPos   * plane;
+  forEachBrush(localTrace, [this](int index)
+  {
+    const BSP::Brush& brush = bsp->brushes[index];
 
-    if (startDist > offset && endDist > offset) {
-      trimAABBNode(node.front);
+    if (brush.flags & Material::STRUCT_BIT) {
+      trimAABBBrush(&brush);
     }
-    else if (startDist < -offset && endDist < -offset) {
-      trimAABBNode(node.back);
+    else if (brush.flags & Medium::LIQUID_MASK) {
+      trimAABBLiquid(&brush);
     }
     else {
-      trimAABBNode(node.front);
-      trimAABBNode(node.back);
+      trimAABBArea(&brush);
     }
-  }
+    return false;
+  });
 }
 
 void Collider::trimAABBEntities()
@@ -533,8 +585,6 @@ void Collider::trimAABBEntities()
         int index = entity->clazz->firstBrush + j;
         const BSP::Brush& brush = bsp->brushes[index];
 
-        OZ_ASSERT(!visitBrush(index));
-
         trimAABBBrush(&brush);
       }
     }
@@ -638,7 +688,7 @@ void Collider::trimAABBOrbis()
     trimAABBVoid();
   }
 
-  visitedStructs.clear();
+  resetVisitedStructs();
 
   for (int x = span.minX; x <= span.maxX; ++x) {
     for (int y = span.minY; y <= span.maxY; ++y) {
@@ -649,27 +699,28 @@ void Collider::trimAABBOrbis()
 
         str = orbis.str(strIndex);
 
-        if (visitedStructs.get(strIndex) || !trace.overlaps(*str)) {
+        if (visitStruct(strIndex) || !trace.overlaps(*str)) {
           continue;
         }
 
-        visitedStructs.set(strIndex);
-        visitedBrushes.clear();
-
         startPos = str->toStructCS(originalStartPos);
         endPos   = str->toStructCS(originalEndPos);
         localDim = str->swapDimCS(aabb.dim);
         bsp      = str->bsp;
         entity   = nullptr;
 
-        trimAABBNode(0);
+        trimAABBBrushes();
         trimAABBEntities();
       }
 
       startPos = originalStartPos;
       endPos   = originalEndPos;
 
-      for (const Object* sObj = cell.objects.first(); sObj != nullptr; sObj = sObj->next[0]) {
+      int nCandidates = filterObjects(cell);
+
+      for (int i = 0; i < nCandidates; ++i) {
+        const Object* sObj = orbis.obj(candidates[i]);
+
         if (sObj != exclObj && (sObj->flags & mask) && trace.overlaps(*sObj)) {
           trimAABBObj(sObj);
         }
@@ -695,7 +746,11 @@ void Collider::trimEntityObjects()
     for (int y = span.minY; y <= span.maxY; ++y) {
       const Cell& cell = orbis.cells[x][y];
 
-      for (const Object* sObj = cell.objects.first(); sObj != nullptr; sObj = sObj->next[0]) {
+      int nCandidates = filterObjects(cell);
+
+      for (int i = 0; i < nCandidates; ++i) {
+        const Object* sObj = orbis.obj(candidates[i]);
+
         if ((sObj->flags & mask) && trace.overlaps(*sObj)) {
           startPos = str->toStructCS(sObj->p) - entity->offset;
           endPos   = startPos - move;
@@ -728,7 +783,8 @@ void Collider::trimEntityObjects()
 //*          OVERLAPPING            *
 //***********************************
 
-void Collider::getOrbisOverlaps(List<Struct*>* structs, List<Object*>* objects)
+template <class StructList, class ObjectList>
+void Collider::getOrbisOverlaps(StructList* structs, ObjectList* objects)
 {
   OZ_ASSERT(structs != nullptr || objects != nullptr);
 
@@ -741,13 +797,11 @@ void Collider::getOrbisOverlaps(List<Struct*>* structs, List<Object*>* objects)
           str = orbis.str(cell.structs[i]);
 
           if (trace.overlaps(*str) && !structs->contains(const_cast<Struct*>(str))) {
-            visitedBrushes.clear();
-
             startPos = str->toStructCS(aabb.p);
             localDim = str->swapDimCS(aabb.dim);
             bsp      = str->bsp;
 
-            if (overlapsAABBNode(0) || overlapsAABBEntities()) {
+            if (overlapsAABBBrushes() || overlapsAABBEntities()) {
               structs->add(const_cast<Struct*>(str));
             }
           }
@@ -755,7 +809,11 @@ void Collider::getOrbisOverlaps(List<Struct*>* structs, List<Object*>* objects)
       }
 
       if (objects != nullptr) {
-        for (Object* sObj = cell.objects.first(); sObj != nullptr; sObj = sObj->next[0]) {
+        int nCandidates = filterObjects(cell);
+
+        for (int i = 0; i < nCandidates; ++i) {
+          Object* sObj = orbis.obj(candidates[i]);
+
           if ((sObj->flags & mask) && trace.overlaps(*sObj)) {
             objects->add(sObj);
           }
@@ -765,7 +823,8 @@ void Collider::getOrbisOverlaps(List<Struct*>* structs, List<Object*>* objects)
   }
 }
 
-void Collider::getEntityOverlaps(List<Object*>* objects)
+template <class ObjectList>
+void Collider::getEntityOverlaps(ObjectList* objects)
 {
   OZ_ASSERT(objects != nullptr);
 
@@ -773,7 +832,11 @@ void Collider::getEntityOverlaps(List<Object*>* objects)
     for (int y = span.minY; y <= span.maxY; ++y) {
       const Cell& cell = orbis.cells[x][y];
 
-      for (Object* sObj = cell.objects.first(); sObj != nullptr; sObj = sObj->next[0]) {
+      int nCandidates = filterObjects(cell);
+
+      for (int j = 0; j < nCandidates; ++j) {
+        Object* sObj = orbis.obj(candidates[j]);
+
         if ((sObj->flags & mask) && trace.overlaps(*sObj)) {
           startPos = str->toStructCS(sObj->p) - entity->offset;
           localDim = str->swapDimCS(sObj->dim + Vec3(margin, margin, margin));
@@ -924,6 +987,36 @@ void Collider::getOverlaps(const Entity* entity_, List<Object*>* objects, float
   getEntityOverlaps(objects);
 }
 
+void Collider::getOverlaps(const AABB& aabb_, FrameList<Struct*>* structs,
+                           FrameList<Object*>* objects, float margin_)
+{
+  aabb    = AABB(aabb_, margin_);
+
+  trace   = Bounds(aabb, 0.0f);
+  span    = orbis.getInters(trace, Object::MAX_DIM);
+
+  getOrbisOverlaps(structs, objects);
+}
+
+void Collider::getOverlaps(const Entity* entity_, FrameList<Object*>* objects, float margin_)
+{
+  str    = entity_->str;
+  entity = entity_;
+  bsp    = entity_->clazz->bsp;
+  margin = margin_;
+
+  trace  = Bounds(str->toAbsoluteCS(*entity->clazz + entity->offset), margin);
+  span   = orbis.getInters(trace, Object::MAX_DIM);
+
+  getEntityOverlaps(objects);
+}
+
+void Collider::unload()
+{
+  candidates.clear();
+  candidates.trim();
+}
+
 Collider collider;
 
 }
@@ -81,8 +81,9 @@ class Collider
 {
 private:
 
-  SBitset<Orbis::MAX_STRUCTS> visitedStructs;
-  SBitset<BSP::MAX_BRUSHES>   visitedBrushes;
+  // Structures whose marks equal the current stamp have already been visited in this query.
+  uint                        structMarks[Orbis::MAX_STRUCTS] = {};
+  uint                        structStamp = 0;
 
   Span                        span;
   Bounds                      trace;
@@ -102,6 +103,8 @@ private:
   int                         flags;
   float                       margin;
 
+  List<int>                   candidates;               ///< Objects passing the bounds filter.
+
 public:
 
   int                         mask = Object::SOLID_BIT; /// Filter for `Object::flags`.
@@ -110,13 +113,34 @@ public:
 private:
 
   /**
-   * Return true if brush was already visited and mark it visited.
+   * Invalidate all structure marks by advancing the stamp.
+   */
+  void resetVisitedStructs();
+
+  /**
+   * Return true if structure was already visited in this query and mark it visited.
+   */
+  bool visitStruct(int index);
+
+  /**
+   * Call `func(index)` for static brushes of the current BSP whose bounds overlap `localTrace`,
+   * stop and return true as soon as one call returns true.
+   */
+  template <class Func>
+  bool forEachBrush(const Bounds& localTrace, Func func) const;
+
+  /**
+   * Filter objects in a cell by bounds of the trace, write their indices to `candidates`.
+   *
+   * This is only a coarse vectorised test, candidates still need the exact one.
+   *
+   * @return number of candidates.
    */
-  bool visitBrush(int index);
+  int filterObjects(const Cell& cell);
 
   bool overlapsAABBObj(const Object* sObj) const;
   bool overlapsAABBBrush(const BSP::Brush* brush) const;
-  bool overlapsAABBNode(int nodeIndex);
+  bool overlapsAABBBrushes();
   bool overlapsAABBEntities();
   bool overlapsAABBOrbis();
 
@@ -127,7 +151,7 @@ private:
   void trimAABBBrush(const BSP::Brush* brush);
   void trimAABBLiquid(const BSP::Brush* brush);
   void trimAABBArea(const BSP::Brush* brush);
-  void trimAABBNode(int nodeIndex);
+  void trimAABBBrushes();
   void trimAABBEntities();
 
   void trimAABBTerraQuad(int x, int y);
@@ -136,8 +160,10 @@ private:
 
   void trimEntityObjects();
 
-  void getOrbisOverlaps(List<Struct*>* structs, List<Object*>* objects);
-  void getEntityOverlaps(List<Object*>* objects);
+  template <class StructList, class ObjectList>
+  void getOrbisOverlaps(StructList* structs, ObjectList* objects);
+  template <class ObjectList>
+  void getEntityOverlaps(ObjectList* objects);
 
 public:
 
@@ -156,6 +182,14 @@ public:
   void getOverlaps(const AABB& aabb, List<Struct*>* structs, List<Object*>* objects, float margin);
   void getOverlaps(const Entity* entity, List<Object*>* objects, float margin);
 
+  // same as above, for transient lists in the thread's frame arena
+  void getOverlaps(const AABB& aabb, FrameList<Struct*>* structs, FrameList<Object*>* objects,
+                   float margin);
+  void getOverlaps(const Entity* entity, FrameList<Object*>* objects, float margin);
+
+  // release buffers that are kept between queries
+  void unload();
+
 };
 
 extern Collider collider;
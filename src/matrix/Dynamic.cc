@@ -26,7 +26,7 @@
 namespace oz
 {
 
-Pool<Dynamic> Dynamic::pool(4096);
+ConcurrentPool<Dynamic> Dynamic::pool("Dynamic", 4096);
 
 void Dynamic::onDestroy()
 {
@@ -33,7 +33,7 @@ class Dynamic : public Object
 {
 public:
 
-  static Pool<Dynamic> pool; ///< Memory pool.
+  static ConcurrentPool<Dynamic> pool; ///< Memory pool.
 
   Vec3  velocity;
   Vec3  momentum; ///< Desired velocity
@@ -24,7 +24,7 @@ namespace oz
 
 const float Frag::DAMAGE_THRESHOLD = 50.0f;
 
-Pool<Frag> Frag::mpool(2048);
+ConcurrentPool<Frag> Frag::mpool("Frag", 2048);
 
 Frag::Frag(const FragPool* pool_, int index_, const Point& p_, const Vec3& velocity_)
 {
@@ -38,7 +38,7 @@ private:
 
 public:
 
-  static Pool<Frag> mpool;
+  static ConcurrentPool<Frag> mpool;
 
   /*
    *  FIELDS
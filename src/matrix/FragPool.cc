@@ -26,7 +26,7 @@ namespace oz
 {
 
 FragPool::FragPool(const Json& config, const char* name_, int id_)
-  : name(name_), id(id_)
+  : name(Atom(name_)), id(id_)
 {
   flags = 0;
 
@@ -37,7 +37,7 @@ public:
   // OR'ed to the client::FragPoo::flags, so we must assure bits don't overlap
   static const int FADEOUT_BIT = 0x0100;
 
-  String    name;
+  Atom      name;
   int       id;
 
   int       flags;
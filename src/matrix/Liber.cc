@@ -29,185 +29,185 @@ namespace oz
 
 static HashMap<String, ObjectClass::CreateFunc*> baseClasses;
 
-static HashMap<String, int>                      shaderIndices;
-static HashMap<String, int>                      textureIndices;
-static HashMap<String, int>                      soundIndices;
-static HashMap<String, int>                      musicTrackIndices;
-static HashMap<String, int>                      caelumIndices;
-static HashMap<String, int>                      terraIndices;
-static HashMap<String, int>                      partIndices;
-static HashMap<String, int>                      modelIndices;
-
-static HashMap<String, BSP>                      bspMap;
-static HashMap<String, ObjectClass*>             objClassMap;
-static HashMap<String, FragPool>                 fragPoolMap;
-
-static HashMap<String, int>                      mindIndices;
-
-int Liber::shaderIndex(const char* name) const
+static HashMap<Atom, int>                        shaderIndices;
+static HashMap<Atom, int>                        textureIndices;
+static HashMap<Atom, int>                        soundIndices;
+static HashMap<Atom, int>                        musicTrackIndices;
+static HashMap<Atom, int>                        caelumIndices;
+static HashMap<Atom, int>                        terraIndices;
+static HashMap<Atom, int>                        partIndices;
+static HashMap<Atom, int>                        modelIndices;
+
+static HashMap<Atom, BSP>                        bspMap;
+static HashMap<Atom, ObjectClass*>               objClassMap;
+static HashMap<Atom, FragPool>                   fragPoolMap;
+
+static HashMap<Atom, int>                        mindIndices;
+
+int Liber::shaderIndex(Atom name) const
 {
-  if (String::isEmpty(name)) {
+  if (name.isEmpty()) {
     return -1;
   }
 
   const int* value = shaderIndices.find(name);
 
   if (value == nullptr) {
-    OZ_ERROR("Invalid shader requested '%s'", name);
+    OZ_ERROR("Invalid shader requested '%s'", name.c());
   }
   return *value;
 }
 
-int Liber::textureIndex(const char* name) const
+int Liber::textureIndex(Atom name) const
 {
-  if (String::isEmpty(name)) {
+  if (name.isEmpty()) {
     return -1;
   }
 
   const int* value = textureIndices.find(name);
 
   if (value == nullptr) {
-    OZ_ERROR("Invalid texture requested '%s'", name);
+    OZ_ERROR("Invalid texture requested '%s'", name.c());
   }
   return *value;
 }
 
-int Liber::soundIndex(const char* name) const
+int Liber::soundIndex(Atom name) const
 {
-  if (String::isEmpty(name)) {
+  if (name.isEmpty()) {
     return -1;
   }
 
   const int* value = soundIndices.find(name);
 
   if (value == nullptr) {
-    OZ_ERROR("Invalid sound requested '%s'", name);
+    OZ_ERROR("Invalid sound requested '%s'", name.c());
   }
   return *value;
 }
 
-int Liber::caelumIndex(const char* name) const
+int Liber::caelumIndex(Atom name) const
 {
-  if (String::isEmpty(name)) {
+  if (name.isEmpty()) {
     return -1;
   }
 
   const int* value = caelumIndices.find(name);
 
   if (value == nullptr) {
-    OZ_ERROR("Invalid caelum requested '%s'", name);
+    OZ_ERROR("Invalid caelum requested '%s'", name.c());
   }
   return *value;
 }
 
-int Liber::terraIndex(const char* name) const
+int Liber::terraIndex(Atom name) const
 {
-  if (String::isEmpty(name)) {
+  if (name.isEmpty()) {
     return -1;
   }
 
   const int* value = terraIndices.find(name);
 
   if (value == nullptr) {
-    OZ_ERROR("Invalid terra requested '%s'", name);
+    OZ_ERROR("Invalid terra requested '%s'", name.c());
   }
   return *value;
 }
 
-int Liber::partIndex(const char* name) const
+int Liber::partIndex(Atom name) const
 {
-  if (String::isEmpty(name)) {
+  if (name.isEmpty()) {
     return -1;
   }
 
   const int* value = partIndices.find(name);
 
   if (value == nullptr) {
-    OZ_ERROR("Invalid particle requested '%s'", name);
+    OZ_ERROR("Invalid particle requested '%s'", name.c());
   }
   return *value;
 }
 
-int Liber::modelIndex(const char* name) const
+int Liber::modelIndex(Atom name) const
 {
-  if (String::isEmpty(name)) {
+  if (name.isEmpty()) {
     return -1;
   }
 
   const int* value = modelIndices.find(name);
 
   if (value == nullptr) {
-    OZ_ERROR("Invalid model requested '%s'", name);
+    OZ_ERROR("Invalid model requested '%s'", name.c());
   }
   return *value;
 }
 
-int Liber::musicTrackIndex(const char* name) const
+int Liber::musicTrackIndex(Atom name) const
 {
-  if (String::isEmpty(name)) {
+  if (name.isEmpty()) {
     return -1;
   }
 
   const int* value = musicTrackIndices.find(name);
 
   if (value == nullptr) {
-    OZ_ERROR("Invalid music track requested '%s'", name);
+    OZ_ERROR("Invalid music track requested '%s'", name.c());
   }
   return *value;
 }
 
-int Liber::mindIndex(const char* name) const
+int Liber::mindIndex(Atom name) const
 {
-  if (String::isEmpty(name)) {
+  if (name.isEmpty()) {
     return -1;
   }
 
   const int* value = mindIndices.find(name);
 
   if (value == nullptr) {
-    OZ_ERROR("Invalid mind requested '%s'", name);
+    OZ_ERROR("Invalid mind requested '%s'", name.c());
   }
   return *value;
 }
 
-const FragPool* Liber::fragPool(const char* name) const
+const FragPool* Liber::fragPool(Atom name) const
 {
-  if (String::isEmpty(name)) {
+  if (name.isEmpty()) {
     return nullptr;
   }
 
   const FragPool* value = fragPoolMap.find(name);
 
   if (value == nullptr) {
-    OZ_ERROR("Invalid fragment pool requested '%s'", name);
+    OZ_ERROR("Invalid fragment pool requested '%s'", name.c());
   }
   return value;
 }
 
-const ObjectClass* Liber::objClass(const char* name) const
+const ObjectClass* Liber::objClass(Atom name) const
 {
-  if (String::isEmpty(name)) {
+  if (name.isEmpty()) {
     return nullptr;
   }
 
   const ObjectClass* const* value = objClassMap.find(name);
 
   if (value == nullptr) {
-    OZ_ERROR("Invalid object class requested '%s'", name);
+    OZ_ERROR("Invalid object class requested '%s'", name.c());
   }
   return *value;
 }
 
-const BSP* Liber::bsp(const char* name) const
+const BSP* Liber::bsp(Atom name) const
 {
-  if (String::isEmpty(name)) {
+  if (name.isEmpty()) {
     return nullptr;
   }
 
   const BSP* value = bspMap.find(name);
 
   if (value == nullptr) {
-    OZ_ERROR("Invalid BSP index requested '%s'", name);
+    OZ_ERROR("Invalid BSP index requested '%s'", name.c());
   }
   return value;
 }
@@ -255,7 +255,7 @@ void Liber::initShaders()
 
     Log::println("%s", name.c());
 
-    shaderIndices.add(name, shaders.size());
+    shaderIndices.add(Atom(name), shaders.size());
     shaders.add(Resource{name, file});
   }
 
@@ -287,7 +287,7 @@ void Liber::initTextures()
 
       Log::println("%s", name.c());
 
-      textureIndices.add(name, textures.size());
+      textureIndices.add(Atom(name), textures.size());
       textures.add(Resource{name, "@tex/" + name});
     }
   }
@@ -322,11 +322,11 @@ void Liber::initSounds()
 
       Log::println("%s", name.c());
 
-      if (soundIndices.contains(name)) {
+      if (soundIndices.contains(Atom(name))) {
         OZ_ERROR("Duplicated sound '%s'", name.c());
       }
 
-      soundIndices.add(name, sounds.size());
+      soundIndices.add(Atom(name), sounds.size());
       sounds.add(Resource{name, file});
     }
   }
@@ -354,7 +354,7 @@ void Liber::initCaela()
 
     Log::println("%s", name.c());
 
-    caelumIndices.add(name, caela.size());
+    caelumIndices.add(Atom(name), caela.size());
     caela.add(Resource{name, subDir});
   }
 
@@ -381,7 +381,7 @@ void Liber::initTerrae()
 
     Log::println("%s", name.c());
 
-    terraIndices.add(name, terrae.size());
+    terraIndices.add(Atom(name), terrae.size());
     terrae.add(Resource{name, file});
   }
 
@@ -408,7 +408,7 @@ void Liber::initParticles()
 
     Log::println("%s", name.c());
 
-    partIndices.add(name, parts.size());
+    partIndices.add(Atom(name), parts.size());
     parts.add(Resource{name, file});
   }
 
@@ -440,11 +440,11 @@ void Liber::initModels()
 
     Log::println("%s", name.c());
 
-    if (modelIndices.contains(name)) {
+    if (modelIndices.contains(Atom(name))) {
       OZ_ERROR("Duplicated model '%s'", name.c());
     }
 
-    modelIndices.add(name, models.size());
+    modelIndices.add(Atom(name), models.size());
     models.add(Resource{name, file});
   }
 
@@ -476,7 +476,7 @@ void Liber::initFragPools()
       OZ_ERROR("Failed to read '%s'", file.c());
     }
 
-    FragPool& pool = fragPoolMap.add(name, FragPool(config, name, fragPools.size())).value;
+    FragPool& pool = fragPoolMap.add(Atom(name), FragPool(config, name, fragPools.size())).value;
     fragPools.add(&pool);
 
     Log::showVerbose = true;
@@ -521,7 +521,7 @@ void Liber::initClasses()
     String name = file.baseName();
     String base = config["base"].get("");
 
-    if (objClassMap.contains(name)) {
+    if (objClassMap.contains(Atom(name))) {
       OZ_ERROR("Duplicated class '%s'", name.c());
     }
 
@@ -550,7 +550,7 @@ void Liber::initClasses()
 
     ObjectClass* clazz = (*createFunc)();
 
-    objClassMap.add(name, clazz);
+    objClassMap.add(Atom(name), clazz);
     objClasses.add(clazz);
   }
 
@@ -562,18 +562,18 @@ void Liber::initClasses()
 
   // Initialise all classes.
   for (const auto& classIter : objClassMap) {
-    const String& name  = classIter.key;
-    ObjectClass*  clazz = classIter.value;
+    Atom         name  = classIter.key;
+    ObjectClass* clazz = classIter.value;
 
     Log::print("%s ...", name.c());
 
-    File file = "@class/" + name + ".json";
+    File file = String::format("@class/%s.json", name.c());
     Json config;
     if (!config.load(file)) {
       OZ_ERROR("Failed to read '%s'", file.c());
     }
 
-    clazz->init(config, name);
+    clazz->init(config, name.c());
 
     Log::showVerbose = true;
     config["base"];
@@ -617,7 +617,7 @@ void Liber::initClasses()
 
         const WeaponClass* weaponClazz = static_cast<const WeaponClass*>(itemClazz);
 
-        if (!botClazz->name.beginsWith(weaponClazz->userBase)) {
+        if (!String::beginsWith(botClazz->name.c(), weaponClazz->userBase)) {
           OZ_ERROR("Default weapon of '%s' is not allowed for this bot class",
                    botClazz->name.c());
         }
@@ -645,7 +645,7 @@ void Liber::initBSPs()
 
     Log::println("%s", name.c());
 
-    BSP& bsp = bspMap.add(name, BSP(name, bsps.size())).value;
+    BSP& bsp = bspMap.add(Atom(name), BSP(name, bsps.size())).value;
     bsps.add(&bsp);
 
     bsp.load();
@@ -685,7 +685,7 @@ void Liber::initMusic(const char* userMusicPath)
   initMusicRecurse("@music");
 
   for (int i = 0; i < musicTracks.size(); ++i) {
-    musicTrackIndices.add(musicTracks[i].name, i);
+    musicTrackIndices.add(Atom(musicTracks[i].name), i);
   }
 
   initMusicRecurse("@userMusic");
@@ -62,20 +62,80 @@ public:
   bool                     mapMP3s;
   bool                     mapAACs;
 
-  int shaderIndex(const char* name) const;
-  int textureIndex(const char* name) const;
-  int soundIndex(const char* name) const;
-  int musicTrackIndex(const char* name) const;
-  int caelumIndex(const char* name) const;
-  int terraIndex(const char* name) const;
-  int partIndex(const char* name) const;
-  int modelIndex(const char* name) const;
+  int shaderIndex(Atom name) const;
+  int textureIndex(Atom name) const;
+  int soundIndex(Atom name) const;
+  int musicTrackIndex(Atom name) const;
+  int caelumIndex(Atom name) const;
+  int terraIndex(Atom name) const;
+  int partIndex(Atom name) const;
+  int modelIndex(Atom name) const;
+
+  int mindIndex(Atom name) const;
+
+  const FragPool* fragPool(Atom name) const;
+  const ObjectClass* objClass(Atom name) const;
+  const BSP* bsp(Atom name) const;
+
+  int shaderIndex(const char* name) const
+  {
+    return shaderIndex(findName(name));
+  }
+
+  int textureIndex(const char* name) const
+  {
+    return textureIndex(findName(name));
+  }
+
+  int soundIndex(const char* name) const
+  {
+    return soundIndex(findName(name));
+  }
+
+  int musicTrackIndex(const char* name) const
+  {
+    return musicTrackIndex(findName(name));
+  }
+
+  int caelumIndex(const char* name) const
+  {
+    return caelumIndex(findName(name));
+  }
 
-  int mindIndex(const char* name) const;
+  int terraIndex(const char* name) const
+  {
+    return terraIndex(findName(name));
+  }
 
-  const FragPool* fragPool(const char* name) const;
-  const ObjectClass* objClass(const char* name) const;
-  const BSP* bsp(const char* name) const;
+  int partIndex(const char* name) const
+  {
+    return partIndex(findName(name));
+  }
+
+  int modelIndex(const char* name) const
+  {
+    return modelIndex(findName(name));
+  }
+
+  int mindIndex(const char* name) const
+  {
+    return mindIndex(findName(name));
+  }
+
+  const FragPool* fragPool(const char* name) const
+  {
+    return fragPool(findName(name));
+  }
+
+  const ObjectClass* objClass(const char* name) const
+  {
+    return objClass(findName(name));
+  }
+
+  const BSP* bsp(const char* name) const
+  {
+    return bsp(findName(name));
+  }
 
   int deviceIndex(const char* name) const;
   int imagoIndex(const char* name) const;
@@ -83,6 +143,18 @@ public:
 
 private:
 
+  /**
+   * Look up an existing atom, so that lookups by name do not intern the names.
+   *
+   * A name that is not interned is in none of the tables. Only then is the name interned, so that
+   * the lookup reports it as invalid just as it would for an unknown interned name.
+   */
+  static Atom findName(const char* name)
+  {
+    Atom atom = Atom::find(name);
+    return atom.isEmpty() && !String::isEmpty(name) ? Atom(name) : atom;
+  }
+
   void initShaders();
   void initTextures();
   void initSounds();
@@ -62,6 +62,8 @@ String LuaMatrix::nameGenCall(const char* functionName)
 
 bool LuaMatrix::objectCall(const char* functionName, Object* self, Bot* user)
 {
+  Alloc::Tag allocTag("lua");
+
   lua_State* l = l_;
 
   ms.self     = self;
@@ -174,6 +176,7 @@ void LuaMatrix::init()
 
   IMPORT_FUNC(ozError);
   IMPORT_FUNC(ozPrintln);
+  IMPORT_FUNC(ozAtom);
 
   /*
    * Orbis
@@ -41,29 +41,32 @@ void Matrix::update()
   maxVehicles = max(maxVehicles, Vehicle::pool.size());
   maxFrags    = max(maxFrags,    Frag::mpool.size());
 
-  for (int i = 0; i < Orbis::MAX_OBJECTS; ++i) {
+  // release pool blocks that have not been used since the last large battle
+  if (timer.ticks % Timer::TICKS_PER_SEC == 0) {
+    for (ConcurrentPoolAlloc* pool = ConcurrentPoolAlloc::first(); pool != nullptr;
+         pool = pool->next())
+    {
+      pool->trim();
+    }
+  }
+
+  for (int i = orbis.nextObjIndex(0); i != -1; i = orbis.nextObjIndex(i + 1)) {
     Object* obj = orbis.obj(i);
 
-    if (obj != nullptr) {
-      // If this is cleared on the object's update, we may also remove effects added by other
-      // objects updated before it.
-      obj->events.free();
+    // If this is cleared on the object's update, we may also remove effects added by other objects
+    // updated before it.
+    obj->events.free();
 
-      // We don't remove objects as they get destroyed but on the next update, so the destruction
-      // sound and other effects can be played on an object's destruction.
-      if (obj->flags & Object::DESTROYED_BIT) {
-        synapse.remove(obj);
-      }
+    // We don't remove objects as they get destroyed but on the next update, so the destruction
+    // sound and other effects can be played on an object's destruction.
+    if (obj->flags & Object::DESTROYED_BIT) {
+      synapse.remove(obj);
     }
   }
 
-  for (int i = 0; i < Orbis::MAX_STRUCTS; ++i) {
+  for (int i = orbis.nextStrIndex(0); i != -1; i = orbis.nextStrIndex(i + 1)) {
     Struct* str = orbis.str(i);
 
-    if (str == nullptr) {
-      continue;
-    }
-
     OZ_ASSERT(str->life >= 0.0f);
 
     if (str->demolishing >= 1.0f) {
@@ -77,13 +80,9 @@ void Matrix::update()
     }
   }
 
-  for (int i = 0; i < Orbis::MAX_OBJECTS; ++i) {
+  for (int i = orbis.nextObjIndex(0); i != -1; i = orbis.nextObjIndex(i + 1)) {
     Object* obj = orbis.obj(i);
 
-    if (obj == nullptr) {
-      continue;
-    }
-
     OZ_ASSERT(obj->life >= 0.0f);
 
     if (obj->life == 0.0f) {
@@ -107,6 +106,12 @@ void Matrix::update()
       // objects should not remove themselves within onUpdate()
       OZ_ASSERT(orbis.obj(i) != nullptr);
 
+      // onUpdate() may move an object or change its dimensions (e.g. crouching bots) without
+      // physics, so cell bounds mirrors must be refreshed
+      if ((obj->flags & Object::UPDATE_FUNC_BIT) && obj->cell != nullptr) {
+        orbis.reposition(obj);
+      }
+
       if (obj->flags & Object::DYNAMIC_BIT) {
         Dynamic* dyn = static_cast<Dynamic*>(obj);
 
@@ -118,33 +123,38 @@ void Matrix::update()
           }
         }
         else {
-          physics.updateObj(dyn);
-
-          // remove on velocity overflow
-          if (dyn->velocity.sqN() > MAX_VELOCITY2) {
-            synapse.remove(dyn);
-          }
+          movingObjects.add(i);
         }
       }
     }
   }
 
-  for (int i = 0; i < Orbis::MAX_FRAGS; ++i) {
+  for (int i = orbis.nextFragIndex(0); i != -1; i = orbis.nextFragIndex(i + 1)) {
     Frag* frag = orbis.frag(i);
 
-    if (frag == nullptr) {
-      continue;
-    }
-
     if (frag->life <= 0.0f || frag->velocity.sqN() > MAX_VELOCITY2) {
       synapse.remove(frag);
     }
     else {
       frag->life -= Timer::TICK_TIME;
-      physics.updateFrag(frag);
+      movingFrags.add(i);
+    }
+  }
+
+  physics.update(movingObjects, movingFrags);
+
+  for (int i : movingObjects) {
+    Dynamic* dyn = orbis.obj<Dynamic>(i);
+
+    // remove on velocity overflow
+    if (dyn != nullptr && dyn->cell != nullptr && dyn->velocity.sqN() > MAX_VELOCITY2) {
+      synapse.remove(dyn);
     }
   }
 
+  movingObjects.clear();
+  movingFrags.clear();
+
   // rotate freeing/waiting/available indices
   orbis.update();
 }
@@ -157,7 +167,7 @@ void Matrix::read(Stream* is)
   timer.ticks = is->readULong64();
   timer.time  = Duration(is->readLong64());
   orbis.read(is);
-  physics.gravity = is->readFloat();
+  physics.read(is);
 
   Log::unindent();
   Log::println("}");
@@ -179,7 +189,7 @@ void Matrix::write(Stream* os) const
   os->writeULong64(timer.ticks);
   os->writeLong64(timer.time.ns());
   orbis.write(os);
-  os->writeFloat(physics.gravity);
+  physics.write(os);
 }
 
 Json Matrix::write() const
@@ -202,8 +212,7 @@ void Matrix::load()
 
   orbis.load();
   synapse.load();
-
-  physics.gravity = -9.81f;
+  physics.load();
 
   Log::printEnd(" OK");
 }
@@ -228,6 +237,14 @@ void Matrix::unload()
   Log::unindent();
   Log::println("}");
 
+  Log::printPoolStatistics();
+
+  movingObjects.trim();
+  movingFrags.trim();
+
+  physics.unload();
+  collider.unload();
+
   synapse.unload();
   orbis.unload();
 
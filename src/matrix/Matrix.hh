@@ -43,6 +43,10 @@ private:
   int maxVehicles;
   int maxFrags;
 
+  // Positioned objects and fragments to be simulated by Physics in the current tick.
+  List<int> movingObjects;
+  List<int> movingFrags;
+
 public:
 
   void update();
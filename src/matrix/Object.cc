@@ -40,8 +40,8 @@ const float Object::DAMAGE_BASE_INTENSITY  = 0.30f;
 const float Object::DAMAGE_INTENSITY_COEF  = 0.01f;
 const Vec3  Object::DESTRUCT_FRAG_VELOCITY = Vec3(0.0f, 0.0f, 2.0f);
 
-Pool<Object::Event> Object::Event::pool(256);
-Pool<Object>        Object::pool(16384);
+ConcurrentPool<Object::Event> Object::Event::pool("Object::Event", 256);
+ConcurrentPool<Object>        Object::pool("Object", 16384);
 
 void Object::onDestroy()
 {
@@ -195,7 +195,7 @@ Json Object::write() const
 {
   Json json(Json::OBJECT);
 
-  json.add("class", clazz->name);
+  json.add("class", clazz->name.c());
   json.add("life", life);
 
   if (cell != nullptr) {
@@ -198,7 +198,7 @@ public:
   {
   public:
 
-    static Pool<Event> pool;
+    static ConcurrentPool<Event> pool;
 
     int    id;
     float  intensity;
@@ -215,13 +215,14 @@ public:
 
 public:
 
-  static Pool<Object> pool;
+  static ConcurrentPool<Object> pool;
 
   /*
    * FIELDS
    */
 
   Cell*              cell       = nullptr;     // parent cell, nullptr if not positioned in world
+  int                cellSlot   = -1;          // slot in the parent cell's bounds arrays
   int                index      = -1;          // index in orbis.objects
 
   int                flags;
@@ -235,7 +236,7 @@ public:
   // matrix update
   Chain<Event>       events;
   // inventory
-  List<int>          items;
+  SmallList<int, 4>  items;
 
 protected:
 
@@ -35,14 +35,14 @@ ObjectClass* ObjectClass::createClass()
 
 void ObjectClass::init(const Json& config, const char* name_)
 {
-  const char* origTitle       = config["title"].get(name);
+  const char* origTitle       = config["title"].get(name.c());
   const char* origDescription = config["description"].get("");
 
   /*
    * name
    */
 
-  name        = name_;
+  name        = Atom(name_);
   title       = OZ_GETTEXT(origTitle);
   description = OZ_GETTEXT(origDescription);
 
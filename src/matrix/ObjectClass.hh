@@ -54,7 +54,7 @@ public:
 
   typedef ObjectClass* CreateFunc();
 
-  String                   name;
+  Atom                     name;
   String                   title;
   String                   description;
 
@@ -38,90 +38,214 @@ static_assert(Orbis::CELLS * Cell::SIZE == Terra::QUADS * Terra::Quad::SIZE,
  * behaviour or even a crash if the new entity doesn't have the same type.
  *
  * To ensure that one full update passes between the updates we tag slots as 'freeing' when they are
- * freed and 'waiting' in the next world update. In the update after 'waiting' state they can be
- * reused again.
+ * freed and 'waiting' in the next world update. In the update after 'waiting' state they are put
+ * onto the free list and can be reused again.
  */
 
 static int freeing = 0;
 static int waiting = 1;
 
-static int lastStructIndex = -1;
-static int lastObjectIndex = -1;
-static int lastFragIndex   = -1;
-
-static SBitset<Orbis::MAX_STRUCTS> pendingStructs[2];
-static SBitset<Orbis::MAX_OBJECTS> pendingObjects[2];
-static SBitset<Orbis::MAX_FRAGS>   pendingFrags[2];
-
-int Orbis::allocStrIndex() const
+/**
+ * Delayed free-list of slot indices.
+ *
+ * Slots that have never been used are taken from `top`, freed slots wait in `pending[freeing]` and
+ * `pending[waiting]` until they are put onto the `available` list two updates later.
+ */
+template <int SIZE>
+struct SlotList
 {
-  int index = lastStructIndex + 1;
+  List<int> available;
+  List<int> pending[2];
+  int       top = 0;
 
-  while (structs[index] != nullptr || pendingStructs[0].get(index) || pendingStructs[1].get(index))
+  int allocate()
   {
-    if (index == lastStructIndex) {
-      // We have wrapped around => no slots available.
+    if (!available.isEmpty()) {
+      return available.popLast();
+    }
+    else if (top < SIZE) {
+      return top++;
+    }
+    else {
+      // No slots available.
       OZ_ASSERT(false);
       return -1;
     }
+  }
 
-    index = (index + 1) % MAX_STRUCTS;
+  void free(int index)
+  {
+    pending[freeing].add(index);
   }
 
-  lastStructIndex = index;
-  return index;
-}
+  void update()
+  {
+    available.addAll(pending[waiting].begin(), pending[waiting].size());
+    pending[waiting].clear();
+  }
 
-int Orbis::allocObjIndex() const
-{
-  int index = lastObjectIndex + 1;
+  /**
+   * Reorder available slots so the lowest ones are reused first.
+   */
+  void sort()
+  {
+    Arrays::sort<int, Greater<int>>(available.begin(), available.size());
+  }
 
-  while (objects[index] != nullptr || pendingObjects[0].get(index) || pendingObjects[1].get(index))
+  void clear()
   {
-    if (index == lastObjectIndex) {
-      // We have wrapped around => no slots available.
-      OZ_ASSERT(false);
-      return -1;
+    available.clear();
+    pending[0].clear();
+    pending[1].clear();
+    top = 0;
+  }
+
+  /**
+   * Rebuild from the saved highest used index and pending slots, where `active` marks slots of
+   * already read entities.
+   */
+  void read(Stream* is, int lastIndex, const HBitset<SIZE>& active)
+  {
+    static SBitset<SIZE> pendingBits[2];
+
+    is->readBitset(pendingBits[freeing]);
+    is->readBitset(pendingBits[waiting]);
+
+    clear();
+
+    top = lastIndex + 1;
+
+    for (int i = 0; i < SIZE; ++i) {
+      if (pendingBits[freeing].get(i)) {
+        pending[freeing].add(i);
+        top = max(top, i + 1);
+      }
+      else if (pendingBits[waiting].get(i)) {
+        pending[waiting].add(i);
+        top = max(top, i + 1);
+      }
+      else if (active.get(i)) {
+        top = max(top, i + 1);
+      }
     }
 
-    index = (index + 1) % MAX_OBJECTS;
+    for (int i = top - 1; i >= 0; --i) {
+      if (!active.get(i) && !pendingBits[0].get(i) && !pendingBits[1].get(i)) {
+        available.add(i);
+      }
+    }
   }
 
-  lastObjectIndex = index;
-  return index;
+  void write(Stream* os) const
+  {
+    static SBitset<SIZE> pendingBits[2];
+
+    for (int i = 0; i < 2; ++i) {
+      pendingBits[i].clear();
+
+      for (int index : pending[i]) {
+        pendingBits[i].set(index);
+      }
+    }
+
+    os->writeBitset(pendingBits[freeing]);
+    os->writeBitset(pendingBits[waiting]);
+  }
+};
+
+static SlotList<Orbis::MAX_STRUCTS> structSlots;
+static SlotList<Orbis::MAX_OBJECTS> objectSlots;
+static SlotList<Orbis::MAX_FRAGS>   fragSlots;
+
+int Orbis::allocStrIndex() const
+{
+  return structSlots.allocate();
+}
+
+int Orbis::allocObjIndex() const
+{
+  return objectSlots.allocate();
 }
 
 int Orbis::allocFragIndex() const
 {
-  int index = lastFragIndex + 1;
+  return fragSlots.allocate();
+}
 
-  while (frags[index] != nullptr || pendingFrags[0].get(index) || pendingFrags[1].get(index)) {
-    if (index == lastFragIndex) {
-      // We have wrapped around => no slots available.
-      OZ_ASSERT(false);
-      return -1;
+/**
+ * Write object's bounds into its slot of cell's bounds arrays.
+ */
+static void setBounds(const Cell::ObjectBounds& bounds, const Object* obj)
+{
+  int    slot = obj->cellSlot;
+  float* data = bounds.data;
+  int    cap  = bounds.capacity;
+
+  data[0 * cap + slot] = obj->p.x;
+  data[1 * cap + slot] = obj->p.y;
+  data[2 * cap + slot] = obj->p.z;
+  data[3 * cap + slot] = obj->dim.x;
+  data[4 * cap + slot] = obj->dim.y;
+  data[5 * cap + slot] = obj->dim.z;
+
+  bounds.indices()[slot] = obj->index;
+}
+
+static void addBounds(Cell* cell, Object* obj)
+{
+  Cell::ObjectBounds& bounds = cell->objBounds;
+
+  if (bounds.size == bounds.capacity) {
+    int    newCapacity = bounds.capacity == 0 ? 8 : 2 * bounds.capacity;
+    float* newData     = new float[7 * newCapacity];
+
+    for (int i = 0; i < 6; ++i) {
+      Arrays::copy<float>(bounds.data + i * bounds.capacity, bounds.size,
+                          newData + i * newCapacity);
     }
+    Arrays::copy<int>(bounds.indices(), bounds.size,
+                      reinterpret_cast<int*>(newData + 6 * newCapacity));
 
-    index = (index + 1) % MAX_FRAGS;
+    delete[] bounds.data;
+    bounds.data     = newData;
+    bounds.capacity = newCapacity;
   }
 
-  lastFragIndex = index;
-  return index;
+  obj->cellSlot = bounds.size;
+  ++bounds.size;
+
+  setBounds(bounds, obj);
 }
 
-bool Orbis::position(Struct* str)
+static void removeBounds(Cell* cell, Object* obj)
 {
-  Span span = getInters(*str, EPSILON);
+  Cell::ObjectBounds& bounds = cell->objBounds;
 
-  for (int x = span.minX; x <= span.maxX; ++x) {
-    for (int y = span.minY; y <= span.maxY; ++y) {
-      if (cells[x][y].structs.size() == cells[x][y].structs.capacity()) {
-        OZ_ASSERT(false);
-        return false;
-      }
+  int slot = obj->cellSlot;
+  int last = bounds.size - 1;
+
+  OZ_ASSERT(uint(slot) < uint(bounds.size) && bounds.indices()[slot] == obj->index);
+
+  // Move the last object into the freed slot.
+  if (slot != last) {
+    int* indices = bounds.indices();
+
+    for (int i = 0; i < 6; ++i) {
+      bounds.data[i * bounds.capacity + slot] = bounds.data[i * bounds.capacity + last];
     }
+    indices[slot] = indices[last];
+
+    orbis.obj(indices[slot])->cellSlot = slot;
   }
 
+  obj->cellSlot = -1;
+  --bounds.size;
+}
+
+bool Orbis::position(Struct* str)
+{
+  Span span = getInters(*str, EPSILON);
+
   for (int x = span.minX; x <= span.maxX; ++x) {
     for (int y = span.minY; y <= span.maxY; ++y) {
       OZ_ASSERT(!cells[x][y].structs.contains(short(str->index)));
@@ -160,6 +284,7 @@ void Orbis::position(Object* obj)
   }
 
   cell->objects.add(obj);
+  addBounds(cell, obj);
 }
 
 void Orbis::unposition(Object* obj)
@@ -175,6 +300,7 @@ void Orbis::unposition(Object* obj)
   }
 
   cell->objects.eraseAfter(obj, obj->prev[0]);
+  removeBounds(cell, obj);
 }
 
 void Orbis::position(Frag* frag)
@@ -217,6 +343,7 @@ Struct* Orbis::add(const BSP* bsp, const Point& p, Heading heading)
 
   Struct* str = new Struct(bsp, index, p, heading);
   structs[index] = str;
+  activeStructs.set(index);
 
   return str;
 }
@@ -230,6 +357,7 @@ Object* Orbis::add(const ObjectClass* clazz, const Point& p, Heading heading)
 
   Object* obj = clazz->create(index, p, heading);
   objects[index] = obj;
+  activeObjects.set(index);
 
   if (obj->flags & Object::LUA_BIT) {
     luaMatrix.registerObject(index);
@@ -247,6 +375,7 @@ Frag* Orbis::add(const FragPool* pool, const Point& p, const Vec3& velocity)
 
   Frag* frag = new Frag(pool, index, p, velocity);
   frags[index] = frag;
+  activeFrags.set(index);
 
   return frag;
 }
@@ -255,8 +384,9 @@ void Orbis::remove(Struct* str)
 {
   OZ_ASSERT(str->index != -1);
 
-  pendingStructs[freeing].set(str->index);
+  structSlots.free(str->index);
   structs[str->index] = nullptr;
+  activeStructs.clear(str->index);
   delete str;
 }
 
@@ -268,8 +398,9 @@ void Orbis::remove(Object* obj)
     luaMatrix.unregisterObject(obj->index);
   }
 
-  pendingObjects[freeing].set(obj->index);
+  objectSlots.free(obj->index);
   objects[obj->index] = nullptr;
+  activeObjects.clear(obj->index);
   delete obj;
 }
 
@@ -277,8 +408,9 @@ void Orbis::remove(Frag* frag)
 {
   OZ_ASSERT(frag->index != -1 && frag->cell == nullptr);
 
-  pendingFrags[freeing].set(frag->index);
+  fragSlots.free(frag->index);
   frags[frag->index] = nullptr;
+  activeFrags.clear(frag->index);
   delete frag;
 }
 
@@ -295,6 +427,7 @@ void Orbis::reposition(Object* obj)
     }
 
     oldCell->objects.eraseAfter(obj, obj->prev[0]);
+    removeBounds(oldCell, obj);
 
     obj->cell = newCell;
     obj->prev[0] = nullptr;
@@ -304,6 +437,10 @@ void Orbis::reposition(Object* obj)
     }
 
     newCell->objects.add(obj);
+    addBounds(newCell, obj);
+  }
+  else {
+    setBounds(newCell->objBounds, obj);
   }
 }
 
@@ -334,16 +471,16 @@ void Orbis::reposition(Frag* frag)
 
 void Orbis::resetLastIndices()
 {
-  lastStructIndex = -1;
-  lastObjectIndex = -1;
-  lastFragIndex   = -1;
+  structSlots.sort();
+  objectSlots.sort();
+  fragSlots.sort();
 }
 
 void Orbis::update()
 {
-  pendingStructs[waiting].clear();
-  pendingObjects[waiting].clear();
-  pendingFrags[waiting].clear();
+  structSlots.update();
+  objectSlots.update();
+  fragSlots.update();
 
   swap(freeing, waiting);
 
@@ -369,6 +506,7 @@ void Orbis::read(Stream* is)
 
     position(str);
     structs[str->index] = str;
+    activeStructs.set(str->index);
   }
 
   for (int i = 0; i < nObjects; ++i) {
@@ -383,6 +521,7 @@ void Orbis::read(Stream* is)
       position(obj);
     }
     objects[obj->index] = obj;
+    activeObjects.set(obj->index);
   }
 
   for (int i = 0; i < nFrags; ++i) {
@@ -392,18 +531,16 @@ void Orbis::read(Stream* is)
 
     position(frag);
     frags[frag->index] = frag;
+    activeFrags.set(frag->index);
   }
 
-  lastStructIndex = is->readInt();
-  lastObjectIndex = is->readInt();
-  lastFragIndex   = is->readInt();
+  int lastStructIndex = is->readInt();
+  int lastObjectIndex = is->readInt();
+  int lastFragIndex   = is->readInt();
 
-  is->readBitset(pendingStructs[freeing]);
-  is->readBitset(pendingStructs[waiting]);
-  is->readBitset(pendingObjects[freeing]);
-  is->readBitset(pendingObjects[waiting]);
-  is->readBitset(pendingFrags[freeing]);
-  is->readBitset(pendingFrags[waiting]);
+  structSlots.read(is, lastStructIndex, activeStructs);
+  objectSlots.read(is, lastObjectIndex, activeObjects);
+  fragSlots.read(is, lastFragIndex, activeFrags);
 }
 
 void Orbis::read(const Json& json)
@@ -420,6 +557,7 @@ void Orbis::read(const Json& json)
       Struct* str = new Struct(bsp, index, strJson);
       position(str);
       structs[index] = str;
+      activeStructs.set(index);
     }
   }
 
@@ -440,6 +578,7 @@ void Orbis::read(const Json& json)
         position(obj);
       }
       objects[obj->index] = obj;
+      activeObjects.set(obj->index);
 
       for (const Json& itemJson : objJson["items"].arrayCIter()) {
         String              itemName  = itemJson["class"].get("");
@@ -464,6 +603,7 @@ void Orbis::read(const Json& json)
           }
 
           objects[item->index] = item;
+          activeObjects.set(item->index);
         }
       }
     }
@@ -490,6 +630,7 @@ int Orbis::readObject(const Json& json)
     position(obj);
   }
   objects[obj->index] = obj;
+  activeObjects.set(obj->index);
 
   return index;
 }
@@ -510,41 +651,30 @@ void Orbis::write(Stream* os) const
   os->writeInt(nObjects);
   os->writeInt(nFrags);
 
-  for (int i = 0; i < MAX_STRUCTS; ++i) {
-    Struct* str = structs[i];
-
-    if (str != nullptr) {
-      os->writeString(str->bsp->name);
-      str->write(os);
-    }
-  }
-  for (int i = 0; i < MAX_OBJECTS; ++i) {
-    Object* obj = objects[i];
-
-    if (obj != nullptr) {
-      os->writeString(obj->clazz->name);
-      obj->write(os);
-    }
-  }
-  for (int i = 0; i < MAX_FRAGS; ++i) {
-    Frag* frag = frags[i];
-
-    if (frag != nullptr) {
-      os->writeString(frag->pool->name);
-      frag->write(os);
-    }
-  }
-
-  os->writeInt(lastStructIndex);
-  os->writeInt(lastObjectIndex);
-  os->writeInt(lastFragIndex);
-
-  os->writeBitset(pendingStructs[freeing]);
-  os->writeBitset(pendingStructs[waiting]);
-  os->writeBitset(pendingObjects[freeing]);
-  os->writeBitset(pendingObjects[waiting]);
-  os->writeBitset(pendingFrags[freeing]);
-  os->writeBitset(pendingFrags[waiting]);
+  activeStructs.forEachSet([this, os](int i)
+  {
+    os->writeString(structs[i]->bsp->name);
+    structs[i]->write(os);
+  });
+  activeObjects.forEachSet([this, os](int i)
+  {
+    os->writeString(objects[i]->clazz->name.c());
+    objects[i]->write(os);
+  });
+  activeFrags.forEachSet([this, os](int i)
+  {
+    os->writeString(frags[i]->pool->name.c());
+    frags[i]->write(os);
+  });
+
+  // Highest used indices, kept for compatibility with saves from round-robin slot allocation.
+  os->writeInt(structSlots.top - 1);
+  os->writeInt(objectSlots.top - 1);
+  os->writeInt(fragSlots.top - 1);
+
+  structSlots.write(os);
+  objectSlots.write(os);
+  fragSlots.write(os);
 }
 
 Json Orbis::write() const
@@ -559,27 +689,27 @@ Json Orbis::write() const
   Json structsJson = Json::ARRAY;
   Json objectsJson = Json::ARRAY;
 
-  for (int i = 0; i < MAX_STRUCTS; ++i) {
+  activeStructs.forEachSet([&](int i)
+  {
     const Struct* str = structs[i];
 
-    if (str != nullptr) {
-      structsJson.add(str->write());
+    structsJson.add(str->write());
 
-      for (int j : str->boundObjects) {
-        if (objects[j] != nullptr) {
-          boundObjects.add(j);
-        }
+    for (int j : str->boundObjects) {
+      if (objects[j] != nullptr) {
+        boundObjects.add(j);
       }
     }
-  }
+  });
 
-  for (int i = 0; i < MAX_OBJECTS; ++i) {
+  activeObjects.forEachSet([&](int i)
+  {
     const Object* obj = objects[i];
 
-    if (obj != nullptr && obj->cell != nullptr && !boundObjects.contains(obj->index)) {
+    if (obj->cell != nullptr && !boundObjects.contains(obj->index)) {
       objectsJson.add(obj->write());
     }
-  }
+  });
 
   json.add("structs", static_cast<Json&&>(structsJson));
   json.add("objects", static_cast<Json&&>(objectsJson));
@@ -592,23 +722,43 @@ void Orbis::load()
 
 void Orbis::unload()
 {
-  for (int i = 0; i < MAX_OBJECTS; ++i) {
-    if (objects[i] != nullptr && (objects[i]->flags & Object::LUA_BIT)) {
+  activeObjects.forEachSet([this](int i)
+  {
+    if (objects[i]->flags & Object::LUA_BIT) {
       luaMatrix.unregisterObject(i);
     }
-  }
+  });
 
   for (int i = 0; i < Orbis::CELLS; ++i) {
     for (int j = 0; j < Orbis::CELLS; ++j) {
       cells[i][j].structs.clear();
       cells[i][j].objects.clear();
       cells[i][j].frags.clear();
+
+      delete[] cells[i][j].objBounds.data;
+      cells[i][j].objBounds = Cell::ObjectBounds();
     }
   }
 
-  Arrays::free(frags, MAX_FRAGS);
-  Arrays::free(objects, MAX_OBJECTS);
-  Arrays::free(structs, MAX_STRUCTS);
+  activeFrags.forEachSet([this](int i)
+  {
+    delete frags[i];
+    frags[i] = nullptr;
+  });
+  activeObjects.forEachSet([this](int i)
+  {
+    delete objects[i];
+    objects[i] = nullptr;
+  });
+  activeStructs.forEachSet([this](int i)
+  {
+    delete structs[i];
+    structs[i] = nullptr;
+  });
+
+  activeFrags.clear();
+  activeObjects.clear();
+  activeStructs.clear();
 
   terra.reset();
   caelum.reset();
@@ -627,16 +777,9 @@ void Orbis::unload()
   Struct::overlappingObjs.trim();
   Struct::pool.free();
 
-  lastStructIndex = -1;
-  lastObjectIndex = -1;
-  lastFragIndex   = -1;
-
-  pendingStructs[0].clear();
-  pendingStructs[1].clear();
-  pendingObjects[0].clear();
-  pendingObjects[1].clear();
-  pendingFrags[0].clear();
-  pendingFrags[1].clear();
+  structSlots.clear();
+  objectSlots.clear();
+  fragSlots.clear();
 }
 
 void Orbis::init()
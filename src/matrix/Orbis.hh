@@ -36,9 +36,42 @@ struct Cell
 {
   static const int SIZE = 16;
 
-  SList<short, 6> structs;
-  Chain<Object>   objects;
-  Chain<Frag>     frags;
+  /**
+   * Structure-of-arrays mirror of bounds of objects in a cell, used to filter overlap candidates
+   * with vector instructions before the exact tests.
+   *
+   * Centres, half-dimensions and object indices share a single block, `capacity` elements each.
+   * `Orbis` keeps it in sync on every (re/un)positioning, slots are given by `Object::cellSlot`.
+   */
+  struct ObjectBounds
+  {
+    float* data     = nullptr; ///< x, y, z, dim x, dim y, dim z and index arrays.
+    int    size     = 0;       ///< Number of objects.
+    int    capacity = 0;       ///< Length of each array.
+
+    OZ_ALWAYS_INLINE
+    Batch::Coords centres() const
+    {
+      return {data, data + capacity, data + 2 * capacity};
+    }
+
+    OZ_ALWAYS_INLINE
+    Batch::Coords dims() const
+    {
+      return {data + 3 * capacity, data + 4 * capacity, data + 5 * capacity};
+    }
+
+    OZ_ALWAYS_INLINE
+    int* indices() const
+    {
+      return reinterpret_cast<int*>(data + 6 * capacity);
+    }
+  };
+
+  SmallList<short, 6> structs;
+  Chain<Object>       objects;
+  Chain<Frag>         frags;
+  ObjectBounds        objBounds;
 };
 
 /**
@@ -68,6 +101,11 @@ private:
   Object* objects[MAX_OBJECTS];
   Frag*   frags[MAX_FRAGS];
 
+  // Occupied slots, so updates and serialisation skip empty parts of the arrays above.
+  HBitset<MAX_STRUCTS> activeStructs;
+  HBitset<MAX_OBJECTS> activeObjects;
+  HBitset<MAX_FRAGS>   activeFrags;
+
 private:
 
   int allocStrIndex() const;
@@ -208,6 +246,36 @@ public:
     return index == -1 || frags[index] == nullptr ? -1 : index;
   }
 
+  /**
+   * Index of the first existing structure at `index` or after it, -1 if there is none.
+   *
+   * Structures added or removed while iterating are handled the same way as in a loop over all
+   * indices.
+   */
+  OZ_ALWAYS_INLINE
+  int nextStrIndex(int index) const
+  {
+    return activeStructs.findNextSet(index);
+  }
+
+  /**
+   * Index of the first existing object at `index` or after it, -1 if there is none.
+   */
+  OZ_ALWAYS_INLINE
+  int nextObjIndex(int index) const
+  {
+    return activeObjects.findNextSet(index);
+  }
+
+  /**
+   * Index of the first existing fragment at `index` or after it, -1 if there is none.
+   */
+  OZ_ALWAYS_INLINE
+  int nextFragIndex(int index) const
+  {
+    return activeFrags.findNextSet(index);
+  }
+
   OZ_ALWAYS_INLINE
   Cell* getCell(float x, float y)
   {
@@ -55,6 +55,97 @@ const float Physics::FRAG_DESTROY_VELOCITY2  =  300.0f;
 const float Physics::FRAG_DAMAGE_COEF        =  0.05f;
 const float Physics::FRAG_FIXED_DAMAGE       =  0.75f;
 
+const float Physics::PARALLEL_MAX_MOVE       =  Cell::SIZE / 4.0f;
+
+static_assert(2 * Object::MAX_DIM + Cell::SIZE / 4 < Cell::SIZE,
+              "Physics::PARALLEL_MAX_MOVE reaches out of cell neighbourhood");
+
+int Physics::islandNext[Orbis::MAX_OBJECTS];
+
+// Contexts for parallel jobs, one per job and reused between ticks.
+static List<Physics> contexts;
+
+//***********************************
+//*             ISLANDS             *
+//***********************************
+
+void Physics::link(int index, int lowerIndex)
+{
+  if (isDeferred) {
+    islandOps.add(IslandOp{index, lowerIndex});
+    return;
+  }
+
+  int& next      = islandNext[index];
+  int& lowerNext = islandNext[lowerIndex];
+
+  next      = next == -1 ? index : next;
+  lowerNext = lowerNext == -1 ? lowerIndex : lowerNext;
+
+  // Already in the same island, splicing would split it.
+  for (int i = next; i != index; i = islandNext[i]) {
+    if (i == lowerIndex) {
+      return;
+    }
+  }
+
+  swap(next, lowerNext);
+}
+
+void Physics::wakeIsland(int index)
+{
+  if (islandNext[index] == -1) {
+    return;
+  }
+  else if (isDeferred) {
+    islandOps.add(IslandOp{index, -1});
+    return;
+  }
+
+  // The object itself is already awake or has just fallen asleep again, when deferred.
+  int i = islandNext[index];
+  islandNext[index] = -1;
+
+  while (i != index) {
+    int next = islandNext[i];
+    islandNext[i] = -1;
+
+    Dynamic* member = orbis.obj<Dynamic>(i);
+    OZ_ASSERT(member != nullptr);
+
+    member->flags &= ~Object::DISABLED_BIT;
+    i = next;
+  }
+}
+
+void Physics::damageStruct(Struct* str, float damage)
+{
+  if (isDeferred) {
+    structDamages.add(StructDamage{str->index, damage});
+  }
+  else {
+    str->damage(damage);
+  }
+}
+
+void Physics::applyDeferred(Physics* context)
+{
+  for (const IslandOp& op : context->islandOps) {
+    if (op.lowerIndex == -1) {
+      wakeIsland(op.index);
+    }
+    else {
+      link(op.index, op.lowerIndex);
+    }
+  }
+  for (const StructDamage& structDamage : context->structDamages) {
+    orbis.str(structDamage.index)->damage(structDamage.damage);
+  }
+
+  context->islandOps.clear();
+  context->structDamages.clear();
+}
+
 //***********************************
 //*    OBJECT COLLISION HANDLING    *
 //***********************************
@@ -212,7 +303,8 @@ void Physics::handleObjHit()
       dyn->momentum.x -= (dynMomProj - sDynVelProj) * hit.normal.x;
       dyn->momentum.y -= (dynMomProj - sDynVelProj) * hit.normal.y;
 
-      sDyn->flags      &= ~Object::DISABLED_BIT;
+      wake(sDyn);
+
       sDyn->momentum.x += directPushX;
       sDyn->momentum.y += directPushY;
 
@@ -233,7 +325,9 @@ void Physics::handleObjHit()
       dyn->flags      |= Object::BELOW_BIT;
       dyn->momentum.z  = sDyn->velocity.z;
 
-      sDyn->flags     &= ~(Object::DISABLED_BIT | Object::ON_FLOOR_BIT);
+      wake(sDyn);
+
+      sDyn->flags     &= ~Object::ON_FLOOR_BIT;
       sDyn->lower      = dyn->index;
       sDyn->floor      = Vec3(0.0f, 0.0f, 1.0f);
       sDyn->momentum.z = momentum.z;
@@ -249,7 +343,8 @@ void Physics::handleObjHit()
       sDyn->flags    |= Object::BELOW_BIT;
 
       if (!(sDyn->flags & Object::ON_FLOOR_BIT) && sDyn->lower == -1) {
-        sDyn->flags     &= ~Object::DISABLED_BIT;
+        wake(sDyn);
+
         sDyn->momentum.z = momentum.z;
       }
     }
@@ -273,7 +368,7 @@ void Physics::handleObjHit()
         hit.obj->damage(damage);
       }
       else if (hit.str != nullptr) {
-        hit.str->damage(damage);
+        damageStruct(hit.str, damage);
       }
     }
 
@@ -391,6 +486,21 @@ Vec3 Physics::handleObjMove()
 //*   FRAGMENT COLLISION HANDLING   *
 //***********************************
 
+/**
+ * Random number in [0, 1) for a fragment hit that does not depend on the order fragments are
+ * simulated in, unlike `Math::rand()`.
+ */
+static float hitRand(const Frag* frag)
+{
+  uint hash = uint(frag->index) * 2654435761u ^ uint(timer.ticks) * 40503u;
+
+  hash ^= hash >> 15;
+  hash *= 2246822519u;
+  hash ^= hash >> 13;
+
+  return float(hash >> 8) / float(1 << 24);
+}
+
 void Physics::handleFragHit()
 {
   Vec3  fragVelocity = frag->velocity;
@@ -406,8 +516,8 @@ void Physics::handleFragHit()
         float damage = FRAG_DAMAGE_COEF * velocity2 * frag->mass;
 
         if (damage > str->resistance) {
-          damage *= FRAG_FIXED_DAMAGE + (1.0f - FRAG_FIXED_DAMAGE) * Math::rand();
-          str->damage(damage);
+          damage *= FRAG_FIXED_DAMAGE + (1.0f - FRAG_FIXED_DAMAGE) * hitRand(frag);
+          damageStruct(str, damage);
         }
       }
       else if (collider.hit.obj != nullptr) {
@@ -415,7 +525,7 @@ void Physics::handleFragHit()
         float damage = FRAG_DAMAGE_COEF * velocity2 * frag->mass;
 
         if (damage > obj->resistance) {
-          damage *= FRAG_FIXED_DAMAGE + (1.0f - FRAG_FIXED_DAMAGE) * Math::rand();
+          damage *= FRAG_FIXED_DAMAGE + (1.0f - FRAG_FIXED_DAMAGE) * hitRand(frag);
           obj->damage(damage);
         }
 
@@ -425,7 +535,8 @@ void Physics::handleFragHit()
           float fragMass = frag->mass * 10.0f;
           float massSum  = fragMass + dynObj->mass;
 
-          dynObj->flags   &= ~Object::DISABLED_BIT;
+          wake(dynObj);
+
           dynObj->momentum = (fragVelocity * fragMass + dynObj->momentum * dynObj->mass) / massSum;
         }
       }
@@ -476,6 +587,13 @@ void Physics::handleFragMove()
 //*             PUBLIC              *
 //***********************************
 
+void Physics::wake(Dynamic* dyn)
+{
+  dyn->flags &= ~Object::DISABLED_BIT;
+
+  wakeIsland(dyn->index);
+}
+
 void Physics::updateEnt(Entity* ent, const Vec3& localMove)
 {
   const EntityClass* clazz = ent->clazz;
@@ -494,7 +612,7 @@ void Physics::updateEnt(Entity* ent, const Vec3& localMove)
         Dynamic* sDyn = static_cast<Dynamic*>(sObj);
 
         sDyn->momentum -= 8.0f * collider.hit.normal;
-        sDyn->flags    &= ~Object::DISABLED_BIT;
+        wake(sDyn);
       }
     }
 
@@ -512,16 +630,34 @@ void Physics::updateObj(Dynamic* dyn_)
   dyn         = dyn_;
   dyn->flags &= ~Object::TICK_CLEAR_MASK;
 
-  if (dyn->lower != -1) {
-    if (dyn->flags & Object::ON_FLOOR_BIT) {
+  if (dyn->flags & Object::DISABLED_BIT) {
+    // Sleeping objects are woken by whatever disturbs their island, only moving entities they
+    // rest on have to be polled.
+    if (dyn->lower != -1 && (dyn->flags & Object::ON_FLOOR_BIT)) {
       const Entity* ent = orbis.ent(dyn->lower);
 
       if (ent == nullptr) {
-        dyn->flags &= ~Object::DISABLED_BIT;
-        dyn->lower  = -1;
+        wake(dyn);
+        dyn->lower = -1;
       }
       else if (ent->state == Entity::OPENING || ent->state == Entity::CLOSING) {
-        dyn->flags &= ~Object::DISABLED_BIT;
+        wake(dyn);
+      }
+    }
+
+    if (dyn->flags & Object::DISABLED_BIT) {
+      return;
+    }
+  }
+  else if (islandNext[dyn->index] != -1) {
+    // Woken by clearing DISABLED_BIT directly.
+    wakeIsland(dyn->index);
+  }
+
+  if (dyn->lower != -1) {
+    if (dyn->flags & Object::ON_FLOOR_BIT) {
+      if (orbis.ent(dyn->lower) == nullptr) {
+        dyn->lower = -1;
       }
     }
     else {
@@ -529,65 +665,74 @@ void Physics::updateObj(Dynamic* dyn_)
 
       // Clear the lower object if it doesn't exist any more.
       if (sObj == nullptr || sObj->cell == nullptr) {
-        dyn->flags &= ~Object::DISABLED_BIT;
-        dyn->lower  = -1;
-      }
-      else {
-        dyn->flags &= sObj->flags | ~Object::DISABLED_BIT;
+        dyn->lower = -1;
       }
     }
   }
 
   // Handle physics.
-  if (!(dyn->flags & Object::DISABLED_BIT)) {
-    if (handleObjFriction()) {
-      int oldFlags = dyn->flags;
+  if (handleObjFriction()) {
+    int oldFlags = dyn->flags;
 
-      dyn->flags &= ~(Object::MOVE_CLEAR_MASK | Object::ENABLE_BIT);
-      dyn->lower  = -1;
+    dyn->flags &= ~(Object::MOVE_CLEAR_MASK | Object::ENABLE_BIT);
+    dyn->lower  = -1;
 
-      collider.mask = dyn->flags & Object::SOLID_BIT;
-      Vec3 realisedMove = handleObjMove();
-      collider.mask = Object::SOLID_BIT;
+    collider.mask = dyn->flags & Object::SOLID_BIT;
+    Vec3 realisedMove = handleObjMove();
+    collider.mask = Object::SOLID_BIT;
 
-      if (collider.hit.medium & Medium::LADDER_BIT) {
-        dyn->flags |= Object::ON_LADDER_BIT;
-      }
-      if (collider.hit.medium & Medium::WATER_BIT) {
-        dyn->flags |= Object::IN_LIQUID_BIT;
+    if (collider.hit.medium & Medium::LADDER_BIT) {
+      dyn->flags |= Object::ON_LADDER_BIT;
+    }
+    if (collider.hit.medium & Medium::WATER_BIT) {
+      dyn->flags |= Object::IN_LIQUID_BIT;
 
-        if (!(oldFlags & Object::IN_LIQUID_BIT) && dyn->velocity.z <= SPLASH_THRESHOLD) {
-          float momentum2 = dyn->velocity.z*dyn->velocity.z;
-          float intensity = momentum2 * SPLASH_INTENSITY_COEF;
+      if (!(oldFlags & Object::IN_LIQUID_BIT) && dyn->velocity.z <= SPLASH_THRESHOLD) {
+        float momentum2 = dyn->velocity.z*dyn->velocity.z;
+        float intensity = momentum2 * SPLASH_INTENSITY_COEF;
 
-          dyn->addEvent(Object::EVENT_SPLASH, intensity);
-        }
+        dyn->addEvent(Object::EVENT_SPLASH, intensity);
       }
-      if (collider.hit.medium & Medium::LAVA_BIT) {
-        dyn->flags |= Object::IN_LIQUID_BIT | Object::IN_LAVA_BIT;
+    }
+    if (collider.hit.medium & Medium::LAVA_BIT) {
+      dyn->flags |= Object::IN_LIQUID_BIT | Object::IN_LAVA_BIT;
 
-        if (dyn->resistance <= LAVA_DAMAGE_ABSOLUTE) {
-          dyn->flags |= Object::ENABLE_BIT;
+      if (dyn->resistance <= LAVA_DAMAGE_ABSOLUTE) {
+        dyn->flags |= Object::ENABLE_BIT;
 
-          if ((uint(timer.ticks) + uint(dyn->index * 1025)) % LAVA_DAMAGE_INTERVAL == 0) {
-            dyn->damage(max(LAVA_DAMAGE_ABSOLUTE, dyn->clazz->life * LAVA_DAMAGE_RATIO));
-          }
+        if ((uint(timer.ticks) + uint(dyn->index * 1025)) % LAVA_DAMAGE_INTERVAL == 0) {
+          dyn->damage(max(LAVA_DAMAGE_ABSOLUTE, dyn->clazz->life * LAVA_DAMAGE_RATIO));
         }
       }
-
-      dyn->velocity = realisedMove / Timer::TICK_TIME;
-      dyn->momentum = dyn->velocity;
-      dyn->depth    = min(collider.hit.depth, 2.0f * dyn->dim.z);
     }
-    else {
-      OZ_ASSERT(dyn->momentum == Vec3::ZERO);
 
-      dyn->flags   |= Object::DISABLED_BIT;
-      dyn->velocity = Vec3::ZERO;
+    dyn->velocity = realisedMove / Timer::TICK_TIME;
+    dyn->momentum = dyn->velocity;
+    dyn->depth    = min(collider.hit.depth, 2.0f * dyn->dim.z);
+  }
+  else {
+    OZ_ASSERT(dyn->momentum == Vec3::ZERO);
+
+    dyn->flags   |= Object::DISABLED_BIT;
+    dyn->velocity = Vec3::ZERO;
+
+    // Join the island of the object it rests on.
+    if (dyn->lower != -1 && !(dyn->flags & Object::ON_FLOOR_BIT)) {
+      link(dyn->index, dyn->lower);
     }
   }
 }
 
+void Physics::simulate(const Body& body)
+{
+  if (body.isFrag) {
+    updateFrag(orbis.frag(body.index));
+  }
+  else {
+    updateObj(orbis.obj<Dynamic>(body.index));
+  }
+}
+
 void Physics::updateFrag(Frag* frag_)
 {
   frag = frag_;
@@ -599,6 +744,155 @@ void Physics::updateFrag(Frag* frag_)
   handleFragMove();
 }
 
+void Physics::update(const List<int>& objIndices, const List<int>& fragIndices)
+{
+  static const float MAX_MOMENTUM  = PARALLEL_MAX_MOVE / Timer::TICK_TIME;
+  static const float MAX_MOMENTUM2 = MAX_MOMENTUM * MAX_MOMENTUM;
+  static const int   N_COLOURS     = 9;
+
+  bodies.clear();
+  serialBodies.clear();
+  cellStarts.clear();
+
+  auto addBody = [this](const Cell* cell, const Vec3& momentum, int index, bool isFrag)
+  {
+    int  cellIndex = int(cell - &orbis.cells[0][0]);
+    int  x         = cellIndex / Orbis::CELLS;
+    int  y         = cellIndex % Orbis::CELLS;
+    uint colour    = uint(x % 3 * 3 + y % 3);
+
+    if (momentum.sqN() > MAX_MOMENTUM2) {
+      serialBodies.add(Body{0, index, isFrag});
+    }
+    else {
+      bodies.add(Body{colour << 16 | uint(cellIndex), index, isFrag});
+    }
+  };
+
+  for (int i : objIndices) {
+    const Dynamic* dyn = orbis.obj<const Dynamic>(i);
+
+    if (dyn != nullptr && dyn->cell != nullptr) {
+      addBody(dyn->cell, dyn->momentum, i, false);
+    }
+  }
+  for (int i : fragIndices) {
+    const Frag* frag = orbis.frag(i);
+
+    if (frag != nullptr) {
+      addBody(frag->cell, frag->velocity, i, true);
+    }
+  }
+
+  static_assert(Orbis::CELLS * Orbis::CELLS <= 1 << 16, "Cell index does not fit body key");
+
+  // Stable, so bodies in a cell stay in index order, objects before fragments.
+  bodyBuffer.resize(bodies.size());
+  Arrays::radixSort<Body, BodyKey>(bodies.begin(), bodies.size(), bodyBuffer.begin());
+
+  int colourStarts[N_COLOURS + 1];
+  int colour = 0;
+
+  for (int i = 0; i < bodies.size(); ++i) {
+    if (i == 0 || bodies[i].key != bodies[i - 1].key) {
+      while (colour <= int(bodies[i].key >> 16)) {
+        colourStarts[colour++] = cellStarts.size();
+      }
+      cellStarts.add(i);
+    }
+  }
+  while (colour <= N_COLOURS) {
+    colourStarts[colour++] = cellStarts.size();
+  }
+  cellStarts.add(bodies.size());
+
+  for (int c = 0; c < N_COLOURS; ++c) {
+    int begin   = colourStarts[c];
+    int end     = colourStarts[c + 1];
+    int nJobs   = (end - begin + PARALLEL_CELLS_PER_JOB - 1) / PARALLEL_CELLS_PER_JOB;
+
+    if (nJobs > contexts.size()) {
+      contexts.resize(nJobs);
+    }
+
+    JobSystem::parallelFor(begin, end, PARALLEL_CELLS_PER_JOB, [this, begin](int first, int last)
+    {
+      Physics& context = contexts[(first - begin) / PARALLEL_CELLS_PER_JOB];
+
+      context.isDeferred = true;
+      context.gravity    = gravity;
+
+      for (int i = cellStarts[first]; i < cellStarts[last]; ++i) {
+        context.simulate(bodies[i]);
+      }
+    });
+
+    for (int i = 0; i < nJobs; ++i) {
+      applyDeferred(&contexts[i]);
+    }
+  }
+
+  for (const Body& body : serialBodies) {
+    simulate(body);
+  }
+}
+
+void Physics::read(Stream* is)
+{
+  gravity = is->readFloat();
+
+  // Islands are not saved, rebuild them from sleeping objects and what they rest on.
+  for (int i = orbis.nextObjIndex(0); i != -1; i = orbis.nextObjIndex(i + 1)) {
+    const Object* obj = orbis.obj(i);
+
+    if ((obj->flags & (Object::DYNAMIC_BIT | Object::DISABLED_BIT | Object::ON_FLOOR_BIT)) !=
+        (Object::DYNAMIC_BIT | Object::DISABLED_BIT) || obj->cell == nullptr)
+    {
+      continue;
+    }
+
+    const Dynamic* dyn = static_cast<const Dynamic*>(obj);
+
+    if (dyn->lower != -1 && orbis.obj(dyn->lower) != nullptr) {
+      link(i, dyn->lower);
+    }
+  }
+}
+
+void Physics::write(Stream* os) const
+{
+  os->writeFloat(gravity);
+}
+
+void Physics::load()
+{
+  gravity = -9.81f;
+
+  Arrays::fill<int, int>(islandNext, Orbis::MAX_OBJECTS, -1);
+}
+
+void Physics::unload()
+{
+  contexts.clear();
+  contexts.trim();
+
+  islandOps.clear();
+  islandOps.trim();
+  structDamages.clear();
+  structDamages.trim();
+
+  bodies.clear();
+  bodies.trim();
+  bodyBuffer.clear();
+  bodyBuffer.trim();
+  serialBodies.clear();
+  serialBodies.trim();
+  cellStarts.clear();
+  cellStarts.trim();
+
+  collider.unload();
+}
+
 Physics physics;
 
 }
@@ -67,19 +67,76 @@ public:
   static const float FRAG_DAMAGE_COEF;
   static const float FRAG_FIXED_DAMAGE;
 
+  // Objects and fragments that move further in one tick are simulated serially.
+  static const float PARALLEL_MAX_MOVE;
+  // Number of cells simulated by one job.
+  static const int   PARALLEL_CELLS_PER_JOB = 8;
+
 private:
 
-  Dynamic* dyn;
-  Frag*    frag;
-  Vec3     move;
-  Vec3     lastNormals[2];
+  // Object or fragment to be simulated, sorted by cell colour and cell.
+  struct Body
+  {
+    uint key;
+    int  index;
+    bool isFrag;
+  };
+
+  struct BodyKey
+  {
+    OZ_ALWAYS_INLINE
+    uint operator()(const Body& body) const
+    {
+      return body.key;
+    }
+  };
+
+  // Link `index` into the island of `lowerIndex` or wake the island of `index` if it is -1.
+  struct IslandOp
+  {
+    int index;
+    int lowerIndex;
+  };
+
+  struct StructDamage
+  {
+    int   index;
+    float damage;
+  };
+
+  Collider           collider;
+  Dynamic*           dyn;
+  Frag*              frag;
+  Vec3               move;
+  Vec3               lastNormals[2];
+
+  // Set for parallel contexts, which defer changes to islands and structures.
+  bool               isDeferred = false;
+  List<IslandOp>     islandOps;
+  List<StructDamage> structDamages;
+
+  List<Body>         bodies;
+  List<Body>         bodyBuffer;
+  List<Body>         serialBodies;
+  List<int>          cellStarts;
+
+  // Islands: objects resting on one another are linked into circular lists by their indices, -1
+  // for objects that are not in any island.
+  static int         islandNext[Orbis::MAX_OBJECTS];
 
 public:
 
-  float    gravity = -9.81f;
+  float              gravity = -9.81f;
 
 private:
 
+  void link(int index, int lowerIndex);
+  void wakeIsland(int index);
+  void damageStruct(Struct* str, float damage);
+  void applyDeferred(Physics* context);
+
+  void simulate(const Body& body);
+
   bool handleObjFriction();
   void handleObjHit();
   Vec3 handleObjMove();
@@ -89,10 +146,42 @@ private:
 
 public:
 
+  /**
+   * Wake an object together with all objects in its island.
+   *
+   * Sleeping objects are not checked each tick whether their supporting object has moved or
+   * disappeared, they must be woken via this function instead. Objects that are woken by clearing
+   * `Object::DISABLED_BIT` directly wake the rest of their island on their next update.
+   */
+  void wake(Dynamic* dyn);
+
   void updateEnt(Entity* ent, const Vec3& localMove);
   void updateObj(Dynamic* dyn);
   void updateFrag(Frag* frag);
 
+  /**
+   * Simulate given positioned objects and fragments, in parallel on job system workers.
+   *
+   * Cells are coloured in a 3x3 pattern, so 3x3 neighbourhoods of cells with the same colour do not
+   * overlap. Colours are processed one after another and cells of one colour in parallel, each
+   * by a single job with its own `Physics` and `Collider` context. Bodies in a cell can only touch
+   * objects in its neighbourhood; changes to islands and structures, which can reach further, are
+   * deferred and applied in cell order after each colour. The outcome is thus independent of the
+   * number of workers. Bodies that move too far to stay within the neighbourhood are simulated
+   * serially afterwards.
+   */
+  void update(const List<int>& objIndices, const List<int>& fragIndices);
+
+  void read(Stream* is);
+  void write(Stream* os) const;
+
+  void load();
+
+  /**
+   * Release parallel contexts and body lists.
+   */
+  void unload();
+
 };
 
 extern Physics physics;
@@ -63,8 +63,8 @@ const Entity::Handler Entity::HANDLERS[] = {
   &Entity::portalHandler
 };
 
-List<Object*> Struct::overlappingObjs;
-Pool<Struct>  Struct::pool;
+List<Object*>          Struct::overlappingObjs;
+ConcurrentPool<Struct> Struct::pool("Struct");
 
 bool Entity::trigger()
 {
@@ -257,7 +257,7 @@ void Struct::onDemolish()
       dyn->destroy();
     }
     else if (dyn->flags & Object::DYNAMIC_BIT) {
-      dyn->flags &= ~Object::DISABLED_BIT;
+      physics.wake(dyn);
       dyn->flags |= Object::ENABLE_BIT;
     }
   }
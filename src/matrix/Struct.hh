@@ -95,8 +95,8 @@ public:
 
 public:
 
-  static List<Object*> overlappingObjs;
-  static Pool<Struct>  pool;
+  static List<Object*>          overlappingObjs;
+  static ConcurrentPool<Struct> pool;
 
 private:
 
@@ -116,8 +116,8 @@ public:
   float        resistance;
   float        demolishing;
 
-  List<Entity> entities;
-  List<int>    boundObjects;
+  SmallList<Entity, 4> entities;
+  SmallList<int, 4>    boundObjects;
 
 private:
 
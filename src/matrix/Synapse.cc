@@ -20,7 +20,7 @@
 #include <matrix/Synapse.hh>
 
 #include <matrix/Liber.hh>
-#include <matrix/Collider.hh>
+#include <matrix/Physics.hh>
 #include <matrix/Bot.hh>
 
 namespace oz
@@ -120,6 +120,8 @@ void Synapse::cut(Dynamic* obj)
 {
   OZ_ASSERT(obj->index != -1 && obj->cell != nullptr && obj->parent != -1);
 
+  physics.wake(obj);
+
   obj->flags   &= ~(Object::TICK_CLEAR_MASK | Object::MOVE_CLEAR_MASK);
   obj->lower    = -1;
   obj->velocity = Vec3::ZERO;
@@ -276,12 +278,12 @@ void Synapse::remove(Struct* str)
 
   removedStructs.add(str->index);
 
-  List<Object*> overlappingObjs;
+  FrameList<Object*> overlappingObjs;
   collider.getOverlaps(str->toAABB(), nullptr, &overlappingObjs, 2.0f * EPSILON);
 
   for (Object* obj : overlappingObjs) {
     if (obj->flags & Object::DYNAMIC_BIT) {
-      obj->flags &= ~Object::DISABLED_BIT;
+      physics.wake(static_cast<Dynamic*>(obj));
       obj->flags |= Object::ENABLE_BIT;
     }
   }
@@ -304,13 +306,17 @@ void Synapse::remove(Object* obj)
 
   removedObjects.add(obj->index);
 
+  if (obj->flags & Object::DYNAMIC_BIT) {
+    physics.wake(static_cast<Dynamic*>(obj));
+  }
+
   if (obj->cell != nullptr) {
-    List<Object*> overlappingObjs;
+    FrameList<Object*> overlappingObjs;
     collider.getOverlaps(*obj, nullptr, &overlappingObjs, 2.0f * EPSILON);
 
     for (Object* sObj : overlappingObjs) {
       if (sObj->flags & Object::DYNAMIC_BIT) {
-        sObj->flags &= ~Object::DISABLED_BIT;
+        physics.wake(static_cast<Dynamic*>(sObj));
         sObj->flags |= Object::ENABLE_BIT;
       }
     }
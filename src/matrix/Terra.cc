@@ -48,7 +48,7 @@ void Terra::load(int id_)
 
     Log::print("Loading terrain '%s' ...", name.c());
 
-    Stream is = file.read(Endian::LITTLE);
+    Stream is = file.map(Endian::LITTLE);
 
     if (is.available() == 0) {
       OZ_ERROR("Cannot read terra file '%s'", file.c());
@@ -66,7 +66,7 @@ private:
 
 public:
 
-  static Pool<Vehicle> pool;
+  static ConcurrentPool<Vehicle> pool;
 
   float h, v, w;
   float rotVelH, rotVelV;
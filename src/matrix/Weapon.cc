@@ -26,7 +26,7 @@
 namespace oz
 {
 
-Pool<Weapon> Weapon::pool(2048);
+ConcurrentPool<Weapon> Weapon::pool("Weapon", 2048);
 
 bool Weapon::onUse(Bot* user)
 {
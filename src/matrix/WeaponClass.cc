@@ -47,12 +47,12 @@ void WeaponClass::init(const Json& config, const char* name_)
     audioSounds[Weapon::EVENT_SHOT]       = liber.soundIndex(sEventShot);
   }
 
-  int dollar = name.index('$');
+  int dollar = String::index(name.c(), '$');
   if (dollar == -1) {
     OZ_ERROR("%s: Weapon name should be of the form botPrefix$weaponName", name_);
   }
 
-  userBase     = name.substring(0, dollar);
+  userBase     = String::substring(name.c(), 0, dollar);
 
   nRounds      = config["nRounds"].get(-1);
   shotInterval = config["shotInterval"].get(0.5f);
@@ -115,7 +115,7 @@ static int ozOrbisAddStr(lua_State* l)
 {
   VARG(5, 7);
 
-  const BSP* bsp = liber.bsp(l_tostring(2));
+  const BSP* bsp = liber.bsp(l_toatom(2));
 
   AddMode mode    = AddMode(l_toint(1));
   Point   p       = Point(l_tofloat(3), l_tofloat(4), l_tofloat(5));
@@ -151,7 +151,7 @@ static int ozOrbisAddObj(lua_State* l)
 {
   VARG(5, 7);
 
-  const ObjectClass* clazz = liber.objClass(l_tostring(2));
+  const ObjectClass* clazz = liber.objClass(l_toatom(2));
 
   AddMode mode    = AddMode(l_toint(1));
   Point   p       = Point(l_tofloat(3), l_tofloat(4), l_tofloat(5));
@@ -188,7 +188,7 @@ static int ozOrbisAddFrag(lua_State* l)
 {
   ARG(8);
 
-  const FragPool* pool = liber.fragPool(l_tostring(2));
+  const FragPool* pool = liber.fragPool(l_toatom(2));
 
   AddMode mode     = AddMode(l_toint(1));
   Point   p        = Point(l_tofloat(3), l_tofloat(4), l_tofloat(5));
@@ -211,7 +211,7 @@ static int ozOrbisGenFrags(lua_State* l)
 {
   ARG(11);
 
-  const FragPool* pool = liber.fragPool(l_tostring(1));
+  const FragPool* pool = liber.fragPool(l_toatom(1));
 
   int    nFrags   = l_toint(2);
   Bounds bb       = Bounds(Point(l_tofloat(3), l_tofloat(4), l_tofloat(5)),
@@ -409,7 +409,7 @@ static int ozBSPDim(lua_State* l)
 {
   ARG(1);
 
-  const BSP* bsp = liber.bsp(l_tostring(1));
+  const BSP* bsp = liber.bsp(l_toatom(1));
   Vec3 dim = bsp->dim();
 
   l_pushfloat(dim.x);
@@ -1135,7 +1135,7 @@ static int ozClassDim(lua_State* l)
 {
   ARG(1);
 
-  const ObjectClass* clazz = liber.objClass(l_tostring(1));
+  const ObjectClass* clazz = liber.objClass(l_toatom(1));
 
   l_pushfloat(clazz->dim.x);
   l_pushfloat(clazz->dim.y);
@@ -1268,6 +1268,10 @@ static int ozObjWarpPos(lua_State* l)
   ms.obj->p.y = l_tofloat(2);
   ms.obj->p.z = l_tofloat(3);
 
+  if (ms.obj->cell != nullptr) {
+    orbis.reposition(ms.obj);
+  }
+
   ms.obj->flags &= ~Object::MOVE_CLEAR_MASK;
   return 0;
 }
@@ -1305,7 +1309,7 @@ static int ozObjGetClassName(lua_State* l)
   ARG(0);
   OBJ();
 
-  l_pushstring(ms.obj->clazz->name);
+  l_pushstring(ms.obj->clazz->name.c());
   return 1;
 }
 
@@ -1818,7 +1822,8 @@ static int ozDynSetMomentum(lua_State* l)
   OBJ();
   OBJ_DYNAMIC();
 
-  dyn->flags     &= ~Object::DISABLED_BIT;
+  physics.wake(dyn);
+
   dyn->momentum.x = l_tofloat(1);
   dyn->momentum.y = l_tofloat(2);
   dyn->momentum.z = l_tofloat(3);
@@ -1831,7 +1836,8 @@ static int ozDynAddMomentum(lua_State* l)
   OBJ();
   OBJ_DYNAMIC();
 
-  dyn->flags      &= ~Object::DISABLED_BIT;
+  physics.wake(dyn);
+
   dyn->momentum.x += l_tofloat(1);
   dyn->momentum.y += l_tofloat(2);
   dyn->momentum.z += l_tofloat(3);
@@ -29,6 +29,8 @@ static LuaNirvana& lua = luaNirvana;
 
 void LuaNirvana::mindCall(const char* functionName, Mind* mind, Bot* self)
 {
+  Alloc::Tag allocTag("lua");
+
   lua_State* l = l_;
 
   OZ_ASSERT(l_gettop() == 1 && mind != nullptr && self != nullptr);
@@ -131,6 +133,7 @@ void LuaNirvana::init()
 
   IMPORT_FUNC(ozError);
   IMPORT_FUNC(ozPrintln);
+  IMPORT_FUNC(ozAtom);
 
   IMPORT_FUNC(ozForceUpdate);
 
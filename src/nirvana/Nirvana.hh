@@ -39,8 +39,8 @@ public:
 
   HashMap<String, Device::CreateFunc*> deviceClasses;
 
-  HashMap<int, Device*> devices;
-  HashMap<int, Mind>    minds;
+  FlatHashMap<int, Device*> devices;
+  FlatHashMap<int, Mind>    minds;
 
   void sync();
   void update();
@@ -130,7 +130,7 @@ static int ozSelfGetClassName(lua_State* l)
 {
   ARG(0);
 
-  l_pushstring(ns.self->clazz->name);
+  l_pushstring(ns.self->clazz->name.c());
   return 1;
 }
 
@@ -382,7 +382,7 @@ static int ozSelfSetWeaponItem(lua_State* l)
     }
 
     const WeaponClass* clazz = static_cast<const WeaponClass*>(weapon->clazz);
-    if (ns.self->clazz->name.beginsWith(clazz->userBase)) {
+    if (String::beginsWith(ns.self->clazz->name.c(), clazz->userBase)) {
       ns.self->weapon = index;
     }
   }
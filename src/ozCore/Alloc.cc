@@ -22,12 +22,20 @@
 
 #include "Alloc.hh"
 
+#include "Arrays.hh"
+#include "File.hh"
 #include "SpinLock.hh"
 
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <malloc.h>
 
+#ifdef __GLIBC__
+# include <execinfo.h>
+#endif
+
 namespace oz
 {
 
@@ -37,10 +45,109 @@ enum AllocMode
   ARRAY
 };
 
+// Call site of sampled allocations, sites are kept in an open-addressing table.
+struct SampleSite
+{
+  uint        hash;
+  const char* tag;
+  int         nFrames;
+  void*       frames[StackTrace::MAX_FRAMES];
+  double      liveBytes;
+  double      liveCount;
+  double      totalBytes;
+  double      totalCount;
+};
+
+static const int               N_SAMPLE_SITES      = 2048;
 static const char* const       ALLOC_MODE_NAMES[2] = {"object", "array"};
 static Chain<Alloc::ChunkInfo> chunkInfos[2];
+static thread_local const char* currentTag         = nullptr;
 #ifdef OZ_ALLOCATOR
 static SpinLock                allocInfoLock;
+static SpinLock                sampleLock;
+static SampleSite              sampleSites[N_SAMPLE_SITES];
+static int                     nSampleSites        = 0;
+static size_t                  sampleInterval      = 0;
+static thread_local long64     bytesUntilSample    = 0;
+static thread_local uint       sampleSeed          = 0;
+
+// Exponentially distributed distance to the next sample, so that each byte is equally likely to
+// be sampled regardless of allocation sizes and patterns.
+static long64 nextSampleDistance(size_t interval)
+{
+  if (sampleSeed == 0) {
+    sampleSeed = uint(size_t(&sampleSeed) >> 4) | 1;
+  }
+
+  sampleSeed ^= sampleSeed << 13;
+  sampleSeed ^= sampleSeed >> 17;
+  sampleSeed ^= sampleSeed << 5;
+
+  double uniform = (double(sampleSeed >> 8) + 0.5) / double(1 << 24);
+  return long64(-log(uniform) * double(interval)) + 1;
+}
+
+// Find or add site for the current stack trace, return its index or -1 if the table is full.
+static int sampleSite(const StackTrace& st, const char* tag)
+{
+  uint hash = uint(Hash<const char*>::EMPTY) ^ uint(size_t(tag));
+
+  for (int i = 0; i < st.nFrames; ++i) {
+    hash = (hash * 16777619) ^ uint(size_t(st.frames[i]) >> 2);
+  }
+
+  for (int i = 0; i < N_SAMPLE_SITES; ++i) {
+    int         index = int((hash + uint(i)) % N_SAMPLE_SITES);
+    SampleSite& site  = sampleSites[index];
+
+    if (site.nFrames == 0) {
+      if (nSampleSites == N_SAMPLE_SITES - 1) {
+        return -1;
+      }
+
+      site.hash    = hash;
+      site.tag     = tag;
+      site.nFrames = max<int>(st.nFrames, 1);
+      memcpy(site.frames, st.frames, size_t(st.nFrames) * sizeof(void*));
+
+      ++nSampleSites;
+      return index;
+    }
+    else if (site.hash == hash && site.tag == tag && site.nFrames == max<int>(st.nFrames, 1) &&
+             memcmp(site.frames, st.frames, size_t(st.nFrames) * sizeof(void*)) == 0)
+    {
+      return index;
+    }
+  }
+  return -1;
+}
+
+static void sampleAllocation(Alloc::ChunkInfo* ci, size_t interval)
+{
+  StackTrace st = StackTrace::current(3);
+
+  // Each sampled byte stands for `interval` bytes on average. Dividing by the probability that an
+  // allocation of this size is sampled gives an unbiased estimate.
+  double size        = double(ci->size) + 1.0;
+  double probability = 1.0 - exp(-size / double(interval));
+  double weight      = size / probability;
+
+  sampleLock.lock();
+
+  int site = sampleSite(st, currentTag);
+
+  if (site >= 0) {
+    sampleSites[site].liveBytes  += weight;
+    sampleSites[site].liveCount  += weight / size;
+    sampleSites[site].totalBytes += weight;
+    sampleSites[site].totalCount += weight / size;
+  }
+
+  sampleLock.unlock();
+
+  ci->site   = site < 0 ? Alloc::UNTRACKED : site;
+  ci->weight = float(weight);
+}
 #endif
 
 static void* allocate(AllocMode mode, size_t size)
@@ -69,9 +176,31 @@ static void* allocate(AllocMode mode, size_t size)
 
 #ifdef OZ_ALLOCATOR
 
-  Alloc::ChunkInfo* ci = new(ptr) Alloc::ChunkInfo();
+  Alloc::ChunkInfo* ci       = new(ptr) Alloc::ChunkInfo();
+  size_t            interval = __atomic_load_n(&sampleInterval, __ATOMIC_RELAXED);
+
+  ci->size = size;
+  ptr      = static_cast<char*>(ptr) + Alloc::alignUp(sizeof(Alloc::ChunkInfo));
+
+  if (interval != 0) {
+    ci->site = Alloc::UNTRACKED;
+
+    bytesUntilSample -= long64(size);
+
+    if (bytesUntilSample <= 0) {
+      bytesUntilSample = nextSampleDistance(interval);
+      sampleAllocation(ci, interval);
+    }
+
+    __atomic_add_fetch(&Alloc::count, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&Alloc::amount, size, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&Alloc::sumCount, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&Alloc::sumAmount, size, __ATOMIC_RELAXED);
+
+    return ptr;
+  }
 
-  ci->size       = size;
+  ci->site       = Alloc::TRACKED;
   ci->stackTrace = StackTrace::current(2);
 
   allocInfoLock.lock();
@@ -89,8 +218,6 @@ static void* allocate(AllocMode mode, size_t size)
 
   allocInfoLock.unlock();
 
-  ptr = static_cast<char*>(ptr) + Alloc::alignUp(sizeof(Alloc::ChunkInfo));
-
 #endif
 
   return ptr;
@@ -104,36 +231,54 @@ static void deallocate(AllocMode mode, void* ptr)
 
   ptr = static_cast<char*>(ptr) - Alloc::alignUp(sizeof(Alloc::ChunkInfo));
 
-  allocInfoLock.lock();
+  Alloc::ChunkInfo* ci = static_cast<Alloc::ChunkInfo*>(ptr);
 
-  Alloc::ChunkInfo* ci   = static_cast<Alloc::ChunkInfo*>(ptr);
-  Alloc::ChunkInfo* prev = chunkInfos[mode].before(ci);
+  if (ci->site != Alloc::TRACKED) {
+    if (ci->site >= 0) {
+      double size = double(ci->size) + 1.0;
 
-  if (prev != nullptr || chunkInfos[mode].first() == ci) {
-    chunkInfos[mode].eraseAfter(ci, prev);
-  }
-  // Check if allocated as a different kind (object/array)
-  else if (chunkInfos[!mode].has(ci)) {
-    OZ_ERROR("oz::Alloc: new[] -> delete mismatch for %s block at %p of size %lu",
-             ALLOC_MODE_NAMES[mode], ptr, ulong(ci->size));
+      sampleLock.lock();
+
+      sampleSites[ci->site].liveBytes -= ci->weight;
+      sampleSites[ci->site].liveCount -= ci->weight / size;
+
+      sampleLock.unlock();
+    }
+
+    __atomic_sub_fetch(&Alloc::count, 1, __ATOMIC_RELAXED);
+    __atomic_sub_fetch(&Alloc::amount, ci->size, __ATOMIC_RELAXED);
   }
   else {
-    OZ_ERROR("oz::Alloc: Freeing unregistered %s block at %p of size %lu",
-             ALLOC_MODE_NAMES[mode], ptr, ulong(ci->size));
+    allocInfoLock.lock();
+
+    Alloc::ChunkInfo* prev = chunkInfos[mode].before(ci);
+
+    if (prev != nullptr || chunkInfos[mode].first() == ci) {
+      chunkInfos[mode].eraseAfter(ci, prev);
+    }
+    // Check if allocated as a different kind (object/array)
+    else if (chunkInfos[!mode].has(ci)) {
+      OZ_ERROR("oz::Alloc: new[] -> delete mismatch for %s block at %p of size %lu",
+               ALLOC_MODE_NAMES[mode], ptr, ulong(ci->size));
+    }
+    else {
+      OZ_ERROR("oz::Alloc: Freeing unregistered %s block at %p of size %lu",
+               ALLOC_MODE_NAMES[mode], ptr, ulong(ci->size));
+    }
+
+    --Alloc::count;
+    Alloc::amount -= ci->size;
+
+    allocInfoLock.unlock();
   }
 
-  --Alloc::count;
-  Alloc::amount -= ci->size;
-
-  allocInfoLock.unlock();
-
   size_t chunkSize = ci->size + Alloc::alignUp(sizeof(Alloc::ChunkInfo));
   memset(ptr, 0xee, chunkSize);
 
 #endif
 
 #if defined(OZ_SIMD) && defined(_WIN32)
-  _aligned_free(ptr));
+  _aligned_free(ptr);
 #else
   free(ptr);
 #endif
@@ -156,6 +301,146 @@ Alloc::CIterator Alloc::arrayCIter()
   return chunkInfos[ARRAY].citerator();
 }
 
+Alloc::Tag::Tag(const char* name)
+  : previous_(currentTag)
+{
+  currentTag = name;
+}
+
+Alloc::Tag::~Tag()
+{
+  currentTag = previous_;
+}
+
+void Alloc::setSampleInterval(size_t interval)
+{
+#ifdef OZ_ALLOCATOR
+  __atomic_store_n(&oz::sampleInterval, interval, __ATOMIC_RELAXED);
+#else
+  static_cast<void>(interval);
+#endif
+}
+
+size_t Alloc::sampleInterval()
+{
+#ifdef OZ_ALLOCATOR
+  return __atomic_load_n(&oz::sampleInterval, __ATOMIC_RELAXED);
+#else
+  return 0;
+#endif
+}
+
+bool Alloc::exportSamples(const File& file)
+{
+  struct SiteOrder
+  {
+    double liveBytes;
+    int    index;
+
+    bool operator<(const SiteOrder& other) const
+    {
+      return liveBytes > other.liveBytes;
+    }
+  };
+
+  // Copy sites first, formatting allocates and might sample.
+  SampleSite* sites  = static_cast<SampleSite*>(malloc(sizeof(SampleSite) * N_SAMPLE_SITES));
+  SiteOrder*  order  = static_cast<SiteOrder*>(malloc(sizeof(SiteOrder) * N_SAMPLE_SITES));
+  int         nSites = 0;
+  size_t      interval = sampleInterval();
+
+  if (sites == nullptr || order == nullptr) {
+    free(sites);
+    free(order);
+    return false;
+  }
+
+#ifdef OZ_ALLOCATOR
+  sampleLock.lock();
+  memcpy(sites, sampleSites, sizeof(SampleSite) * N_SAMPLE_SITES);
+  sampleLock.unlock();
+#else
+  memset(sites, 0, sizeof(SampleSite) * N_SAMPLE_SITES);
+#endif
+
+  // Sites cleared by `clearSamples()` keep their frames for live chunks but have no samples.
+  for (int i = 0; i < N_SAMPLE_SITES; ++i) {
+    if (sites[i].nFrames != 0 && sites[i].totalCount != 0.0) {
+      order[nSites++] = {sites[i].liveBytes, i};
+    }
+  }
+  Arrays::sort(order, nSites);
+
+  Stream os(0);
+  char   buffer[256];
+
+  snprintf(buffer, sizeof(buffer), "{\n  \"sampleInterval\": %llu,\n  \"sites\": [",
+           ulong64(interval));
+  os.write(buffer, int(strlen(buffer)));
+
+  for (int i = 0; i < nSites; ++i) {
+    const SampleSite& site = sites[order[i].index];
+
+    snprintf(buffer, sizeof(buffer),
+             "%s\n    {\"tag\": \"%s\", \"liveBytes\": %.0f, \"liveCount\": %.1f, "
+             "\"totalBytes\": %.0f, \"totalCount\": %.1f, \"frames\": [",
+             i == 0 ? "" : ",", site.tag == nullptr ? "" : site.tag, max(site.liveBytes, 0.0),
+             max(site.liveCount, 0.0), site.totalBytes, site.totalCount);
+    os.write(buffer, int(strlen(buffer)));
+
+#ifdef __GLIBC__
+    char** symbols = backtrace_symbols(site.frames, site.nFrames);
+#else
+    char** symbols = nullptr;
+#endif
+
+    for (int j = 0; j < site.nFrames; ++j) {
+      if (symbols == nullptr) {
+        snprintf(buffer, sizeof(buffer), "%s\"%p\"", j == 0 ? "" : ", ", site.frames[j]);
+        os.write(buffer, int(strlen(buffer)));
+      }
+      else {
+        os.write(j == 0 ? "\"" : ", \"", j == 0 ? 1 : 3);
+
+        for (const char* s = symbols[j]; *s != '\0'; ++s) {
+          if (*s == '"' || *s == '\\') {
+            os.writeChar('\\');
+          }
+          os.writeChar(*s);
+        }
+        os.writeChar('"');
+      }
+    }
+    os.write("]}", 2);
+
+    free(symbols);
+  }
+
+  os.writeLine("\n  ]\n}");
+
+  free(sites);
+  free(order);
+
+  return file.write(os);
+}
+
+void Alloc::clearSamples()
+{
+#ifdef OZ_ALLOCATOR
+  sampleLock.lock();
+
+  // Live chunks still refer to their sites, so only zero statistics.
+  for (int i = 0; i < N_SAMPLE_SITES; ++i) {
+    sampleSites[i].liveBytes  = 0.0;
+    sampleSites[i].liveCount  = 0.0;
+    sampleSites[i].totalBytes = 0.0;
+    sampleSites[i].totalCount = 0.0;
+  }
+
+  sampleLock.unlock();
+#endif
+}
+
 }
 
 OZ_WEAK
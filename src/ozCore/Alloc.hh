@@ -31,6 +31,9 @@
  *   with 0xee bytes and track memory statistics and allocated chunks to catch any memory leaks and
  *   `new`/`delete` mismatches. `Alloc::objectCIter()` and `Alloc::arrayCIter()` can be used to
  *   iterate over the chunks currently allocated by `new` and `new[]` operator respectively.
+ * - In `OZ_ALLOCATOR` builds, `Alloc::setSampleInterval()` switches from tracking every chunk to
+ *   sampling roughly one allocation per given number of bytes. Sampled allocations are aggregated
+ *   per call site and subsystem tag and can be exported via `Alloc::exportSamples()`.
  * - If compiled with `OZ_SIMD` the allocated chunks are aligned to 16 bytes.
  *
  * @note
@@ -46,6 +49,8 @@
 namespace oz
 {
 
+class File;
+
 /**
  * Auxiliary class for custom `new`/`delete` operators.
  *
@@ -64,7 +69,45 @@ public:
   struct ChunkInfo : ChainNode<ChunkInfo>
   {
     size_t     size;       ///< Size (including meta data).
-    StackTrace stackTrace; ///< Stack trace for the `new` call that allocated it.
+    int        site;       ///< Sampled call site, `TRACKED` or `UNTRACKED`.
+    float      weight;     ///< Number of bytes the sample represents if sampled.
+    StackTrace stackTrace; ///< Stack trace for the `new` call that allocated it (if tracked).
+  };
+
+  /**
+   * Scoped subsystem tag for allocations sampled on the current thread.
+   *
+   * Tags nest, the innermost one is used. Tag names must be string literals or otherwise outlive
+   * the allocator, only pointers are stored.
+   */
+  class Tag
+  {
+  private:
+
+    const char* previous_; ///< Tag that was active before this one.
+
+  public:
+
+    /**
+     * Activate a tag.
+     */
+    explicit Tag(const char* name);
+
+    /**
+     * Restore the previous tag.
+     */
+    ~Tag();
+
+    /**
+     * No copying or moving.
+     */
+    Tag(const Tag&) = delete;
+
+    /**
+     * No copying or moving.
+     */
+    Tag& operator=(const Tag&) = delete;
+
   };
 
   /**
@@ -74,6 +117,9 @@ public:
 
 public:
 
+  static const int TRACKED   = -1; ///< `ChunkInfo::site` for chunks in object/array lists.
+  static const int UNTRACKED = -2; ///< `ChunkInfo::site` for chunks that were not sampled.
+
   static int    count;     ///< Current number of allocated memory chunks.
   static size_t amount;    ///< Amount of currently allocated memory.
 
@@ -81,7 +127,7 @@ public:
   static size_t sumAmount; ///< Cumulative amount of all memory allocations.
 
   static int    maxCount;  ///< Top number to memory allocations.
-  static size_t maxAmount; ///< Top amount of allocated memory.
+  static size_t maxAmount; ///< Top amount of allocated memory (only updated when not sampling).
 
 public:
 
@@ -100,6 +146,33 @@ public:
    */
   static CIterator arrayCIter();
 
+  /**
+   * Sample roughly one allocation per `interval` bytes instead of tracking every chunk.
+   *
+   * Sampling avoids the global lock and stack trace capture on all but the sampled allocations.
+   * Leak detection via `objectCIter()` and `arrayCIter()` only covers chunks allocated while not
+   * sampling. Zero switches back to full tracking. Has no effect without `OZ_ALLOCATOR`.
+   */
+  static void setSampleInterval(size_t interval);
+
+  /**
+   * Current sampling interval in bytes, 0 if sampling is off.
+   */
+  static size_t sampleInterval();
+
+  /**
+   * Write sampled heap profile into a file in JSON format.
+   *
+   * Each call site has estimated live and cumulative bytes and allocation counts, its subsystem
+   * tag and symbolised stack frames. Sites are sorted by estimated live bytes.
+   */
+  static bool exportSamples(const File& file);
+
+  /**
+   * Reset statistics of sampled call sites.
+   */
+  static void clearSamples();
+
   /**
    * Align to the previous boundary.
    */
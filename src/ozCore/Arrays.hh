@@ -129,63 +129,167 @@ public:
 
 private:
 
+  /// Partitions of at most that many elements are finished by insertion sort.
+  static const int INSERTION_SORT_THRESHOLD = 16;
+
+  /**
+   * Helper function for `sort()`, insertion sort for short partitions.
+   *
+   * @param first pointer to the first element in the range.
+   * @param past pointer past the last element in the range.
+   */
+  template <typename Elem, class LessFunc>
+  static void insertionSort(Elem* first, Elem* past)
+  {
+    for (Elem* i = first + 1; i < past; ++i) {
+      if (LessFunc()(*i, *(i - 1))) {
+        Elem  value = static_cast<Elem&&>(*i);
+        Elem* j     = i;
+
+        do {
+          *j = static_cast<Elem&&>(*(j - 1));
+          --j;
+        }
+        while (j != first && LessFunc()(value, *(j - 1)));
+
+        *j = static_cast<Elem&&>(value);
+      }
+    }
+  }
+
+  /**
+   * Helper function for `heapSort()`, move the element at position `i` down the max-heap.
+   */
+  template <typename Elem, class LessFunc>
+  static void siftDown(Elem* first, int i, int size)
+  {
+    for (int child = 2*i + 1; child < size; i = child, child = 2*i + 1) {
+      if (child + 1 < size && LessFunc()(first[child], first[child + 1])) {
+        ++child;
+      }
+      if (!LessFunc()(first[i], first[child])) {
+        break;
+      }
+      swap<Elem>(first[i], first[child]);
+    }
+  }
+
+  /**
+   * Helper function for `sort()`, heapsort used as a fallback when introsort recursion degrades.
+   */
+  template <typename Elem, class LessFunc>
+  static void heapSort(Elem* first, Elem* past)
+  {
+    int size = int(past - first);
+
+    for (int i = size / 2 - 1; i >= 0; --i) {
+      siftDown<Elem, LessFunc>(first, i, size);
+    }
+    for (int i = size - 1; i > 0; --i) {
+      swap<Elem>(first[0], first[i]);
+      siftDown<Elem, LessFunc>(first, 0, i);
+    }
+  }
+
+  /**
+   * Helper function for `sort()`, move median of `*a`, `*b` and `*c` to `*result`.
+   */
+  template <typename Elem, class LessFunc>
+  static void moveMedianToFirst(Elem* result, Elem* a, Elem* b, Elem* c)
+  {
+    Elem* median;
+
+    if (LessFunc()(*a, *b)) {
+      median = LessFunc()(*b, *c) ? b : LessFunc()(*a, *c) ? c : a;
+    }
+    else {
+      median = LessFunc()(*a, *c) ? a : LessFunc()(*b, *c) ? c : b;
+    }
+    swap<Elem>(*result, *median);
+  }
+
   /**
    * Helper function for `sort()`.
    *
    * @note
    * `Elem` type must have `operator<(const Elem&)` defined.
    *
-   * Quicksort algorithm is used which takes last element in a partition as a pivot so sorting a
-   * sorted or nearly sorted array will take O(n^2) time instead of O(n log n) as in average case.
-   * When a partition has at most 11 elements, selection sort is used.
+   * Introsort algorithm is used. Pivot is a median of the second, the middle and the last element
+   * in a partition and is moved to the partition's head, so sorted, reverse sorted and nearly
+   * sorted arrays take O(n log n) time. When recursion depth exceeds `depthLimit` the remaining
+   * partition is sorted with heapsort and partitions with at most `INSERTION_SORT_THRESHOLD`
+   * elements are finished by insertion sort.
    *
    * @param first pointer to first element in the array to be sorted.
-   * @param last pointer to last element in the array.
+   * @param past pointer past the last element in the array.
+   * @param depthLimit number of partitioning levels allowed before switching to heapsort.
    */
   template <typename Elem, class LessFunc = Less<Elem>>
-  static void quicksort(Elem* first, Elem* last)
+  static void introsort(Elem* first, Elem* past, int depthLimit)
   {
-    // 8-14 seem as optimal thresholds for switching to selection sort.
-    if (last - first > 11) {
-      // Quicksort (the last element is the pivot).
-      Elem* top    = first;
-      Elem* bottom = last - 1;
+    while (past - first > INSERTION_SORT_THRESHOLD) {
+      if (depthLimit == 0) {
+        heapSort<Elem, LessFunc>(first, past);
+        return;
+      }
+      --depthLimit;
+
+      moveMedianToFirst<Elem, LessFunc>(first, first + 1, first + (past - first) / 2, past - 1);
+
+      // Hoare partition around `*first`. Median-of-three guarantees both scans stop in bounds.
+      Elem* top    = first + 1;
+      Elem* bottom = past;
 
       do {
-        for (; !LessFunc()(*last, *top) && top <= bottom; ++top);
-        for (; LessFunc()(*last, *bottom) && top < bottom; --bottom);
+        for (; LessFunc()(*top, *first); ++top);
+        for (--bottom; LessFunc()(*first, *bottom); --bottom);
 
         if (top >= bottom) {
           break;
         }
 
         swap<Elem>(*top, *bottom);
+        ++top;
       }
       while (true);
 
-      if (top != last) {
-        swap<Elem>(*top, *last);
-        quicksort<Elem, LessFunc>(top + 1, last);
-      }
-      quicksort<Elem, LessFunc>(first, top - 1);
-    }
-    else {
-      // Selection sort.
-      for (Elem* i = first; i < last;) {
-        Elem* pivot = i;
-        Elem* min   = i;
-        ++i;
-
-        for (Elem* j = i; j <= last; ++j) {
-          if (LessFunc()(*j, *min)) {
-            min = j;
-          }
-        }
-        if (min != pivot) {
-          swap<Elem>(*min, *pivot);
-        }
-      }
+      introsort<Elem, LessFunc>(top, past, depthLimit);
+      past = top;
     }
+
+    insertionSort<Elem, LessFunc>(first, past);
+  }
+
+  /**
+   * Map a radix sort key to an unsigned integer with the same ordering.
+   */
+  OZ_ALWAYS_INLINE
+  static uint radixKey(uint key)
+  {
+    return key;
+  }
+
+  /**
+   * Map a radix sort key to an unsigned integer with the same ordering.
+   */
+  OZ_ALWAYS_INLINE
+  static uint radixKey(int key)
+  {
+    return uint(key) ^ 0x80000000u;
+  }
+
+  /**
+   * Map a radix sort key to an unsigned integer with the same ordering.
+   *
+   * Negative floats have all bits flipped, positive ones only the sign bit, so -0.0 precedes 0.0.
+   */
+  OZ_ALWAYS_INLINE
+  static uint radixKey(float key)
+  {
+    uint bits;
+    __builtin_memcpy(&bits, &key, sizeof(bits));
+
+    return bits & 0x80000000u ? ~bits : bits | 0x80000000u;
   }
 
 public:
@@ -381,15 +485,71 @@ public:
   }
 
   /**
-   * Sort array using `detail::quicksort()`.
+   * Sort array using introsort (see `introsort()`), O(n log n) in the worst case, not stable.
    */
   template <typename Elem, class LessFunc = Less<Elem>>
   static void sort(Elem* array, int size)
   {
-    int last = size - 1;
+    if (size > 1) {
+      introsort<Elem, LessFunc>(array, array + size, 2 * (31 - __builtin_clz(uint(size))));
+    }
+  }
+
+  /**
+   * Stable LSD radix sort by a key extracted from each element.
+   *
+   * `KeyFunc` is a function object that returns an `int`, `uint` or `float` key for an element.
+   * Elements are distributed in 4 passes over 8-bit digits and a pass is skipped when all keys
+   * share its digit, so the sort runs in O(n) time. Buffer is a caller-supplied scratch array of
+   * at least `size` elements, which avoids allocations when sorting every frame.
+   */
+  template <typename Elem, class KeyFunc>
+  static void radixSort(Elem* array, int size, Elem* buffer)
+  {
+    if (size < 2) {
+      return;
+    }
+
+    int counts[4][256] = {};
+
+    for (int i = 0; i < size; ++i) {
+      uint key = radixKey(KeyFunc()(array[i]));
+
+      ++counts[0][key & 0xff];
+      ++counts[1][key >> 8 & 0xff];
+      ++counts[2][key >> 16 & 0xff];
+      ++counts[3][key >> 24];
+    }
+
+    Elem* src  = array;
+    Elem* dest = buffer;
+
+    for (int pass = 0; pass < 4; ++pass) {
+      int* count = counts[pass];
+      int  shift = pass * 8;
+
+      if (count[radixKey(KeyFunc()(src[0])) >> shift & 0xff] == size) {
+        continue;
+      }
+
+      for (int digit = 0, offset = 0; digit < 256; ++digit) {
+        int digitCount = count[digit];
+
+        count[digit] = offset;
+        offset += digitCount;
+      }
+
+      for (int i = 0; i < size; ++i) {
+        uint digit = radixKey(KeyFunc()(src[i])) >> shift & 0xff;
+
+        dest[count[digit]++] = static_cast<Elem&&>(src[i]);
+      }
+
+      swap<Elem*>(src, dest);
+    }
 
-    if (last > 0) {
-      quicksort<Elem, LessFunc>(array, &array[last]);
+    if (src != array) {
+      move<Elem>(src, size, array);
     }
   }
 
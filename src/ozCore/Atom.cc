@@ -0,0 +1,124 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file ozCore/Atom.cc
+ */
+
+#include "Atom.hh"
+
+#include "Alloc.hh"
+#include "SpinLock.hh"
+
+namespace oz
+{
+
+static const int N_BUCKETS  = 4096;
+static const int CHUNK_SIZE = 64 * 1024;
+
+// Bucket heads are published with release stores, so lookups walk chains without locking.
+static Atomic<const void*> buckets[N_BUCKETS];
+static SpinLock            insertLock;
+static char*               chunk;
+static int                 chunkLeft;
+static int                 nAtoms;
+
+const Atom Atom::EMPTY;
+
+const char* Atom::intern(const char* s, int length, bool doInsert)
+{
+  if (length == 0) {
+    return nullptr;
+  }
+
+  // Same as Hash<const char*>, but bounded by length.
+  uint hash = uint(Hash<const char*>::EMPTY);
+  for (int i = 0; i < length; ++i) {
+    hash = (hash * 16777619) ^ int(s[i]);
+  }
+
+  Atomic<const void*>& bucket = buckets[hash % N_BUCKETS];
+  const Entry*         head   = static_cast<const Entry*>(bucket.load<ATOMIC_ACQUIRE>());
+  const Entry*         last   = nullptr;
+
+  for (int pass = 0; pass < 2; ++pass) {
+    for (const Entry* entry = head; entry != last; entry = entry->next) {
+      const char* str = reinterpret_cast<const char*>(entry + 1);
+
+      if (entry->hash == int(hash) && entry->length == length &&
+          __builtin_memcmp(str, s, size_t(length)) == 0)
+      {
+        if (pass != 0) {
+          insertLock.unlock();
+        }
+        return str;
+      }
+    }
+
+    if (!doInsert) {
+      return nullptr;
+    }
+    else if (pass == 0) {
+      // Only entries added meanwhile need to be checked again under the lock.
+      insertLock.lock();
+
+      last = head;
+      head = static_cast<const Entry*>(bucket.load<ATOMIC_RELAXED>());
+    }
+  }
+
+  int size = int(Alloc::alignUp<size_t>(sizeof(Entry) + size_t(length) + 1));
+
+  if (size > chunkLeft) {
+    int newChunkSize = max<int>(size, CHUNK_SIZE);
+
+    chunk     = new char[newChunkSize];
+    chunkLeft = newChunkSize;
+  }
+
+  Entry* entry = new(chunk) Entry{static_cast<const Entry*>(bucket.load<ATOMIC_RELAXED>()),
+                                  int(hash), length};
+  char*  str   = reinterpret_cast<char*>(entry + 1);
+
+  __builtin_memcpy(str, s, size_t(length));
+  str[length] = '\0';
+
+  chunk     += size;
+  chunkLeft -= size;
+
+  ++nAtoms;
+  bucket.store<ATOMIC_RELEASE>(entry);
+
+  insertLock.unlock();
+  return str;
+}
+
+int Atom::count()
+{
+  insertLock.lock();
+  int value = nAtoms;
+  insertLock.unlock();
+
+  return value;
+}
+
+}
@@ -0,0 +1,240 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file ozCore/Atom.hh
+ *
+ * `Atom` class.
+ */
+
+#pragma once
+
+#include "String.hh"
+
+namespace oz
+{
+
+/**
+ * Interned immutable string.
+ *
+ * All atoms with the same contents share a single copy of the string in a process-wide intern
+ * table, so atoms are compared by pointer and hashed by a precomputed string hash. Interned
+ * strings are never freed.
+ *
+ * Creating an atom from a string takes a hash table lookup, which is lock-free for strings that
+ * are already interned. Copying, comparing and hashing atoms is as cheap as for integers, so
+ * atoms are meant to replace strings as keys of frequently searched tables. The table is
+ * thread-safe.
+ */
+class Atom
+{
+public:
+
+  /**
+   * Empty atom.
+   */
+  static const Atom EMPTY;
+
+private:
+
+  /**
+   * Header of an interned string, the string itself follows it in memory.
+   */
+  struct Entry
+  {
+    const Entry* next;   ///< Next entry in the hash table bucket.
+    int          hash;   ///< %Hash of the string.
+    int          length; ///< String length.
+  };
+
+  const char* str_ = nullptr; ///< Interned string, `nullptr` for an empty atom.
+
+private:
+
+  /**
+   * Look up a string in the intern table and optionally add it if it is missing.
+   */
+  static const char* intern(const char* s, int length, bool doInsert);
+
+  /**
+   * Entry header that is stored just before the interned string.
+   */
+  OZ_ALWAYS_INLINE
+  const Entry* entry() const
+  {
+    return reinterpret_cast<const Entry*>(str_) - 1;
+  }
+
+public:
+
+  /**
+   * Create an empty atom.
+   */
+  Atom() = default;
+
+  /**
+   * Intern a given string of a given length.
+   */
+  explicit Atom(const char* s, int length)
+    : str_(intern(s, length, true))
+  {}
+
+  /**
+   * Intern a given C string.
+   */
+  explicit Atom(const char* s)
+    : Atom(s, String::length(s))
+  {}
+
+  /**
+   * Intern a given string.
+   */
+  explicit Atom(const String& s)
+    : Atom(s.c(), s.length())
+  {}
+
+  /**
+   * Return an existing atom for a given string or an empty atom if the string is not interned.
+   *
+   * Unlike constructors, this function never adds new strings to the table.
+   */
+  static Atom find(const char* s)
+  {
+    Atom atom;
+    atom.str_ = intern(s, String::length(s), false);
+    return atom;
+  }
+
+  /**
+   * Recreate an atom from a handle returned by `handle()`.
+   */
+  OZ_ALWAYS_INLINE
+  static Atom fromHandle(const void* handle)
+  {
+    Atom atom;
+    atom.str_ = static_cast<const char*>(handle);
+    return atom;
+  }
+
+  /**
+   * Opaque handle for passing an atom through C interfaces, e.g. as a Lua light userdata.
+   */
+  OZ_ALWAYS_INLINE
+  const void* handle() const
+  {
+    return str_;
+  }
+
+  /**
+   * Equality.
+   */
+  OZ_ALWAYS_INLINE
+  bool operator==(const Atom& other) const
+  {
+    return str_ == other.str_;
+  }
+
+  /**
+   * Inequality.
+   */
+  OZ_ALWAYS_INLINE
+  bool operator!=(const Atom& other) const
+  {
+    return str_ != other.str_;
+  }
+
+  /**
+   * True iff the atom is empty.
+   */
+  OZ_ALWAYS_INLINE
+  bool isEmpty() const
+  {
+    return str_ == nullptr;
+  }
+
+  /**
+   * Interned C string, "" for an empty atom.
+   */
+  OZ_ALWAYS_INLINE
+  const char* c() const
+  {
+    return str_ == nullptr ? "" : str_;
+  }
+
+  /**
+   * String length.
+   */
+  OZ_ALWAYS_INLINE
+  int length() const
+  {
+    return str_ == nullptr ? 0 : entry()->length;
+  }
+
+  /**
+   * %Hash of the string, same as `Hash<const char*>` gives.
+   */
+  OZ_ALWAYS_INLINE
+  int hash() const
+  {
+    return str_ == nullptr ? Hash<const char*>::EMPTY : entry()->hash;
+  }
+
+  /**
+   * Number of interned strings.
+   */
+  static int count();
+
+};
+
+/**
+ * `Less` function object for atoms compares strings, so sorted containers are ordered by name.
+ */
+template <>
+struct Less<Atom>
+{
+  /**
+   * Compare using `strcmp`.
+   */
+  OZ_ALWAYS_INLINE
+  bool operator()(const Atom& a, const Atom& b) const
+  {
+    return __builtin_strcmp(a.c(), b.c()) < 0;
+  }
+};
+
+/**
+ * `Hash` function object for atoms returns the precomputed string hash.
+ */
+template <>
+struct Hash<Atom>
+{
+  /**
+   * Return `Atom::hash()`.
+   */
+  OZ_ALWAYS_INLINE
+  int operator()(const Atom& atom) const
+  {
+    return atom.hash();
+  }
+};
+
+}
@@ -150,6 +150,24 @@ public:
     return __atomic_exchange_n(&value, desired, MEMORY_ORDER);
   }
 
+  /**
+   * Atomically replace the value with `desired` if it equals `expected`.
+   *
+   * Same as `std::atomic::compare_exchange_weak()`. On failure, `expected` is updated to the
+   * current value.
+   */
+  template <MemoryOrder SUCCESS_ORDER, MemoryOrder FAILURE_ORDER = ATOMIC_RELAXED>
+  bool compareExchange(Type& expected, Type desired)
+  {
+    static_assert(FAILURE_ORDER == ATOMIC_RELAXED ||
+                  FAILURE_ORDER == ATOMIC_ACQUIRE ||
+                  FAILURE_ORDER == ATOMIC_SEQ_CST,
+                  "Unsupported memory order");
+
+    return __atomic_compare_exchange_n(&value, &expected, desired, true, SUCCESS_ORDER,
+                                       FAILURE_ORDER);
+  }
+
   /**
    * Atomically perfrom bitwise AND and return the previous value.
    *
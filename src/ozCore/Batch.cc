@@ -0,0 +1,275 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "Batch.hh"
+
+#include <cstring>
+
+#if defined(__AVX__)
+# define OZ_BATCH_WIDTH 8
+#elif defined(__SSE2__) || defined(__ARM_NEON__) || defined(__ARM_NEON)
+# define OZ_BATCH_WIDTH 4
+#else
+# define OZ_BATCH_WIDTH 1
+#endif
+
+namespace oz
+{
+
+typedef float __attribute__((vector_size(OZ_BATCH_WIDTH * sizeof(float)))) floatN;
+typedef int   __attribute__((vector_size(OZ_BATCH_WIDTH * sizeof(int))))   intN;
+typedef float __attribute__((vector_size(sizeof(float))))                  float1;
+typedef int   __attribute__((vector_size(sizeof(int))))                    int1;
+
+/**
+ * Vector types and helpers. Kernels are instantiated for `OZ_BATCH_WIDTH` lanes for the bulk of the
+ * data and for a single lane for the remainder.
+ */
+template <typename FloatType, typename IntType>
+struct Lanes
+{
+  typedef FloatType Float;
+  typedef IntType   Int;
+
+  static const int N = int(sizeof(Float) / sizeof(float));
+
+  OZ_ALWAYS_INLINE
+  static Float load(const float* data)
+  {
+    Float v;
+    memcpy(&v, data, sizeof(v));
+    return v;
+  }
+
+  OZ_ALWAYS_INLINE
+  static void store(float* data, Float v)
+  {
+    memcpy(data, &v, sizeof(v));
+  }
+
+  OZ_ALWAYS_INLINE
+  static Float fill(float x)
+  {
+    return Float{} + x;
+  }
+
+  OZ_ALWAYS_INLINE
+  static Float select(Int mask, Float a, Float b)
+  {
+    return Float((mask & Int(a)) | (~mask & Int(b)));
+  }
+
+  OZ_ALWAYS_INLINE
+  static Float abs(Float a)
+  {
+    return Float(Int(a) & 0x7fffffff);
+  }
+
+  OZ_ALWAYS_INLINE
+  static Float min(Float a, Float b)
+  {
+    return select(a < b, a, b);
+  }
+
+  OZ_ALWAYS_INLINE
+  static Float max(Float a, Float b)
+  {
+    return select(a > b, a, b);
+  }
+
+  /**
+   * Append indices of set lanes to the index array without branching.
+   */
+  OZ_ALWAYS_INLINE
+  static int compact(Int mask, int first, int* indices, int n)
+  {
+    for (int k = 0; k < N; ++k) {
+      indices[n] = first + k;
+      n += mask[k] & 1;
+    }
+    return n;
+  }
+};
+
+typedef Lanes<floatN, intN> WideLanes;
+typedef Lanes<float1, int1> SingleLane;
+
+template <class L>
+static int spheresInPlanes(int* i, int count, const Batch::Coords& centres, const float* radii,
+                           const Plane* planes, int nPlanes, int* indices, int n)
+{
+  for (; *i + L::N <= count; *i += L::N) {
+    typename L::Float x      = L::load(centres.x + *i);
+    typename L::Float y      = L::load(centres.y + *i);
+    typename L::Float z      = L::load(centres.z + *i);
+    typename L::Float radius = L::load(radii + *i);
+    typename L::Int   mask   = typename L::Int{} - 1;
+
+    for (int j = 0; j < nPlanes; ++j) {
+      const Plane& plane = planes[j];
+
+      typename L::Float distance = x * plane.n.x + y * plane.n.y + z * plane.n.z - plane.d;
+      mask &= distance > -radius;
+    }
+
+    n = L::compact(mask, *i, indices, n);
+  }
+  return n;
+}
+
+template <class L>
+static int boxesOverlapBox(int* i, int count, const Batch::Coords& centres,
+                           const Batch::Coords& dims, const Point& p, const Vec3& dim, int* indices,
+                           int n)
+{
+  for (; *i + L::N <= count; *i += L::N) {
+    typename L::Float dx = L::abs(L::load(centres.x + *i) - p.x) - L::load(dims.x + *i);
+    typename L::Float dy = L::abs(L::load(centres.y + *i) - p.y) - L::load(dims.y + *i);
+    typename L::Float dz = L::abs(L::load(centres.z + *i) - p.z) - L::load(dims.z + *i);
+
+    n = L::compact((dx <= dim.x) & (dy <= dim.y) & (dz <= dim.z), *i, indices, n);
+  }
+  return n;
+}
+
+template <class L>
+static void boxPlaneDistances(int* i, int count, const Batch::Coords& normals,
+                              const float* offsets, const Point& p, const Vec3& dim,
+                              float* distances)
+{
+  for (; *i + L::N <= count; *i += L::N) {
+    typename L::Float nx = L::load(normals.x + *i);
+    typename L::Float ny = L::load(normals.y + *i);
+    typename L::Float nz = L::load(normals.z + *i);
+
+    typename L::Float centre = nx * p.x + ny * p.y + nz * p.z - L::load(offsets + *i);
+    typename L::Float extent = L::abs(nx) * dim.x + L::abs(ny) * dim.y + L::abs(nz) * dim.z;
+
+    L::store(distances + *i, centre - extent);
+  }
+}
+
+template <class L>
+static void transformPoints(int* i, int count, const Mat4& tf, const Batch::Coords& points,
+                            float* outX, float* outY, float* outZ)
+{
+  for (; *i + L::N <= count; *i += L::N) {
+    typename L::Float x = L::load(points.x + *i);
+    typename L::Float y = L::load(points.y + *i);
+    typename L::Float z = L::load(points.z + *i);
+
+    L::store(outX + *i, tf.x.x * x + tf.y.x * y + tf.z.x * z + tf.w.x);
+    L::store(outY + *i, tf.x.y * x + tf.y.y * y + tf.z.y * z + tf.w.y);
+    L::store(outZ + *i, tf.x.z * x + tf.y.z * y + tf.z.z * z + tf.w.z);
+  }
+}
+
+/**
+ * Clip [`*near`, `*far`] range of ray ratios by a slab along one axis.
+ */
+template <class L>
+OZ_ALWAYS_INLINE
+static inline void clipSlab(typename L::Float origin, typename L::Float move,
+                            typename L::Float centre, typename L::Float dim,
+                            typename L::Float* near, typename L::Float* far)
+{
+  // Near-parallel moves are replaced by tiny ones so that the ratios become huge but not NaN.
+  move = L::select(L::abs(move) < 1e-20f, L::fill(1e-20f), move);
+
+  typename L::Float invMove = 1.0f / move;
+  typename L::Float t0      = (centre - dim - origin) * invMove;
+  typename L::Float t1      = (centre + dim - origin) * invMove;
+
+  *near = L::max(*near, L::min(t0, t1));
+  *far  = L::min(*far, L::max(t0, t1));
+}
+
+template <class L>
+static int raysHitBoxes(int* i, int count, const Batch::Coords& origins, const Batch::Coords& moves,
+                        const Batch::Coords& centres, const Batch::Coords& dims, float* ratios,
+                        int n)
+{
+  for (; *i + L::N <= count; *i += L::N) {
+    typename L::Float near = L::fill(0.0f);
+    typename L::Float far  = L::fill(1.0f);
+
+    clipSlab<L>(L::load(origins.x + *i), L::load(moves.x + *i), L::load(centres.x + *i),
+                L::load(dims.x + *i), &near, &far);
+    clipSlab<L>(L::load(origins.y + *i), L::load(moves.y + *i), L::load(centres.y + *i),
+                L::load(dims.y + *i), &near, &far);
+    clipSlab<L>(L::load(origins.z + *i), L::load(moves.z + *i), L::load(centres.z + *i),
+                L::load(dims.z + *i), &near, &far);
+
+    typename L::Int hit = near <= far;
+
+    L::store(ratios + *i, L::select(hit, near, L::fill(1.0f)));
+
+    for (int k = 0; k < L::N; ++k) {
+      n += hit[k] & 1;
+    }
+  }
+  return n;
+}
+
+const int Batch::WIDTH = OZ_BATCH_WIDTH;
+
+int Batch::spheresInPlanes(const Coords& centres, const float* radii, int count,
+                           const Plane* planes, int nPlanes, int* indices)
+{
+  int i = 0;
+  int n = oz::spheresInPlanes<WideLanes>(&i, count, centres, radii, planes, nPlanes, indices, 0);
+  return oz::spheresInPlanes<SingleLane>(&i, count, centres, radii, planes, nPlanes, indices, n);
+}
+
+int Batch::boxesOverlapBox(const Coords& centres, const Coords& dims, int count, const Point& p,
+                           const Vec3& dim, int* indices)
+{
+  int i = 0;
+  int n = oz::boxesOverlapBox<WideLanes>(&i, count, centres, dims, p, dim, indices, 0);
+  return oz::boxesOverlapBox<SingleLane>(&i, count, centres, dims, p, dim, indices, n);
+}
+
+void Batch::boxPlaneDistances(const Coords& normals, const float* offsets, int count,
+                              const Point& p, const Vec3& dim, float* distances)
+{
+  int i = 0;
+  oz::boxPlaneDistances<WideLanes>(&i, count, normals, offsets, p, dim, distances);
+  oz::boxPlaneDistances<SingleLane>(&i, count, normals, offsets, p, dim, distances);
+}
+
+void Batch::transformPoints(const Mat4& tf, const Coords& points, int count, float* outX,
+                            float* outY, float* outZ)
+{
+  int i = 0;
+  oz::transformPoints<WideLanes>(&i, count, tf, points, outX, outY, outZ);
+  oz::transformPoints<SingleLane>(&i, count, tf, points, outX, outY, outZ);
+}
+
+int Batch::raysHitBoxes(const Coords& origins, const Coords& moves, const Coords& centres,
+                        const Coords& dims, int count, float* ratios)
+{
+  int i = 0;
+  int n = oz::raysHitBoxes<WideLanes>(&i, count, origins, moves, centres, dims, ratios, 0);
+  return oz::raysHitBoxes<SingleLane>(&i, count, origins, moves, centres, dims, ratios, n);
+}
+
+}
@@ -0,0 +1,118 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file ozCore/Batch.hh
+ *
+ * `Batch` class.
+ */
+
+#pragma once
+
+#include "Mat4.hh"
+
+namespace oz
+{
+
+/**
+ * Vectorised geometry kernels that process many elements stored as a structure of arrays.
+ *
+ * Each coordinate is read from its own array, so one SIMD register holds the same coordinate of
+ * 4 (SSE2, NEON) or 8 (AVX) consecutive elements. Kernels are built on GCC vector extensions and
+ * degrade to a scalar loop where no vector unit is available; trailing elements that do not fill a
+ * whole register are processed by the same code one by one. They do not depend on `OZ_SIMD`, which
+ * only changes the layout of `Vec3`, `Vec4` etc.
+ *
+ * Input and output arrays need no special alignment. Index arrays passed to filtering kernels must
+ * have room for `count` elements.
+ */
+class Batch
+{
+public:
+
+  /**
+   * Pointers to arrays of x, y and z coordinates.
+   */
+  struct Coords
+  {
+    const float* x; ///< X coordinates.
+    const float* y; ///< Y coordinates.
+    const float* z; ///< Z coordinates.
+  };
+
+public:
+
+  /// Number of elements processed at once by the vector unit.
+  static const int WIDTH;
+
+public:
+
+  /**
+   * Filter spheres that lie in the positive half-space of every plane (or intersect it).
+   *
+   * Sphere `i` passes iff `centres[i] * planes[j] > -radii[i]` for all `j`, which is a frustum test
+   * if the planes are frustum planes with normals pointing inside.
+   *
+   * @return number of passed spheres, their indices are written to `indices`.
+   */
+  static int spheresInPlanes(const Coords& centres, const float* radii, int count,
+                             const Plane* planes, int nPlanes, int* indices);
+
+  /**
+   * Filter AABBs overlapping a given AABB.
+   *
+   * Boxes are given by centres and half-dimensions, touching boxes overlap.
+   *
+   * @return number of overlapping boxes, their indices are written to `indices`.
+   */
+  static int boxesOverlapBox(const Coords& centres, const Coords& dims, int count, const Point& p,
+                             const Vec3& dim, int* indices);
+
+  /**
+   * Distances of an AABB from planes, measured from the box corner nearest to each plane.
+   *
+   * Planes are given by normals and offsets, `distances[i] = p * normals[i] - offsets[i] -
+   * dim * abs(normals[i])`. A box overlaps a convex polytope iff none of those is positive.
+   */
+  static void boxPlaneDistances(const Coords& normals, const float* offsets, int count,
+                                const Point& p, const Vec3& dim, float* distances);
+
+  /**
+   * Transform points by a matrix (translation is applied).
+   */
+  static void transformPoints(const Mat4& tf, const Coords& points, int count, float* outX,
+                              float* outY, float* outZ);
+
+  /**
+   * Slab test of moving points against AABBs, `i`-th ray against `i`-th box.
+   *
+   * Ray `i` starts at `origins[i]` and ends at `origins[i] + moves[i]`. The entry ratio in [0, 1]
+   * (0 if the origin is inside the box) is written to `ratios[i]` for hits, 1 for misses.
+   *
+   * @return number of hits.
+   */
+  static int raysHitBoxes(const Coords& origins, const Coords& moves, const Coords& centres,
+                          const Coords& dims, int count, float* ratios);
+
+};
+
+}
@@ -87,6 +87,54 @@ bool Bitset::isSubset(const Bitset& b) const
   return true;
 }
 
+int Bitset::count() const
+{
+  int n = 0;
+
+  for (int i = 0; i < data_.size(); ++i) {
+    n += __builtin_popcountll(data_[i]);
+  }
+  return n;
+}
+
+int Bitset::findNextSet(int i) const
+{
+  int unit = i / UNIT_BITS;
+
+  if (unit >= data_.size()) {
+    return -1;
+  }
+
+  size_t bits = data_[unit] & (~size_t(0) << (i % UNIT_BITS));
+
+  while (bits == 0) {
+    if (++unit == data_.size()) {
+      return -1;
+    }
+    bits = data_[unit];
+  }
+  return unit * UNIT_BITS + __builtin_ctzll(bits);
+}
+
+int Bitset::findNextClear(int i) const
+{
+  int unit = i / UNIT_BITS;
+
+  if (unit >= data_.size()) {
+    return -1;
+  }
+
+  size_t bits = ~data_[unit] & (~size_t(0) << (i % UNIT_BITS));
+
+  while (bits == 0) {
+    if (++unit == data_.size()) {
+      return -1;
+    }
+    bits = ~data_[unit];
+  }
+  return unit * UNIT_BITS + __builtin_ctzll(bits);
+}
+
 void Bitset::clear()
 {
   Arrays::fill<size_t, size_t>(data_.begin(), data_.size(), 0);
@@ -154,6 +202,16 @@ Bitset& Bitset::operator^=(const Bitset& b)
   return *this;
 }
 
+Bitset& Bitset::andNot(const Bitset& b)
+{
+  OZ_ASSERT(data_.size() == b.data_.size());
+
+  for (int i = 0; i < data_.size(); ++i) {
+    data_[i] &= ~b.data_[i];
+  }
+  return *this;
+}
+
 void Bitset::resize(int nBits)
 {
   OZ_ASSERT(nBits >= 0);
@@ -162,6 +162,39 @@ public:
    */
   bool isSubset(const Bitset& b) const;
 
+  /**
+   * Number of true bits.
+   */
+  int count() const;
+
+  /**
+   * Index of the first true bit at position `i` or after it, -1 if there is none.
+   */
+  int findNextSet(int i) const;
+
+  /**
+   * Index of the first false bit at position `i` or after it, -1 if there is none.
+   */
+  int findNextClear(int i) const;
+
+  /**
+   * Call `func(i)` for index of each true bit in ascending order.
+   *
+   * Empty units are skipped as a whole and each call costs only one bit scan.
+   */
+  template <typename Func>
+  void forEachSet(Func func) const
+  {
+    for (int i = 0; i < data_.size(); ++i) {
+      size_t bits = data_[i];
+
+      while (bits != 0) {
+        func(i * UNIT_BITS + __builtin_ctzll(bits));
+        bits &= bits - 1;
+      }
+    }
+  }
+
   /**
    * Get the `i`-th bit.
    */
@@ -243,6 +276,11 @@ public:
    */
   Bitset& operator^=(const Bitset& b);
 
+  /**
+   * Clear all bits that are true in a same-length bitset, i.e. `*this &= ~b` without a temporary.
+   */
+  Bitset& andNot(const Bitset& b);
+
   /**
    * Resize bitset.
    *
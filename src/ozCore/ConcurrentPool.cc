@@ -0,0 +1,474 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "ConcurrentPool.hh"
+
+#include "Alloc.hh"
+#include "System.hh"
+
+#include <cstdlib>
+#include <cstring>
+#include <malloc.h>
+
+namespace oz
+{
+
+union alignas(OZ_ALIGNMENT) ConcurrentPoolAlloc::Slot
+{
+  Slot* nextSlot;
+  char  storage[1];
+};
+
+struct ConcurrentPoolAlloc::Block
+{
+  Block*  prev;       ///< Previous block in the same depot list.
+  Block*  next;       ///< Next block in the same depot list.
+  Block** list;       ///< Head of the depot list this block is in.
+  Slot*   freeSlot;   ///< Linked list of free slots in the depot.
+  int     nFree;      ///< Number of free slots in the depot.
+  Instant emptySince; ///< When the last slot has been returned.
+
+  OZ_INTERNAL
+  static Block* create(int slotSize, int blockSlots, size_t blockSize)
+  {
+#ifdef _WIN32
+    void* chunk = _aligned_malloc(blockSize, blockSize);
+#else
+    void* chunk = nullptr;
+    if (posix_memalign(&chunk, blockSize, blockSize) != 0) {
+      chunk = nullptr;
+    }
+#endif
+
+    if (chunk == nullptr) {
+      OZ_ERROR("oz::ConcurrentPoolAlloc: Out of memory while trying to allocate a block of %llu B",
+               ulong64(blockSize));
+    }
+
+    Block* block = new(chunk) Block;
+
+    block->prev     = nullptr;
+    block->next     = nullptr;
+    block->list     = nullptr;
+    block->freeSlot = block->slot(0, slotSize);
+    block->nFree    = blockSlots;
+
+    for (int i = 0; i < blockSlots - 1; ++i) {
+      block->slot(i, slotSize)->nextSlot = block->slot(i + 1, slotSize);
+    }
+    block->slot(blockSlots - 1, slotSize)->nextSlot = nullptr;
+
+    return block;
+  }
+
+  OZ_INTERNAL
+  void destroy()
+  {
+#ifdef _WIN32
+    _aligned_free(this);
+#else
+    ::free(this);
+#endif
+  }
+
+  OZ_INTERNAL
+  OZ_ALWAYS_INLINE
+  Slot* slot(int i, int slotSize)
+  {
+    char* data = reinterpret_cast<char*>(this) + Alloc::alignUp(sizeof(Block));
+    return reinterpret_cast<Slot*>(&data[i * slotSize]);
+  }
+
+  OZ_INTERNAL
+  void link(Block** newList)
+  {
+    prev = nullptr;
+    next = *newList;
+    list = newList;
+
+    if (next != nullptr) {
+      next->prev = this;
+    }
+    *newList = this;
+  }
+
+  OZ_INTERNAL
+  void unlink()
+  {
+    if (prev == nullptr) {
+      *list = next;
+    }
+    else {
+      prev->next = next;
+    }
+    if (next != nullptr) {
+      next->prev = prev;
+    }
+    list = nullptr;
+  }
+};
+
+const Duration ConcurrentPoolAlloc::DEFAULT_RELEASE_DELAY = 10_s;
+
+static ConcurrentPoolAlloc* firstPool = nullptr;
+static SpinLock             poolsLock;
+static Atomic<int>          nThreads  = {0};
+static thread_local int     threadMagazine = -1;
+
+OZ_ALWAYS_INLINE
+static inline int magazineIndex()
+{
+  if (threadMagazine < 0) {
+    threadMagazine = nThreads.fetchAdd<ATOMIC_RELAXED>(1) % ConcurrentPoolAlloc::N_MAGAZINES;
+  }
+  return threadMagazine;
+}
+
+void ConcurrentPoolAlloc::refill(Magazine* magazine)
+{
+  depotLock_.lock();
+
+  while (magazine->nSlots < MAGAZINE_SIZE / 2) {
+    Block* block = partialBlocks_ != nullptr ? partialBlocks_ : emptyBlocks_;
+
+    if (block == nullptr) {
+      block = Block::create(slotSize_, blockSlots_, blockSize_);
+      block->link(&partialBlocks_);
+
+      ++nBlocks_;
+      nDepotFree_ += blockSlots_;
+    }
+    else if (block->list == &emptyBlocks_) {
+      block->unlink();
+      block->link(&partialBlocks_);
+    }
+
+    while (block->freeSlot != nullptr && magazine->nSlots < MAGAZINE_SIZE / 2) {
+      Slot* slot = block->freeSlot;
+
+      block->freeSlot = slot->nextSlot;
+      --block->nFree;
+      --nDepotFree_;
+
+      slot->nextSlot  = magazine->slots;
+      magazine->slots = slot;
+      ++magazine->nSlots;
+    }
+
+    if (block->freeSlot == nullptr) {
+      block->unlink();
+      block->link(&fullBlocks_);
+    }
+  }
+
+  highWater_ = max(highWater_, nBlocks_ * blockSlots_ - nDepotFree_);
+
+  depotLock_.unlock();
+}
+
+void ConcurrentPoolAlloc::drain(Magazine* magazine, int nSlots)
+{
+  Instant now;
+  bool    hasNow = false;
+
+  depotLock_.lock();
+
+  for (int i = 0; i < nSlots; ++i) {
+    Slot*  slot  = magazine->slots;
+    Block* block = reinterpret_cast<Block*>(size_t(slot) & ~(blockSize_ - 1));
+
+    magazine->slots = slot->nextSlot;
+    --magazine->nSlots;
+
+    slot->nextSlot  = block->freeSlot;
+    block->freeSlot = slot;
+    ++block->nFree;
+    ++nDepotFree_;
+
+    if (block->nFree == 1) {
+      block->unlink();
+      block->link(&partialBlocks_);
+    }
+    if (block->nFree == blockSlots_) {
+      if (!hasNow) {
+        now    = Instant::now();
+        hasNow = true;
+      }
+
+      block->emptySince = now;
+      block->unlink();
+      block->link(&emptyBlocks_);
+    }
+  }
+
+  depotLock_.unlock();
+}
+
+ConcurrentPoolAlloc::ConcurrentPoolAlloc(const char* name, int slotSize, int blockSlots)
+  : partialBlocks_(nullptr), fullBlocks_(nullptr), emptyBlocks_(nullptr), name_(name),
+    next_(nullptr), slotSize_(int(Alloc::alignUp(size_t(slotSize)))), blockSlots_(blockSlots),
+    blockSize_(0), nBlocks_(0), nDepotFree_(0), highWater_(0),
+    releaseDelay_(DEFAULT_RELEASE_DELAY), lastAllocs_(0), lastInstant_(Instant::now())
+{
+  for (Magazine& magazine : magazines_) {
+    magazine.slots   = nullptr;
+    magazine.nSlots  = 0;
+    magazine.nLive   = 0;
+    magazine.nAllocs = 0;
+  }
+
+  // Round block size up to a power of two and use the slack for additional slots.
+  size_t headerSize = Alloc::alignUp(sizeof(Block));
+  size_t minSize    = headerSize + size_t(blockSlots) * size_t(slotSize_);
+
+  blockSize_ = OZ_ALIGNMENT;
+  while (blockSize_ < minSize) {
+    blockSize_ *= 2;
+  }
+  blockSlots_ = int((blockSize_ - headerSize) / size_t(slotSize_));
+
+  poolsLock.lock();
+
+  next_     = firstPool;
+  firstPool = this;
+
+  poolsLock.unlock();
+}
+
+ConcurrentPoolAlloc::~ConcurrentPoolAlloc()
+{
+  free();
+
+  poolsLock.lock();
+
+  if (firstPool == this) {
+    firstPool = next_;
+  }
+  else {
+    for (ConcurrentPoolAlloc* pool = firstPool; pool != nullptr; pool = pool->next_) {
+      if (pool->next_ == this) {
+        pool->next_ = next_;
+        break;
+      }
+    }
+  }
+
+  poolsLock.unlock();
+}
+
+ConcurrentPoolAlloc* ConcurrentPoolAlloc::first()
+{
+  poolsLock.lock();
+  ConcurrentPoolAlloc* pool = firstPool;
+  poolsLock.unlock();
+
+  return pool;
+}
+
+int ConcurrentPoolAlloc::size() const
+{
+  int size = 0;
+
+  for (const Magazine& magazine : magazines_) {
+    magazine.lock.lock();
+    size += magazine.nLive;
+    magazine.lock.unlock();
+  }
+  return size;
+}
+
+int ConcurrentPoolAlloc::capacity() const
+{
+  depotLock_.lock();
+  int capacity = nBlocks_ * blockSlots_;
+  depotLock_.unlock();
+
+  return capacity;
+}
+
+void ConcurrentPoolAlloc::setReleaseDelay(Duration delay)
+{
+  depotLock_.lock();
+  releaseDelay_ = delay;
+  depotLock_.unlock();
+}
+
+void* ConcurrentPoolAlloc::allocate()
+{
+  Magazine& magazine = magazines_[magazineIndex()];
+
+  magazine.lock.lock();
+
+  if (magazine.slots == nullptr) {
+    refill(&magazine);
+  }
+
+  Slot* slot = magazine.slots;
+
+  magazine.slots = slot->nextSlot;
+  --magazine.nSlots;
+  ++magazine.nLive;
+  ++magazine.nAllocs;
+
+  magazine.lock.unlock();
+
+  return slot->storage;
+}
+
+void ConcurrentPoolAlloc::deallocate(void* ptr)
+{
+  if (ptr == nullptr) {
+    return;
+  }
+
+  Slot*     slot     = static_cast<Slot*>(ptr);
+  Magazine& magazine = magazines_[magazineIndex()];
+
+#ifndef NDEBUG
+  memset(slot, 0xee, size_t(slotSize_));
+#endif
+
+  magazine.lock.lock();
+
+  slot->nextSlot = magazine.slots;
+  magazine.slots = slot;
+  ++magazine.nSlots;
+  --magazine.nLive;
+
+  if (magazine.nSlots > MAGAZINE_SIZE) {
+    drain(&magazine, MAGAZINE_SIZE / 2);
+  }
+
+  magazine.lock.unlock();
+}
+
+void ConcurrentPoolAlloc::flush()
+{
+  for (Magazine& magazine : magazines_) {
+    magazine.lock.lock();
+    drain(&magazine, magazine.nSlots);
+    magazine.lock.unlock();
+  }
+}
+
+int ConcurrentPoolAlloc::trim()
+{
+  int nReleased = 0;
+
+  depotLock_.lock();
+
+  if (emptyBlocks_ != nullptr) {
+    Instant now = Instant::now();
+
+    for (Block* block = emptyBlocks_; block != nullptr;) {
+      Block* next = block->next;
+
+      if (now - block->emptySince >= releaseDelay_) {
+        block->unlink();
+        block->destroy();
+
+        --nBlocks_;
+        nDepotFree_ -= blockSlots_;
+        ++nReleased;
+      }
+      block = next;
+    }
+  }
+
+  depotLock_.unlock();
+
+  return nReleased;
+}
+
+ConcurrentPoolAlloc::Stats ConcurrentPoolAlloc::statistics()
+{
+  int    size    = 0;
+  long64 nAllocs = 0;
+
+  for (Magazine& magazine : magazines_) {
+    magazine.lock.lock();
+    size    += magazine.nLive;
+    nAllocs += magazine.nAllocs;
+    magazine.lock.unlock();
+  }
+
+  Instant now = Instant::now();
+
+  depotLock_.lock();
+
+  Stats stats;
+  float interval = (now - lastInstant_).t();
+
+  stats.size            = size;
+  stats.highWater       = max(highWater_, size);
+  stats.capacity        = nBlocks_ * blockSlots_;
+  stats.bytesHeld       = size_t(nBlocks_) * blockSize_;
+  stats.fragmentation   = stats.capacity == 0 ? 0.0f : 1.0f - float(size) / float(stats.capacity);
+  stats.allocsPerSecond = interval == 0.0f ? 0.0f : float(nAllocs - lastAllocs_) / interval;
+
+  lastAllocs_  = nAllocs;
+  lastInstant_ = now;
+
+  depotLock_.unlock();
+
+  return stats;
+}
+
+void ConcurrentPoolAlloc::free()
+{
+  int size = this->size();
+
+  OZ_ASSERT(size == 0);
+
+  for (Magazine& magazine : magazines_) {
+    magazine.lock.lock();
+    magazine.slots  = nullptr;
+    magazine.nSlots = 0;
+    magazine.nLive  = 0;
+    magazine.lock.unlock();
+  }
+
+  depotLock_.lock();
+
+  if (size == 0) {
+    Block* lists[] = {partialBlocks_, fullBlocks_, emptyBlocks_};
+
+    for (Block* list : lists) {
+      for (Block* block = list; block != nullptr;) {
+        Block* next = block->next;
+
+        block->destroy();
+        block = next;
+      }
+    }
+  }
+
+  partialBlocks_ = nullptr;
+  fullBlocks_    = nullptr;
+  emptyBlocks_   = nullptr;
+  nBlocks_       = 0;
+  nDepotFree_    = 0;
+
+  depotLock_.unlock();
+}
+
+}
@@ -0,0 +1,287 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file ozCore/ConcurrentPool.hh
+ *
+ * `ConcurrentPool` class template.
+ */
+
+#pragma once
+
+#include "Instant.hh"
+#include "Pool.hh"
+#include "SpinLock.hh"
+
+namespace oz
+{
+
+/**
+ * Thread-safe memory pool with per-thread caches (non-template version).
+ *
+ * Each thread allocates from and frees into its own magazine, a short list of free slots, so the
+ * common case only touches a lock that no other thread contends for. Magazines are refilled from
+ * and overflow into a shared depot that owns the memory blocks and keeps track of free slots in
+ * each block. A block whose slots have all been returned to the depot is released once it has been
+ * idle for `releaseDelay()` on the next `trim()` call, so the pool shrinks after usage peaks.
+ *
+ * Blocks are aligned to their size, which is rounded up to a power of two, so the owning block of
+ * a slot is found from its address. Rounding adds slots to a block rather than wasting space.
+ *
+ * Statistics are kept per magazine and summed on demand, so `size()` and `statistics()` are only
+ * approximate while other threads are allocating. All pools are registered in a global list,
+ * accessible via `first()` and `next()`.
+ *
+ * Unless `NDEBUG` macro is defined, all freed memory is rewritten with 0xee bytes.
+ *
+ * @sa `oz::ConcurrentPool`, `oz::PoolAlloc`
+ */
+class ConcurrentPoolAlloc
+{
+public:
+
+  /// Number of magazines, threads beyond that share them.
+  static const int N_MAGAZINES = 16;
+
+  /// Maximum number of free slots in a magazine, half of that is moved on refill or overflow.
+  static const int MAGAZINE_SIZE = 32;
+
+  /// Default time an empty block is kept before it is released.
+  static const Duration DEFAULT_RELEASE_DELAY;
+
+  /**
+   * Pool statistics.
+   */
+  struct Stats
+  {
+    int    size;            ///< Number of used slots.
+    int    highWater;       ///< Peak number of used slots, sampled on depot refills.
+    int    capacity;        ///< Number of slots in all blocks.
+    size_t bytesHeld;       ///< Memory held by the pool.
+    float  fragmentation;   ///< Fraction of held slots that are free.
+    float  allocsPerSecond; ///< Allocation rate since the previous `statistics()` call.
+  };
+
+private:
+
+  union  Slot;
+  struct Block;
+
+  /**
+   * Per-thread cache of free slots, aligned to a cache line to avoid false sharing.
+   */
+  struct alignas(64) Magazine
+  {
+    mutable SpinLock lock;    ///< Only contended if more than `N_MAGAZINES` threads use the pool.
+    Slot*            slots;   ///< Linked list of free slots.
+    int              nSlots;  ///< Number of free slots.
+    int              nLive;   ///< Allocations minus deallocations through this magazine.
+    long64           nAllocs; ///< Cumulative number of allocations through this magazine.
+  };
+
+  Magazine             magazines_[N_MAGAZINES]; ///< Per-thread caches.
+  mutable SpinLock     depotLock_;              ///< Lock for the depot, i.e. block lists.
+  Block*               partialBlocks_;          ///< Blocks with both used and free slots.
+  Block*               fullBlocks_;             ///< Blocks with no free slots in the depot.
+  Block*               emptyBlocks_;            ///< Blocks with all slots free.
+  const char*          name_;                   ///< Name for statistics.
+  ConcurrentPoolAlloc* next_;                   ///< Next pool in the global list.
+  int                  slotSize_;               ///< Size of a slot.
+  int                  blockSlots_;             ///< Number of slots per memory block.
+  size_t               blockSize_;              ///< Size of a memory block (power of two).
+  int                  nBlocks_;                ///< Number of allocated blocks.
+  int                  nDepotFree_;             ///< Number of free slots in the depot.
+  int                  highWater_;              ///< Peak number of used slots.
+  Duration             releaseDelay_;           ///< Time an empty block is kept.
+  long64               lastAllocs_;             ///< Allocations at last `statistics()`.
+  Instant              lastInstant_;            ///< Time of last `statistics()`.
+
+private:
+
+  /**
+   * Move slots from the depot to a magazine.
+   */
+  void refill(Magazine* magazine);
+
+  /**
+   * Move `nSlots` slots from the magazine to the depot.
+   */
+  void drain(Magazine* magazine, int nSlots);
+
+public:
+
+  /**
+   * Create an empty pool, storage is allocated when the first allocation is made.
+   *
+   * The pool registers itself in the global list of pools. The name must outlive the pool.
+   */
+  explicit ConcurrentPoolAlloc(const char* name, int slotSize, int blockSlots = 256);
+
+  /**
+   * Destructor, unregisters the pool.
+   */
+  ~ConcurrentPoolAlloc();
+
+  /**
+   * No copying or moving.
+   */
+  ConcurrentPoolAlloc(const ConcurrentPoolAlloc&) = delete;
+
+  /**
+   * No copying or moving.
+   */
+  ConcurrentPoolAlloc& operator=(const ConcurrentPoolAlloc&) = delete;
+
+  /**
+   * First pool in the global list.
+   */
+  static ConcurrentPoolAlloc* first();
+
+  /**
+   * Next pool in the global list.
+   */
+  OZ_ALWAYS_INLINE
+  ConcurrentPoolAlloc* next() const
+  {
+    return next_;
+  }
+
+  /**
+   * Pool name.
+   */
+  OZ_ALWAYS_INLINE
+  const char* name() const
+  {
+    return name_;
+  }
+
+  /**
+   * Number of used slots in the pool.
+   */
+  int size() const;
+
+  /**
+   * True iff no slots are used.
+   */
+  OZ_ALWAYS_INLINE
+  bool isEmpty() const
+  {
+    return size() == 0;
+  }
+
+  /**
+   * Number of allocated slots.
+   */
+  int capacity() const;
+
+  /**
+   * Size of a slot.
+   */
+  OZ_ALWAYS_INLINE
+  int slotSize() const
+  {
+    return slotSize_;
+  }
+
+  /**
+   * Number of object slots per memory block.
+   */
+  OZ_ALWAYS_INLINE
+  int blockSlots() const
+  {
+    return blockSlots_;
+  }
+
+  /**
+   * Time an empty block is kept before `trim()` releases it.
+   */
+  OZ_ALWAYS_INLINE
+  Duration releaseDelay() const
+  {
+    return releaseDelay_;
+  }
+
+  /**
+   * Set time an empty block is kept before `trim()` releases it.
+   */
+  void setReleaseDelay(Duration delay);
+
+  /**
+   * Allocate a new object.
+   */
+  void* allocate();
+
+  /**
+   * Free a given object.
+   */
+  void deallocate(void* ptr);
+
+  /**
+   * Return all free slots cached in magazines to the depot.
+   */
+  void flush();
+
+  /**
+   * Release blocks that have been empty for at least `releaseDelay()`.
+   *
+   * Cheap enough to be called on every tick.
+   *
+   * @return number of released blocks.
+   */
+  int trim();
+
+  /**
+   * Get pool statistics, this also restarts the allocation rate measurement.
+   */
+  Stats statistics();
+
+  /**
+   * Deallocate the storage.
+   *
+   * In the case the pool is not empty it is still cleared but memory is not deallocated. This
+   * memory leak is intended to prevent potential crashes and it only happens if you already have
+   * a memory leak in your program.
+   */
+  void free();
+
+};
+
+/**
+ * Template wrapper for `ConcurrentPoolAlloc`.
+ *
+ * @sa `oz::ConcurrentPoolAlloc`
+ */
+template <class Elem>
+class ConcurrentPool : public ConcurrentPoolAlloc
+{
+public:
+
+  /**
+   * Create an empty pool with a given block size.
+   */
+  explicit ConcurrentPool(const char* name, int blockSlots = 256)
+    : ConcurrentPoolAlloc(name, sizeof(Elem), blockSlots)
+  {}
+
+};
+
+}
@@ -27,10 +27,14 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <dirent.h>
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#if !defined(__native_client__) && !defined(_WIN32)
+# include <sys/mman.h>
+#endif
 #ifdef _WIN32
 # include <windows.h>
 # include <shlobj.h>
@@ -96,6 +100,120 @@ struct Stat
   }
 };
 
+#if !defined(__native_client__) && !defined(_WIN32)
+
+/**
+ * Map `size` bytes at `offset` of a native file, return pointer to the first mapped byte of data.
+ */
+static char* mapRegion(const char* path, long64 offset, int size)
+{
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  long64 pageSize = sysconf(_SC_PAGESIZE);
+  long64 base     = offset - offset % pageSize;
+  size_t length   = size_t(offset - base + size);
+
+  void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, off_t(base));
+  close(fd);
+
+  return mapping == MAP_FAILED ? nullptr : static_cast<char*>(mapping) + (offset - base);
+}
+
+static uint readLE16(const ubyte* data)
+{
+  return uint(data[0]) | uint(data[1]) << 8;
+}
+
+static uint readLE32(const ubyte* data)
+{
+  return uint(data[0]) | uint(data[1]) << 8 | uint(data[2]) << 16 | uint(data[3]) << 24;
+}
+
+/**
+ * Locate an uncompressed, unencrypted entry inside a ZIP archive.
+ *
+ * The archive is scanned via a temporary mapping, so only pages holding the
+ * end-of-central-directory record, the central directory and the entry's local header are actually
+ * touched. ZIP64 archives and compressed entries are not supported.
+ */
+static bool findStoredEntry(const char* archive, const char* name, long64* offset, int* size)
+{
+  int archiveSize = Stat(archive).size;
+  if (archiveSize < 22) {
+    return false;
+  }
+
+  const ubyte* data = reinterpret_cast<const ubyte*>(mapRegion(archive, 0, archiveSize));
+  if (data == nullptr) {
+    return false;
+  }
+
+  const ubyte* end = data + archiveSize;
+  const ubyte* eocd = nullptr;
+
+  // End of central directory record is followed by at most 64 KiB of archive comment.
+  for (const ubyte* p = end - 22; p >= data && p >= end - 22 - 0xffff; --p) {
+    if (readLE32(p) == 0x06054b50) {
+      eocd = p;
+      break;
+    }
+  }
+
+  bool isFound = false;
+
+  if (eocd != nullptr) {
+    int          nEntries  = int(readLE16(eocd + 10));
+    uint         dirOffset = readLE32(eocd + 16);
+    int          nameLen   = String::length(name);
+    const ubyte* entry     = data + min<ulong64>(dirOffset, ulong64(archiveSize));
+
+    for (int i = 0; i < nEntries && entry + 46 <= end; ++i) {
+      if (readLE32(entry) != 0x02014b50) {
+        break;
+      }
+
+      uint flags        = readLE16(entry + 8);
+      uint method       = readLE16(entry + 10);
+      uint compSize     = readLE32(entry + 20);
+      uint origSize     = readLE32(entry + 24);
+      int  entryNameLen = int(readLE16(entry + 28));
+      int  extraLen     = int(readLE16(entry + 30));
+      int  commentLen   = int(readLE16(entry + 32));
+      uint localOffset  = readLE32(entry + 42);
+
+      if (entryNameLen == nameLen && entry + 46 + nameLen <= end &&
+          memcmp(entry + 46, name, size_t(nameLen)) == 0)
+      {
+        const ubyte* local = data + localOffset;
+
+        if (method == 0 && !(flags & 0x1) && compSize == origSize && origSize <= 0x7fffffff &&
+            localOffset <= ulong64(archiveSize) - 30 && readLE32(local) == 0x04034b50)
+        {
+          long64 dataOffset = long64(localOffset) + 30 + readLE16(local + 26) +
+                              readLE16(local + 28);
+
+          if (dataOffset + origSize <= archiveSize) {
+            *offset = dataOffset;
+            *size   = int(origSize);
+            isFound = true;
+          }
+        }
+        break;
+      }
+
+      entry += 46 + entryNameLen + extraLen + commentLen;
+    }
+  }
+
+  munmap(const_cast<ubyte*>(data), size_t(archiveSize));
+  return isFound;
+}
+
+#endif
+
 static File specialFiles[10];
 
 #ifdef __native_client__
@@ -494,6 +612,55 @@ Stream File::read(Endian::Order order) const
   return is;
 }
 
+Stream File::map(Endian::Order order) const
+{
+#if !defined(__native_client__) && !defined(_WIN32)
+  String nativePath;
+  long64 offset = 0;
+  int    size   = -1;
+
+  if (isVirtual()) {
+    const char* path    = begin() + 1;
+    const char* realDir = PHYSFS_getRealDir(path);
+
+    if (realDir != nullptr) {
+      // Strip mount point to get path relative to the mounted directory or archive.
+      const char* mountPoint = PHYSFS_getMountPoint(realDir);
+      mountPoint = mountPoint == nullptr ? "" : mountPoint + (mountPoint[0] == '/');
+
+      if (String::beginsWith(path, mountPoint)) {
+        const char* relPath = path + String::length(mountPoint);
+        Stat        dirStat(realDir);
+
+        if (dirStat.type == Stat::DIRECTORY) {
+          nativePath = format(last(realDir) == '/' ? "%s%s" : "%s/%s", realDir, relPath);
+          size       = Stat(nativePath.c()).size;
+        }
+        else if (dirStat.type == Stat::FILE && findStoredEntry(realDir, relPath, &offset, &size)) {
+          nativePath = realDir;
+        }
+      }
+    }
+  }
+  else {
+    nativePath = *this;
+    size       = Stat(begin()).size;
+  }
+
+  if (size > 0) {
+    char* data = mapRegion(nativePath.c(), offset, size);
+
+    if (data != nullptr) {
+      Stream is(data, data + size, order);
+      is.flags_ = Stream::MAPPED;
+      return is;
+    }
+  }
+#endif
+
+  return read(order);
+}
+
 bool File::write(const char* buffer, int size) const
 {
   if (isVirtual()) {
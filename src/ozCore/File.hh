@@ -276,6 +276,18 @@ public:
    */
   Stream read(Endian::Order order = Endian::NATIVE) const;
 
+  /**
+   * Create a read-only stream that maps file contents into memory instead of copying them.
+   *
+   * Native files and files in VFS that reside in a mounted directory or are stored uncompressed
+   * inside a ZIP archive are mapped via `mmap()`, so the pages are shared with the OS file cache
+   * and only loaded when accessed. For other files (compressed archive entries, platforms without
+   * `mmap()`) this falls back to `read()`. The mapping is released when the stream is freed.
+   *
+   * An invalid (empty) stream is returned on error.
+   */
+  Stream map(Endian::Order order = Endian::NATIVE) const;
+
   /**
    * Write buffer contents to the file.
    */
@@ -0,0 +1,260 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file ozCore/FlatHashMap.hh
+ *
+ * `FlatHashMap` class template.
+ */
+
+#pragma once
+
+#include "Map.hh"
+#include "FlatHashSet.hh"
+
+namespace oz
+{
+
+/**
+ * Open-addressing hashtable implementation.
+ *
+ * It has the same interface as `HashMap` but stores elements in a flat array of slots, see
+ * `FlatHashSet` for details. Pointers to elements are invalidated when an element is added or
+ * removed.
+ *
+ * @sa `oz::FlatHashSet`, `oz::HashMap`
+ */
+template <typename Key, typename Value, class HashFunc = Hash<Key>>
+class FlatHashMap : private FlatHashSet<MapPair<Key, Value, Less<Key>>, HashFunc>
+{
+public:
+
+  /**
+   * Shortcut for key-value pair type.
+   */
+  typedef MapPair<Key, Value, Less<Key>> Pair;
+
+  using typename FlatHashSet<Pair, HashFunc>::CIterator;
+  using typename FlatHashSet<Pair, HashFunc>::Iterator;
+
+private:
+
+  using typename FlatHashSet<Pair, HashFunc>::Slot;
+
+  using FlatHashSet<Pair, HashFunc>::ctrl_;
+  using FlatHashSet<Pair, HashFunc>::slots_;
+  using FlatHashSet<Pair, HashFunc>::size_;
+  using FlatHashSet<Pair, HashFunc>::slotCount_;
+  using FlatHashSet<Pair, HashFunc>::mix;
+  using FlatHashSet<Pair, HashFunc>::probe;
+  using FlatHashSet<Pair, HashFunc>::claim;
+  using FlatHashSet<Pair, HashFunc>::ensureCapacity;
+
+  /**
+   * Insert an element, optionally overwriting an existing one.
+   *
+   * This is a helper function to reduce code duplication between `add()` and `include()`.
+   *
+   * @return Value of the inserted element.
+   */
+  template <typename Key_, typename Value_>
+  Pair& insert(Key_&& key, Value_&& value, bool overwrite)
+  {
+    ensureCapacity(size_ + 1);
+
+    uint h = mix(HashFunc()(key));
+    int  i = probe(key, h);
+
+    if (i >= 0) {
+      if (overwrite) {
+        slots_[i].elem.value = static_cast<Value_&&>(value);
+      }
+      return slots_[i].elem;
+    }
+
+    Slot& slot = claim(~i, h);
+
+    slot.elem.key   = static_cast<Key_&&>(key);
+    slot.elem.value = static_cast<Value_&&>(value);
+    return slot.elem;
+  }
+
+public:
+
+  using FlatHashSet<Pair, HashFunc>::citerator;
+  using FlatHashSet<Pair, HashFunc>::iterator;
+  using FlatHashSet<Pair, HashFunc>::begin;
+  using FlatHashSet<Pair, HashFunc>::end;
+  using FlatHashSet<Pair, HashFunc>::size;
+  using FlatHashSet<Pair, HashFunc>::isEmpty;
+  using FlatHashSet<Pair, HashFunc>::capacity;
+  using FlatHashSet<Pair, HashFunc>::slotCount;
+  using FlatHashSet<Pair, HashFunc>::contains;
+  using FlatHashSet<Pair, HashFunc>::exclude;
+  using FlatHashSet<Pair, HashFunc>::trim;
+  using FlatHashSet<Pair, HashFunc>::clear;
+
+  /**
+   * Create an empty hashtable.
+   */
+  FlatHashMap() = default;
+
+  /**
+   * Create an empty hashtable with enough pre-allocated slots for a given number of elements.
+   */
+  explicit FlatHashMap(int capacity)
+    : FlatHashSet<Pair, HashFunc>(capacity)
+  {}
+
+  /**
+   * Initialise from an initialiser list.
+   */
+  FlatHashMap(InitialiserList<Pair> il)
+    : FlatHashMap(int(il.size()))
+  {
+    for (const Pair& p : il) {
+      add(p.key, p.value);
+    }
+  }
+
+  /**
+   * Copy constructor, copies slot arrays.
+   */
+  FlatHashMap(const FlatHashMap& other) = default;
+
+  /**
+   * Move constructor, moves storage.
+   */
+  FlatHashMap(FlatHashMap&& other) = default;
+
+  /**
+   * Copy operator, copies slot arrays.
+   */
+  FlatHashMap& operator=(const FlatHashMap& other) = default;
+
+  /**
+   * Move operator, moves storage.
+   */
+  FlatHashMap& operator=(FlatHashMap&& other) = default;
+
+  /**
+   * Assign from an initialiser list.
+   */
+  FlatHashMap& operator=(InitialiserList<Pair> il)
+  {
+    clear();
+    ensureCapacity(int(il.size()));
+
+    for (const Pair& p : il) {
+      add(p.key, p.value);
+    }
+    return *this;
+  }
+
+  /**
+   * True iff contained elements are equal.
+   */
+  bool operator==(const FlatHashMap& other) const
+  {
+    if (size_ != other.size_) {
+      return false;
+    }
+
+    for (const Pair& p : *this) {
+      const Value* value = other.find(p.key);
+
+      if (value == nullptr || !(*value == p.value)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * False iff contained elements are equal.
+   */
+  bool operator!=(const FlatHashMap& other) const
+  {
+    return !operator==(other);
+  }
+
+  /**
+   * Constant pointer to the value for a given key or `nullptr` if not found.
+   */
+  template <typename Key_>
+  const Value* find(const Key_& key) const
+  {
+    if (size_ == 0) {
+      return nullptr;
+    }
+
+    int i = probe(key, mix(HashFunc()(key)));
+    return i < 0 ? nullptr : &slots_[i].elem.value;
+  }
+
+  /**
+   * Pointer to the value for a given key or `nullptr` if not found.
+   */
+  template <typename Key_>
+  Value* find(const Key_& key)
+  {
+    return const_cast<Value*>(static_cast<const FlatHashMap*>(this)->find<Key_>(key));
+  }
+
+  /**
+   * Add a new element, if the key already exists in the hashtable overwrite existing element.
+   *
+   * @return Reference to the value of the inserted element.
+   */
+  template <typename Key_, typename Value_>
+  Pair& add(Key_&& key, Value_&& value)
+  {
+    return insert(static_cast<Key_&&>(key), static_cast<Value_&&>(value), true);
+  }
+
+  /**
+   * Add a new element if the key does not exist in the hashtable.
+   *
+   * @return Reference to the value of the inserted or the existing element with the same key.
+   */
+  template <typename Key_, typename Value_>
+  Pair& include(Key_&& key, Value_&& value)
+  {
+    return insert(static_cast<Key_&&>(key), static_cast<Value_&&>(value), false);
+  }
+
+  /**
+   * Delete all objects referenced by element values and clear the hashtable.
+   */
+  void free()
+  {
+    for (int i = 0; i < slotCount_; ++i) {
+      if (ctrl_[i] != detail::FlatGroup::EMPTY) {
+        delete slots_[i].elem.value;
+      }
+    }
+    clear();
+  }
+
+};
+
+}
@@ -0,0 +1,880 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file ozCore/FlatHashSet.hh
+ *
+ * `FlatHashSet` class template.
+ */
+
+#pragma once
+
+#include "Arrays.hh"
+
+#if defined(__ARM_NEON__)
+# include <arm_neon.h>
+#elif defined(__SSE2__)
+# include <emmintrin.h>
+#endif
+
+namespace oz
+{
+
+namespace detail
+{
+
+/**
+ * Group of control bytes of a flat hashtable that are probed in parallel.
+ *
+ * A control byte is either `EMPTY` or holds the lowest 7 bits of the element's hash. `match()` and
+ * `matchEmpty()` return bit masks of matching slots in the group. NEON masks have 4 bits per slot,
+ * so a bit index must be shifted right by `SHIFT` to get a slot offset.
+ */
+class FlatGroup
+{
+public:
+
+  /// Number of control bytes in a group.
+  static const int SIZE = 16;
+
+  /// Control byte of an empty slot.
+  static const ubyte EMPTY = 0x80;
+
+#if defined(__ARM_NEON__)
+
+  /// Bit index to slot offset shift.
+  static const int SHIFT = 2;
+
+private:
+
+  uint8x16_t ctrl_; ///< Control bytes.
+
+  /**
+   * Compress comparison result into a mask with the highest bit of each 4-bit nibble set.
+   */
+  OZ_ALWAYS_INLINE
+  static ulong64 toMask(uint8x16_t cmp)
+  {
+    uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull;
+  }
+
+public:
+
+  /**
+   * Load `SIZE` control bytes starting at a given address.
+   */
+  OZ_ALWAYS_INLINE
+  explicit FlatGroup(const ubyte* ctrl)
+    : ctrl_(vld1q_u8(ctrl))
+  {}
+
+  /**
+   * Mask of slots whose control byte equals `h2`.
+   */
+  OZ_ALWAYS_INLINE
+  ulong64 match(ubyte h2) const
+  {
+    return toMask(vceqq_u8(ctrl_, vdupq_n_u8(h2)));
+  }
+
+  /**
+   * Mask of empty slots.
+   */
+  OZ_ALWAYS_INLINE
+  ulong64 matchEmpty() const
+  {
+    return toMask(vtstq_u8(ctrl_, vdupq_n_u8(EMPTY)));
+  }
+
+#elif defined(__SSE2__)
+
+  /// Bit index to slot offset shift.
+  static const int SHIFT = 0;
+
+private:
+
+  __m128i ctrl_; ///< Control bytes.
+
+public:
+
+  /**
+   * Load `SIZE` control bytes starting at a given address.
+   */
+  OZ_ALWAYS_INLINE
+  explicit FlatGroup(const ubyte* ctrl)
+    : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)))
+  {}
+
+  /**
+   * Mask of slots whose control byte equals `h2`.
+   */
+  OZ_ALWAYS_INLINE
+  ulong64 match(ubyte h2) const
+  {
+    return uint(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(char(h2)))));
+  }
+
+  /**
+   * Mask of empty slots.
+   */
+  OZ_ALWAYS_INLINE
+  ulong64 matchEmpty() const
+  {
+    return uint(_mm_movemask_epi8(ctrl_));
+  }
+
+#else
+
+  /// Bit index to slot offset shift.
+  static const int SHIFT = 0;
+
+private:
+
+  ubyte ctrl_[SIZE]; ///< Control bytes.
+
+public:
+
+  /**
+   * Load `SIZE` control bytes starting at a given address.
+   */
+  OZ_ALWAYS_INLINE
+  explicit FlatGroup(const ubyte* ctrl)
+  {
+    __builtin_memcpy(ctrl_, ctrl, SIZE);
+  }
+
+  /**
+   * Mask of slots whose control byte equals `h2`.
+   */
+  ulong64 match(ubyte h2) const
+  {
+    ulong64 mask = 0;
+
+    for (int i = 0; i < SIZE; ++i) {
+      mask |= ulong64(ctrl_[i] == h2) << i;
+    }
+    return mask;
+  }
+
+  /**
+   * Mask of empty slots.
+   */
+  ulong64 matchEmpty() const
+  {
+    return match(EMPTY);
+  }
+
+#endif
+
+  /**
+   * Slot offset of the lowest bit set in a non-empty mask.
+   */
+  OZ_ALWAYS_INLINE
+  static int index(ulong64 mask)
+  {
+    return __builtin_ctzll(mask) >> SHIFT;
+  }
+
+};
+
+}
+
+/**
+ * Open-addressing hashtable implementation, containing only keys without values.
+ *
+ * Elements are stored in a flat array of slots with a parallel array of control bytes, which holds
+ * 7 hash bits for each occupied slot. Lookups probe `detail::FlatGroup::SIZE` control bytes at once
+ * (with SSE2 or NEON where available) and only compare elements whose hash bits match.
+ *
+ * Linear probing is used and runs never wrap around; they may overflow into a tail of extra slots
+ * past the last home slot instead, which is extended when needed. Removal shifts the following
+ * elements of the run backward, so there are no tombstones and lookups never slow down after many
+ * removals. Iteration goes from the last slot to the first, hence an element may be removed while
+ * iterating as long as the iterator has already been advanced past it.
+ *
+ * Like in `List` all allocated elements are constructed all the time. A removed element is
+ * destroyed and a default-constructed one takes its place. Memory is allocated when the first
+ * element is added. The number of home slots is a power of two and it is doubled when more than 3/4
+ * of them are used.
+ *
+ * @sa `oz::FlatHashMap`, `oz::HashSet`
+ */
+template <typename Elem, class HashFunc = Hash<Elem>>
+class FlatHashSet
+{
+protected:
+
+  /// Minimum number of home slots.
+  static const int MIN_CAPACITY = 16;
+
+  /**
+   * Element slot.
+   */
+  struct Slot
+  {
+    Elem elem; ///< Element (or key-value pair).
+    uint hash; ///< Cached (mixed) hash.
+  };
+
+  /**
+   * Flat hashtable iterator.
+   */
+  template <typename ElemType>
+  class FlatIterator : public detail::IteratorBase<ElemType>
+  {
+  private:
+
+    using detail::IteratorBase<ElemType>::elem_;
+
+    const FlatHashSet* table_ = nullptr; ///< Hashtable that is being iterated.
+    int                index_ = 0;       ///< Index of the current slot.
+
+  public:
+
+    /**
+     * Create an invalid iterator.
+     */
+    FlatIterator() = default;
+
+    /**
+     * Create hashtable iterator, initially pointing to the last occupied slot.
+     */
+    explicit FlatIterator(const FlatHashSet& table)
+      : detail::IteratorBase<ElemType>(nullptr), table_(&table), index_(table.slotCount_)
+    {
+      operator++();
+    }
+
+    /**
+     * Advance to the next element.
+     */
+    FlatIterator& operator++()
+    {
+      do {
+        --index_;
+      }
+      while (index_ >= 0 && table_->ctrl_[index_] == detail::FlatGroup::EMPTY);
+
+      elem_ = index_ < 0 ? nullptr : &table_->slots_[index_].elem;
+      return *this;
+    }
+
+    /**
+     * STL-style begin iterator.
+     */
+    OZ_ALWAYS_INLINE
+    FlatIterator begin() const
+    {
+      return *this;
+    }
+
+    /**
+     * STL-style end iterator.
+     */
+    OZ_ALWAYS_INLINE
+    FlatIterator end() const
+    {
+      return FlatIterator();
+    }
+
+  };
+
+public:
+
+  /**
+   * %Iterator with constant access to elements.
+   */
+  typedef FlatIterator<const Elem> CIterator;
+
+  /**
+   * %Iterator with non-constant access to elements.
+   */
+  typedef FlatIterator<Elem> Iterator;
+
+protected:
+
+  ubyte* ctrl_      = nullptr; ///< Control bytes, followed by a group of `EMPTY` sentinels.
+  Slot*  slots_     = nullptr; ///< Array of slots.
+  int    size_      = 0;       ///< Number of elements.
+  int    capacity_  = 0;       ///< Number of home slots, a power of two.
+  int    slotCount_ = 0;       ///< Number of home slots plus overflow tail.
+
+protected:
+
+  /**
+   * Scramble a hash so that its low bits can be used as control byte and the rest as home index.
+   */
+  OZ_ALWAYS_INLINE
+  static uint mix(int hash)
+  {
+    uint h = uint(hash) * 0x9e3779b1u;
+    return h ^ (h >> 16);
+  }
+
+  /**
+   * Destroy an element and construct a default one in its place.
+   *
+   * Unlike assigning `Elem()` this guarantees the removed element's destructor is run.
+   */
+  OZ_ALWAYS_INLINE
+  static void reset(Elem& elem)
+  {
+    elem.~Elem();
+    new(&elem) Elem();
+  }
+
+  /**
+   * Home slot for a mixed hash.
+   */
+  OZ_ALWAYS_INLINE
+  int home(uint h) const
+  {
+    return int((h >> 7) & uint(capacity_ - 1));
+  }
+
+  /**
+   * Find the slot that contains an element matching a given key.
+   *
+   * @return Index of the matching slot or `~index` of the first empty slot in the probed run. The
+   * latter may lie in the sentinel group past `slotCount_`.
+   */
+  template <typename Key>
+  int probe(const Key& key, uint h) const
+  {
+    ubyte h2  = ubyte(h & 0x7f);
+    int   pos = home(h);
+
+    while (true) {
+      detail::FlatGroup group(ctrl_ + pos);
+
+      ulong64 matches = group.match(h2);
+      ulong64 empty   = group.matchEmpty();
+
+      // Only slots before the first empty one belong to the run.
+      if (empty != 0) {
+        matches &= (empty & (0 - empty)) - 1;
+      }
+
+      for (; matches != 0; matches &= matches - 1) {
+        int i = pos + detail::FlatGroup::index(matches);
+
+        if (slots_[i].elem == key) {
+          return i;
+        }
+      }
+
+      if (empty != 0) {
+        return ~(pos + detail::FlatGroup::index(empty));
+      }
+      pos += detail::FlatGroup::SIZE;
+    }
+  }
+
+  /**
+   * Index of the first empty slot in a run for a given hash.
+   */
+  int findEmpty(uint h) const
+  {
+    int pos = home(h);
+
+    while (true) {
+      ulong64 empty = detail::FlatGroup(ctrl_ + pos).matchEmpty();
+
+      if (empty != 0) {
+        return pos + detail::FlatGroup::index(empty);
+      }
+      pos += detail::FlatGroup::SIZE;
+    }
+  }
+
+  /**
+   * Extend the overflow tail, so at least one more group of slots fits past the current end.
+   */
+  void extendTail()
+  {
+    int newCount = slotCount_ + max<int>(int(detail::FlatGroup::SIZE), slotCount_ - capacity_);
+    ubyte* newCtrl = new ubyte[newCount + detail::FlatGroup::SIZE];
+
+    __builtin_memcpy(newCtrl, ctrl_, size_t(slotCount_));
+    __builtin_memset(newCtrl + slotCount_, detail::FlatGroup::EMPTY,
+                     size_t(newCount - slotCount_ + detail::FlatGroup::SIZE));
+    delete[] ctrl_;
+
+    ctrl_      = newCtrl;
+    slots_     = Arrays::reallocate<Slot>(slots_, slotCount_, newCount);
+    slotCount_ = newCount;
+  }
+
+  /**
+   * Mark an empty slot (as returned by `probe()` or `findEmpty()`) occupied.
+   */
+  Slot& claim(int i, uint h)
+  {
+    if (i >= slotCount_) {
+      extendTail();
+    }
+
+    ctrl_[i]       = ubyte(h & 0x7f);
+    slots_[i].hash = h;
+    ++size_;
+
+    return slots_[i];
+  }
+
+  /**
+   * Remove the element from a given slot and shift the rest of the run backward.
+   */
+  void erase(int i)
+  {
+    int hole = i;
+
+    reset(slots_[i].elem);
+
+    // Sentinels guarantee that the loop terminates.
+    for (int j = i + 1; ctrl_[j] != detail::FlatGroup::EMPTY; ++j) {
+      if (home(slots_[j].hash) <= hole) {
+        slots_[hole] = static_cast<Slot&&>(slots_[j]);
+        ctrl_[hole]  = ctrl_[j];
+        hole         = j;
+      }
+    }
+
+    ctrl_[hole] = detail::FlatGroup::EMPTY;
+    reset(slots_[hole].elem);
+    --size_;
+  }
+
+  /**
+   * Rebuild hashtable with a given number of home slots (0 or a power of two).
+   */
+  void resize(int newCapacity)
+  {
+    ubyte* oldCtrl  = ctrl_;
+    Slot*  oldSlots = slots_;
+    int    oldCount = slotCount_;
+
+    ctrl_      = nullptr;
+    slots_     = nullptr;
+    size_      = 0;
+    capacity_  = newCapacity;
+    slotCount_ = 0;
+
+    if (newCapacity != 0) {
+      slotCount_ = newCapacity + detail::FlatGroup::SIZE;
+      ctrl_      = new ubyte[slotCount_ + detail::FlatGroup::SIZE];
+      slots_     = new Slot[slotCount_] {};
+
+      __builtin_memset(ctrl_, detail::FlatGroup::EMPTY,
+                       size_t(slotCount_ + detail::FlatGroup::SIZE));
+
+      for (int i = 0; i < oldCount; ++i) {
+        if (oldCtrl[i] != detail::FlatGroup::EMPTY) {
+          uint h = oldSlots[i].hash;
+
+          claim(findEmpty(h), h).elem = static_cast<Elem&&>(oldSlots[i].elem);
+        }
+      }
+    }
+
+    delete[] oldCtrl;
+    delete[] oldSlots;
+  }
+
+  /**
+   * Ensure there are enough home slots for a given number of elements.
+   *
+   * The number of home slots is doubled until load factor drops to 3/4 or less, initially it is
+   * `MIN_CAPACITY`.
+   */
+  void ensureCapacity(int requestedSize)
+  {
+    if (requestedSize < 0) {
+      OZ_ERROR("oz::FlatHashSet: Capacity overflow");
+    }
+    else if (capacity_ / 4 * 3 < requestedSize) {
+      int newCapacity = capacity_ == 0 ? MIN_CAPACITY : capacity_ * 2;
+
+      while (newCapacity / 4 * 3 < requestedSize) {
+        newCapacity *= 2;
+      }
+      resize(newCapacity);
+    }
+  }
+
+  /**
+   * Allocate and copy control bytes and slots of another hashtable.
+   */
+  void copyStorage(const FlatHashSet& other)
+  {
+    ctrl_      = nullptr;
+    slots_     = nullptr;
+    size_      = other.size_;
+    capacity_  = other.capacity_;
+    slotCount_ = other.slotCount_;
+
+    if (slotCount_ != 0) {
+      ctrl_  = new ubyte[slotCount_ + detail::FlatGroup::SIZE];
+      slots_ = new Slot[slotCount_];
+
+      __builtin_memcpy(ctrl_, other.ctrl_, size_t(slotCount_ + detail::FlatGroup::SIZE));
+      Arrays::copy<Slot>(other.slots_, slotCount_, slots_);
+    }
+  }
+
+  /**
+   * Insert an element, optionally overwriting an existing one.
+   *
+   * This is a helper function to reduce code duplication between `add()` and `include()`.
+   */
+  template <typename Elem_>
+  Elem& insert(Elem_&& elem, bool overwrite)
+  {
+    ensureCapacity(size_ + 1);
+
+    uint h = mix(HashFunc()(elem));
+    int  i = probe(elem, h);
+
+    if (i >= 0) {
+      if (overwrite) {
+        slots_[i].elem = static_cast<Elem_&&>(elem);
+      }
+      return slots_[i].elem;
+    }
+
+    Slot& slot = claim(~i, h);
+
+    slot.elem = static_cast<Elem_&&>(elem);
+    return slot.elem;
+  }
+
+public:
+
+  /**
+   * Create an empty hashtable.
+   */
+  FlatHashSet() = default;
+
+  /**
+   * Create an empty hashtable with enough pre-allocated slots for a given number of elements.
+   */
+  explicit FlatHashSet(int capacity)
+  {
+    ensureCapacity(capacity);
+  }
+
+  /**
+   * Initialise from an initialiser list.
+   */
+  FlatHashSet(InitialiserList<Elem> il)
+    : FlatHashSet(int(il.size()))
+  {
+    for (const Elem& e : il) {
+      add(e);
+    }
+  }
+
+  /**
+   * Destructor.
+   */
+  ~FlatHashSet()
+  {
+    delete[] ctrl_;
+    delete[] slots_;
+  }
+
+  /**
+   * Copy constructor, copies slot arrays.
+   */
+  FlatHashSet(const FlatHashSet& other)
+  {
+    copyStorage(other);
+  }
+
+  /**
+   * Move constructor, moves storage.
+   */
+  FlatHashSet(FlatHashSet&& other) noexcept
+    : ctrl_(other.ctrl_), slots_(other.slots_), size_(other.size_), capacity_(other.capacity_),
+      slotCount_(other.slotCount_)
+  {
+    other.ctrl_      = nullptr;
+    other.slots_     = nullptr;
+    other.size_      = 0;
+    other.capacity_  = 0;
+    other.slotCount_ = 0;
+  }
+
+  /**
+   * Copy operator, copies slot arrays.
+   */
+  FlatHashSet& operator=(const FlatHashSet& other)
+  {
+    if (&other != this) {
+      delete[] ctrl_;
+      delete[] slots_;
+
+      copyStorage(other);
+    }
+    return *this;
+  }
+
+  /**
+   * Move operator, moves storage.
+   */
+  FlatHashSet& operator=(FlatHashSet&& other) noexcept
+  {
+    if (&other != this) {
+      delete[] ctrl_;
+      delete[] slots_;
+
+      ctrl_      = other.ctrl_;
+      slots_     = other.slots_;
+      size_      = other.size_;
+      capacity_  = other.capacity_;
+      slotCount_ = other.slotCount_;
+
+      other.ctrl_      = nullptr;
+      other.slots_     = nullptr;
+      other.size_      = 0;
+      other.capacity_  = 0;
+      other.slotCount_ = 0;
+    }
+    return *this;
+  }
+
+  /**
+   * Assign from an initialiser list.
+   */
+  FlatHashSet& operator=(InitialiserList<Elem> il)
+  {
+    clear();
+    ensureCapacity(int(il.size()));
+
+    for (const Elem& e : il) {
+      add(e);
+    }
+    return *this;
+  }
+
+  /**
+   * True iff contained elements are equal.
+   */
+  bool operator==(const FlatHashSet& other) const
+  {
+    if (size_ != other.size_) {
+      return false;
+    }
+
+    for (const Elem& e : *this) {
+      if (!other.contains(e)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * False iff contained elements are equal.
+   */
+  bool operator!=(const FlatHashSet& other) const
+  {
+    return !operator==(other);
+  }
+
+  /**
+   * %Iterator with constant access, initially points to the first element.
+   */
+  OZ_ALWAYS_INLINE
+  CIterator citerator() const
+  {
+    return CIterator(*this);
+  }
+
+  /**
+   * %Iterator with non-constant access, initially points to the first element.
+   */
+  OZ_ALWAYS_INLINE
+  Iterator iterator()
+  {
+    return Iterator(*this);
+  }
+
+  /**
+   * STL-style constant begin iterator.
+   */
+  OZ_ALWAYS_INLINE
+  CIterator begin() const
+  {
+    return CIterator(*this);
+  }
+
+  /**
+   * STL-style begin iterator.
+   */
+  OZ_ALWAYS_INLINE
+  Iterator begin()
+  {
+    return Iterator(*this);
+  }
+
+  /**
+   * STL-style constant end iterator.
+   */
+  OZ_ALWAYS_INLINE
+  CIterator end() const
+  {
+    return CIterator();
+  }
+
+  /**
+   * STL-style end iterator.
+   */
+  OZ_ALWAYS_INLINE
+  Iterator end()
+  {
+    return Iterator();
+  }
+
+  /**
+   * Number of elements.
+   */
+  OZ_ALWAYS_INLINE
+  int size() const
+  {
+    return size_;
+  }
+
+  /**
+   * True iff empty.
+   */
+  OZ_ALWAYS_INLINE
+  bool isEmpty() const
+  {
+    return size_ == 0;
+  }
+
+  /**
+   * Number of home slots.
+   */
+  OZ_ALWAYS_INLINE
+  int capacity() const
+  {
+    return capacity_;
+  }
+
+  /**
+   * Number of all slots, including overflow tail.
+   */
+  OZ_ALWAYS_INLINE
+  int slotCount() const
+  {
+    return slotCount_;
+  }
+
+  /**
+   * True iff an element matching a given key is found in the hashtable.
+   */
+  template <typename Key>
+  bool contains(const Key& key) const
+  {
+    return size_ != 0 && probe(key, mix(HashFunc()(key))) >= 0;
+  }
+
+  /**
+   * Add a new element, if the element already exists in the hashtable overwrite the existing one.
+   */
+  template <typename Elem_>
+  Elem& add(Elem_&& elem)
+  {
+    return insert(static_cast<Elem_&&>(elem), true);
+  }
+
+  /**
+   * Add a new element if it does not exist in the hashtable.
+   */
+  template <typename Elem_>
+  Elem& include(Elem_&& elem)
+  {
+    return insert(static_cast<Elem_&&>(elem), false);
+  }
+
+  /**
+   * Remove the element that matches a given key.
+   *
+   * @return True iff the element was found (and removed).
+   */
+  template <typename Key>
+  bool exclude(const Key& key)
+  {
+    if (size_ == 0) {
+      return false;
+    }
+
+    int i = probe(key, mix(HashFunc()(key)));
+
+    if (i >= 0) {
+      erase(i);
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Trim the number of home slots to the smallest power of two that can hold current elements.
+   *
+   * In case the hashtable contains no elements all its storage gets deallocated.
+   */
+  void trim()
+  {
+    int newCapacity = 0;
+
+    if (size_ != 0) {
+      newCapacity = MIN_CAPACITY;
+
+      while (newCapacity / 4 * 3 < size_) {
+        newCapacity *= 2;
+      }
+    }
+
+    if (newCapacity < capacity_ || slotCount_ - capacity_ > detail::FlatGroup::SIZE) {
+      resize(newCapacity);
+    }
+  }
+
+  /**
+   * Clear the hashtable.
+   */
+  void clear()
+  {
+    for (int i = 0; i < slotCount_ && size_ != 0; ++i) {
+      if (ctrl_[i] != detail::FlatGroup::EMPTY) {
+        ctrl_[i] = detail::FlatGroup::EMPTY;
+        reset(slots_[i].elem);
+        --size_;
+      }
+    }
+  }
+
+};
+
+}
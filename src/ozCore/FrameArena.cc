@@ -0,0 +1,109 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "FrameArena.hh"
+
+namespace oz
+{
+
+struct FrameArena::Block
+{
+  Block* prev;
+  size_t size;
+
+  OZ_INTERNAL
+  static Block* create(size_t size, Block* prev)
+  {
+    char*  chunk = new char[Alloc::alignUp(sizeof(Block)) + size];
+    Block* block = new(chunk) Block;
+
+    block->prev = prev;
+    block->size = size;
+
+    return block;
+  }
+
+  OZ_INTERNAL
+  void destroy()
+  {
+    delete[] reinterpret_cast<char*>(this);
+  }
+
+  OZ_INTERNAL
+  OZ_ALWAYS_INLINE
+  char* data()
+  {
+    return reinterpret_cast<char*>(this) + Alloc::alignUp(sizeof(Block));
+  }
+};
+
+void FrameArena::addBlock(size_t size)
+{
+  size_t newSize = block_ == nullptr ? blockSize_ : 2 * block_->size;
+
+  while (newSize < size) {
+    newSize *= 2;
+  }
+
+  block_      = Block::create(newSize, block_);
+  data_       = block_->data();
+  capacity_   = newSize;
+  offset_     = 0;
+  lastOffset_ = 0;
+}
+
+FrameArena::FrameArena(size_t blockSize)
+  : blockSize_(Alloc::alignUp(max<size_t>(blockSize, OZ_ALIGNMENT)))
+{}
+
+FrameArena::~FrameArena()
+{
+  while (block_ != nullptr) {
+    Block* prev = block_->prev;
+
+    block_->destroy();
+    block_ = prev;
+  }
+}
+
+FrameArena& FrameArena::local()
+{
+  static thread_local FrameArena arena;
+  return arena;
+}
+
+void FrameArena::reset()
+{
+  if (block_ != nullptr) {
+    while (block_->prev != nullptr) {
+      Block* prev = block_->prev;
+
+      block_->prev = prev->prev;
+      prev->destroy();
+    }
+  }
+
+  offset_     = 0;
+  lastOffset_ = 0;
+}
+
+}
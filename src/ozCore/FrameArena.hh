@@ -0,0 +1,251 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file ozCore/FrameArena.hh
+ *
+ * `FrameArena` class and `FrameAllocator` policy for `List`.
+ */
+
+#pragma once
+
+#include "Alloc.hh"
+#include "List.hh"
+
+namespace oz
+{
+
+/**
+ * Bump-pointer allocator for transient per-tick data.
+ *
+ * Allocation just advances an offset in the current memory block and individual allocations are
+ * never freed, the whole arena is rewound by `reset()` instead. When a block is exhausted a new one
+ * of double size is added; the exhausted blocks are freed on the next `reset()`, so after the first
+ * few ticks the arena settles with a single block that fits the whole tick and neither allocation
+ * nor `reset()` touches the heap any more.
+ *
+ * Each thread has its own arena, `local()`, which is meant to be reset by the thread's main loop at
+ * the beginning of each tick. Nothing allocated from an arena may be accessed after its reset and
+ * destructors are never invoked by the arena itself.
+ *
+ * @sa `oz::FrameAllocator`, `oz::FrameList`
+ */
+class FrameArena
+{
+public:
+
+  /// Size of the first memory block.
+  static const size_t DEFAULT_SIZE = 256 * 1024;
+
+private:
+
+  struct Block;
+
+  Block* block_      = nullptr; ///< Current block, chained with exhausted ones.
+  char*  data_       = nullptr; ///< Storage of the current block.
+  size_t capacity_   = 0;       ///< Size of the current block.
+  size_t offset_     = 0;       ///< Offset of free space in the current block.
+  size_t lastOffset_ = 0;       ///< Offset of the last allocation in the current block.
+  size_t blockSize_;            ///< Size of the first block.
+
+private:
+
+  /**
+   * Add a new block of at least a given size.
+   */
+  void addBlock(size_t size);
+
+public:
+
+  /**
+   * Create an empty arena, storage is allocated on the first allocation.
+   */
+  explicit FrameArena(size_t blockSize = DEFAULT_SIZE);
+
+  /**
+   * Destructor, frees all blocks.
+   */
+  ~FrameArena();
+
+  /**
+   * No copying.
+   */
+  FrameArena(const FrameArena&) = delete;
+
+  /**
+   * No copying.
+   */
+  FrameArena& operator=(const FrameArena&) = delete;
+
+  /**
+   * Arena for the current thread.
+   */
+  static FrameArena& local();
+
+  /**
+   * Size of the current block.
+   */
+  OZ_ALWAYS_INLINE
+  size_t capacity() const
+  {
+    return capacity_;
+  }
+
+  /**
+   * Bytes used in the current block.
+   */
+  OZ_ALWAYS_INLINE
+  size_t used() const
+  {
+    return offset_;
+  }
+
+  /**
+   * Allocate uninitialised memory, aligned to `OZ_ALIGNMENT`.
+   */
+  OZ_ALWAYS_INLINE
+  void* allocate(size_t size)
+  {
+    size = Alloc::alignUp(size);
+
+    if (offset_ + size > capacity_) {
+      addBlock(size);
+    }
+
+    lastOffset_ = offset_;
+    offset_    += size;
+
+    return data_ + lastOffset_;
+  }
+
+  /**
+   * Resize the last allocation in place.
+   *
+   * @return False iff `ptr` is not the last allocation or there is not enough space left.
+   */
+  OZ_ALWAYS_INLINE
+  bool resize(void* ptr, size_t newSize)
+  {
+    newSize = Alloc::alignUp(newSize);
+
+    if (ptr != data_ + lastOffset_ || lastOffset_ + newSize > capacity_) {
+      return false;
+    }
+
+    offset_ = lastOffset_ + newSize;
+    return true;
+  }
+
+  /**
+   * Free the last allocation, does nothing if `ptr` is not the last allocation.
+   *
+   * This reclaims memory of short-lived scoped allocations, so an arena doesn't grow even on a
+   * thread that never resets it as long as such allocations are nested.
+   */
+  OZ_ALWAYS_INLINE
+  void release(void* ptr)
+  {
+    if (ptr == data_ + lastOffset_) {
+      offset_ = lastOffset_;
+    }
+  }
+
+  /**
+   * Discard all allocations.
+   *
+   * Blocks that have been exhausted during the previous tick are freed, the current one is kept.
+   */
+  void reset();
+
+};
+
+/**
+ * `List` storage policy that allocates element arrays from the thread's `FrameArena`.
+ *
+ * Growing a list whose array is the last allocation in the arena extends it in place, otherwise a
+ * new array is allocated and the old one is abandoned until the arena is reset. Likewise, only the
+ * last allocation is reclaimed when a list is destroyed. Such lists must be
+ * destroyed or trimmed to zero capacity before their thread's arena is reset.
+ */
+struct FrameAllocator
+{
+  /**
+   * Reallocate an array of `capacity` elements to `newCapacity` elements, moving first `size`
+   * elements.
+   */
+  template <typename Elem>
+  static Elem* reallocate(Elem* array, int size, int capacity, int newCapacity)
+  {
+    FrameArena& arena = FrameArena::local();
+
+    if (newCapacity == 0) {
+      deallocate<Elem>(array, capacity);
+      return nullptr;
+    }
+
+    if (array != nullptr && arena.resize(array, size_t(newCapacity) * sizeof(Elem))) {
+      for (int i = capacity; i < newCapacity; ++i) {
+        new(&array[i]) Elem {};
+      }
+      for (int i = newCapacity; i < capacity; ++i) {
+        array[i].~Elem();
+      }
+      return array;
+    }
+
+    Elem* newArray = static_cast<Elem*>(arena.allocate(size_t(newCapacity) * sizeof(Elem)));
+
+    for (int i = 0; i < newCapacity; ++i) {
+      new(&newArray[i]) Elem {};
+    }
+
+    Arrays::move<Elem>(array, min<int>(size, newCapacity), newArray);
+    deallocate<Elem>(array, capacity);
+
+    return newArray;
+  }
+
+  /**
+   * Destroy an array of `capacity` elements.
+   *
+   * Memory is reclaimed immediately if the array is the last allocation in the arena, otherwise on
+   * `FrameArena::reset()`.
+   */
+  template <typename Elem>
+  static void deallocate(Elem* array, int capacity)
+  {
+    if (array != nullptr) {
+      for (int i = 0; i < capacity; ++i) {
+        array[i].~Elem();
+      }
+      FrameArena::local().release(array);
+    }
+  }
+};
+
+/**
+ * `List` with storage allocated from the thread's `FrameArena`.
+ */
+template <typename Elem>
+using FrameList = List<Elem, FrameAllocator>;
+
+}
@@ -0,0 +1,89 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "Futex.hh"
+
+#if defined(__linux__) && !defined(__native_client__)
+# include <linux/futex.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#else
+# include <pthread.h>
+#endif
+
+namespace oz
+{
+
+#if defined(__linux__) && !defined(__native_client__)
+
+void Futex::wait(const Atomic<int>* address, int expected)
+{
+  syscall(SYS_futex, &address->value, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+void Futex::wake(const Atomic<int>* address, int count)
+{
+  syscall(SYS_futex, &address->value, FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+#else
+
+struct ParkingBucket
+{
+  pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+  pthread_cond_t  cond  = PTHREAD_COND_INITIALIZER;
+};
+
+static const int     N_BUCKETS = 64;
+static ParkingBucket buckets[N_BUCKETS];
+
+static ParkingBucket& bucket(const Atomic<int>* address)
+{
+  return buckets[(size_t(address) / sizeof(int)) % N_BUCKETS];
+}
+
+void Futex::wait(const Atomic<int>* address, int expected)
+{
+  ParkingBucket& b = bucket(address);
+
+  pthread_mutex_lock(&b.mutex);
+
+  if (address->load<ATOMIC_SEQ_CST>() == expected) {
+    pthread_cond_wait(&b.cond, &b.mutex);
+  }
+
+  pthread_mutex_unlock(&b.mutex);
+}
+
+void Futex::wake(const Atomic<int>* address, int)
+{
+  ParkingBucket& b = bucket(address);
+
+  // Buckets are shared between addresses, so all waiters have to be woken.
+  pthread_mutex_lock(&b.mutex);
+  pthread_cond_broadcast(&b.cond);
+  pthread_mutex_unlock(&b.mutex);
+}
+
+#endif
+
+}
@@ -0,0 +1,85 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file ozCore/Futex.hh
+ *
+ * `Futex` class.
+ */
+
+#pragma once
+
+#include "Atomic.hh"
+
+namespace oz
+{
+
+/**
+ * Waiting on and waking threads by the address of an atomic integer.
+ *
+ * This is the primitive beneath `Mutex`, `RWLock` and `PhaseBarrier`. On Linux it maps directly to
+ * `futex(2)` with process-private operations. Elsewhere waiting threads are parked in a small table
+ * of condition variables hashed by address, which gives the same semantics with more spurious
+ * wake-ups.
+ *
+ * As with futexes, `wait()` may return spuriously, so callers must re-check the value in a loop.
+ *
+ * @sa `oz::Mutex`, `oz::RWLock`, `oz::PhaseBarrier`
+ */
+class Futex
+{
+public:
+
+  /**
+   * Block until woken if the value still equals `expected`, return immediately otherwise.
+   */
+  static void wait(const Atomic<int>* address, int expected);
+
+  /**
+   * Wake up to `count` threads waiting on a given address.
+   */
+  static void wake(const Atomic<int>* address, int count);
+
+  /**
+   * Wake all threads waiting on a given address.
+   */
+  static void wakeAll(const Atomic<int>* address)
+  {
+    wake(address, INT_MAX);
+  }
+
+  /**
+   * Hint to the processor that the current thread is spinning.
+   */
+  OZ_ALWAYS_INLINE
+  static void pause()
+  {
+#if defined(__ARM_ACLE__)
+    __builtin_arm_yield();
+#elif defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#endif
+  }
+
+};
+
+}
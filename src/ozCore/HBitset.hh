@@ -0,0 +1,345 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file ozCore/HBitset.hh
+ *
+ * `HBitset` class.
+ */
+
+#pragma once
+
+#include "Alloc.hh"
+
+namespace oz
+{
+
+/**
+ * Two-level bit array with static storage for scanning sparse sets.
+ *
+ * Besides the bits themselves it keeps a summary with one bit per unit that is true iff that unit
+ * is non-zero. Scans therefore skip an empty unit (64 bits) with one test and a whole empty summary
+ * unit (4096 bits) with another, so walking true bits costs proportionally to the number of
+ * non-empty units rather than to the size. `clear()` only zeroes units that are marked non-empty.
+ *
+ * @sa `oz::SBitset`
+ */
+template <int BITS>
+class HBitset
+{
+  static_assert(BITS > 0, "oz::HBitset length must be at least 1");
+
+private:
+
+  /// Number of bits per the internal unit.
+  static const int UNIT_BITS = sizeof(size_t) * 8;
+
+  /// Number of bits per the platfrom-independent unit.
+  static const int PORT_BITS = sizeof(ulong64) * 8;
+
+  /// Number of units.
+  static const int SIZE = Alloc::alignUp<int>(BITS, PORT_BITS) / UNIT_BITS;
+
+  /// Number of summary units.
+  static const int SUMMARY_SIZE = (SIZE + UNIT_BITS - 1) / UNIT_BITS;
+
+private:
+
+  size_t data_[SIZE];            ///< Bit storage.
+  size_t summary_[SUMMARY_SIZE]; ///< Bit per unit, true iff the unit is non-zero.
+
+public:
+
+  /**
+   * Initialise all bits to zero.
+   */
+  HBitset()
+  {
+    Arrays::fill<size_t, size_t>(data_, SIZE, 0);
+    Arrays::fill<size_t, size_t>(summary_, SUMMARY_SIZE, 0);
+  }
+
+  /**
+   * True iff all bits are equal.
+   */
+  bool operator==(const HBitset& other) const
+  {
+    return Arrays::equals<size_t>(data_, SIZE, other.data_);
+  }
+
+  /**
+   * True any bit differ.
+   */
+  bool operator!=(const HBitset& other) const
+  {
+    return !operator==(other);
+  }
+
+  /**
+   * Constant pointer to the first unit.
+   */
+  OZ_ALWAYS_INLINE
+  const size_t* begin() const
+  {
+    return data_;
+  }
+
+  /**
+   * Constant pointer past the last unit.
+   */
+  OZ_ALWAYS_INLINE
+  const size_t* end() const
+  {
+    return data_ + SIZE;
+  }
+
+  /**
+   * Size in bits.
+   */
+  OZ_ALWAYS_INLINE
+  int size() const
+  {
+    return SIZE * UNIT_BITS;
+  }
+
+  /**
+   * True iff at least one bit is true.
+   */
+  bool isAnySet() const
+  {
+    for (int i = 0; i < SUMMARY_SIZE; ++i) {
+      if (summary_[i] != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * True iff all bits are false.
+   */
+  bool isNoneSet() const
+  {
+    return !isAnySet();
+  }
+
+  /**
+   * Number of true bits.
+   */
+  int count() const
+  {
+    int n = 0;
+
+    forEachUnit([&n](int, size_t bits)
+    {
+      n += __builtin_popcountll(bits);
+    });
+    return n;
+  }
+
+  /**
+   * Get the `i`-th bit.
+   */
+  OZ_ALWAYS_INLINE
+  bool get(int i) const
+  {
+    return (data_[i / UNIT_BITS] & (size_t(1) << (i % UNIT_BITS))) != 0;
+  }
+
+  /**
+   * %Set the `i`-th bit to true.
+   */
+  OZ_ALWAYS_INLINE
+  void set(int i)
+  {
+    int unit = i / UNIT_BITS;
+
+    data_[unit] |= size_t(1) << (i % UNIT_BITS);
+    summary_[unit / UNIT_BITS] |= size_t(1) << (unit % UNIT_BITS);
+  }
+
+  /**
+   * %Set the `i`-th bit to false.
+   */
+  OZ_ALWAYS_INLINE
+  void clear(int i)
+  {
+    int unit = i / UNIT_BITS;
+
+    data_[unit] &= ~(size_t(1) << (i % UNIT_BITS));
+
+    if (data_[unit] == 0) {
+      summary_[unit / UNIT_BITS] &= ~(size_t(1) << (unit % UNIT_BITS));
+    }
+  }
+
+  /**
+   * %Set all bits to false.
+   */
+  void clear()
+  {
+    for (int i = 0; i < SUMMARY_SIZE; ++i) {
+      size_t bits = summary_[i];
+
+      while (bits != 0) {
+        data_[i * UNIT_BITS + __builtin_ctzll(bits)] = 0;
+        bits &= bits - 1;
+      }
+      summary_[i] = 0;
+    }
+  }
+
+  /**
+   * Index of the first true bit at position `i` or after it, -1 if there is none.
+   */
+  int findNextSet(int i) const
+  {
+    int unit = i / UNIT_BITS;
+
+    if (unit >= SIZE) {
+      return -1;
+    }
+
+    size_t bits = data_[unit] & (~size_t(0) << (i % UNIT_BITS));
+
+    if (bits != 0) {
+      return unit * UNIT_BITS + __builtin_ctzll(bits);
+    }
+
+    // Find the next non-empty unit via summary.
+    ++unit;
+
+    int summaryUnit = unit / UNIT_BITS;
+
+    if (summaryUnit >= SUMMARY_SIZE) {
+      return -1;
+    }
+
+    size_t summaryBits = summary_[summaryUnit] & (~size_t(0) << (unit % UNIT_BITS));
+
+    while (summaryBits == 0) {
+      if (++summaryUnit == SUMMARY_SIZE) {
+        return -1;
+      }
+      summaryBits = summary_[summaryUnit];
+    }
+
+    unit = summaryUnit * UNIT_BITS + __builtin_ctzll(summaryBits);
+    return unit * UNIT_BITS + __builtin_ctzll(data_[unit]);
+  }
+
+  /**
+   * Call `func(i)` for index of each true bit in ascending order.
+   */
+  template <typename Func>
+  void forEachSet(Func func) const
+  {
+    forEachUnit([&func](int unit, size_t bits)
+    {
+      do {
+        func(unit * UNIT_BITS + __builtin_ctzll(bits));
+        bits &= bits - 1;
+      }
+      while (bits != 0);
+    });
+  }
+
+  /**
+   * Call `func(unit, bits)` for each non-zero unit in ascending order.
+   *
+   * Bit `j` in `bits` represents the bitset's bit `unit * 64 + j` (`unit * 32 + j` on 32-bit
+   * platforms).
+   */
+  template <typename Func>
+  void forEachUnit(Func func) const
+  {
+    for (int i = 0; i < SUMMARY_SIZE; ++i) {
+      size_t summaryBits = summary_[i];
+
+      while (summaryBits != 0) {
+        int unit = i * UNIT_BITS + __builtin_ctzll(summaryBits);
+
+        func(unit, data_[unit]);
+        summaryBits &= summaryBits - 1;
+      }
+    }
+  }
+
+  /**
+   * Replace a unit, used to restore the bitset from serialised units.
+   */
+  void setUnit(int unit, size_t bits)
+  {
+    size_t summaryBit = size_t(1) << (unit % UNIT_BITS);
+
+    data_[unit] = bits;
+
+    if (bits != 0) {
+      summary_[unit / UNIT_BITS] |= summaryBit;
+    }
+    else {
+      summary_[unit / UNIT_BITS] &= ~summaryBit;
+    }
+  }
+
+  /**
+   * OR of two bitsets, touches only non-empty units of `b`.
+   */
+  HBitset& operator|=(const HBitset& b)
+  {
+    for (int i = 0; i < SUMMARY_SIZE; ++i) {
+      summary_[i] |= b.summary_[i];
+    }
+    b.forEachUnit([this](int unit, size_t bits)
+    {
+      data_[unit] |= bits;
+    });
+    return *this;
+  }
+
+  /**
+   * AND of two bitsets, touches only non-empty units of this bitset.
+   */
+  HBitset& operator&=(const HBitset& b)
+  {
+    forEachUnit([this, &b](int unit, size_t bits)
+    {
+      setUnit(unit, bits & b.data_[unit]);
+    });
+    return *this;
+  }
+
+  /**
+   * Clear all bits that are true in a given bitset, touches only non-empty units of `b`.
+   */
+  HBitset& andNot(const HBitset& b)
+  {
+    b.forEachUnit([this](int unit, size_t bits)
+    {
+      setUnit(unit, data_[unit] & ~bits);
+    });
+    return *this;
+  }
+
+};
+
+}
@@ -235,7 +235,7 @@ protected:
     }
     else if (capacity_ < requestedCapacity) {
       int newCapacity = capacity_ == 0 ? 8 : capacity_ + capacity_ / 2;
-      newCapacity = max<int>(capacity_, requestedCapacity);
+      newCapacity = max<int>(newCapacity, requestedCapacity);
 
       resize(newCapacity);
     }
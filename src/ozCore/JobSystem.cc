@@ -0,0 +1,336 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "JobSystem.hh"
+
+#include "Semaphore.hh"
+#include "SpinLock.hh"
+#include "System.hh"
+#include "Thread.hh"
+
+#include <cstdio>
+
+namespace oz
+{
+
+static_assert((JobSystem::QUEUE_SIZE & (JobSystem::QUEUE_SIZE - 1)) == 0,
+              "JobSystem::QUEUE_SIZE must be a power of two");
+
+/*
+ * Job queue. Its owner pushes and pops jobs at the back, other threads take them from the front.
+ */
+struct JobQueue
+{
+  SpinLock       lock;
+  uint           front = 0;
+  uint           back  = 0;
+  JobSystem::Job jobs[JobSystem::QUEUE_SIZE];
+
+  bool isEmpty()
+  {
+    lock.lock();
+    bool isEmpty = front == back;
+    lock.unlock();
+
+    return isEmpty;
+  }
+
+  bool push(const JobSystem::Job& job)
+  {
+    lock.lock();
+
+    if (back - front == uint(JobSystem::QUEUE_SIZE)) {
+      lock.unlock();
+      return false;
+    }
+
+    jobs[back & (JobSystem::QUEUE_SIZE - 1)] = job;
+    ++back;
+
+    lock.unlock();
+    return true;
+  }
+
+  bool popBack(JobSystem::Job* job)
+  {
+    lock.lock();
+
+    if (front == back) {
+      lock.unlock();
+      return false;
+    }
+
+    --back;
+    *job = jobs[back & (JobSystem::QUEUE_SIZE - 1)];
+
+    lock.unlock();
+    return true;
+  }
+
+  bool popFront(JobSystem::Job* job, bool isStealing)
+  {
+    if (isStealing) {
+      // Don't wait for a busy victim, another one may have jobs too.
+      if (!lock.tryLock()) {
+        return false;
+      }
+    }
+    else {
+      lock.lock();
+    }
+
+    if (front == back) {
+      lock.unlock();
+      return false;
+    }
+
+    *job = jobs[front & (JobSystem::QUEUE_SIZE - 1)];
+    ++front;
+
+    lock.unlock();
+    return true;
+  }
+};
+
+// Queues of workers followed by the one shared by other threads.
+static JobQueue*         queues          = nullptr;
+static JobQueue          mainQueue;
+static Thread*           workers         = nullptr;
+static int               workerCount     = 0;
+static Atomic<bool>      areWorkersAlive = {false};
+static Atomic<int>       nSleeping       = {0};
+static Semaphore         wakeSemaphore;
+static thread_local int  queueIndex      = -1;
+static thread_local uint stealSeed       = 1;
+static char              workerNames[JobSystem::MAX_WORKERS][Thread::NAME_LENGTH + 1];
+
+static bool hasQueuedJobs()
+{
+  for (int i = 0; i <= workerCount; ++i) {
+    if (!queues[i].isEmpty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool popJob(JobSystem::Job* job)
+{
+  if (queues == nullptr) {
+    return false;
+  }
+
+  int own = queueIndex < 0 ? workerCount : queueIndex;
+
+  if (queues[own].popBack(job)) {
+    return true;
+  }
+
+  // Start at a pseudo-random victim so thieves don't all contend for the same queue.
+  stealSeed = stealSeed * 1103515245u + 12345u;
+
+  int nQueues = workerCount + 1;
+  int first   = int((stealSeed >> 16) % uint(nQueues));
+
+  for (int i = 0; i < nQueues; ++i) {
+    int victim = (first + i) % nQueues;
+
+    if (victim != own && queues[victim].popFront(job, true)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+const int JobSystem::MAX_WORKERS;
+
+void JobSystem::workerMain(void* data)
+{
+  queueIndex = int(reinterpret_cast<size_t>(data));
+  stealSeed  = uint(queueIndex) * 2654435761u + 1u;
+
+  Job job;
+
+  while (areWorkersAlive.load<ATOMIC_ACQUIRE>()) {
+    if (popJob(&job)) {
+      execute(job);
+      continue;
+    }
+
+    nSleeping.fetchAdd<ATOMIC_SEQ_CST>(1);
+
+    // Re-check after announcing sleep as a job might have been pushed meanwhile.
+    if (!hasQueuedJobs() && areWorkersAlive.load<ATOMIC_SEQ_CST>()) {
+      wakeSemaphore.wait();
+    }
+
+    nSleeping.fetchSub<ATOMIC_SEQ_CST>(1);
+  }
+}
+
+void JobSystem::execute(const Job& job)
+{
+  Group* group = job.group_;
+
+  job.invoke_(&job);
+
+  // Keep the group alive until we are done with it, `wait()` also waits for `nFinishing_` to drop.
+  group->nFinishing_.fetchAdd<ATOMIC_RELAXED>(1);
+
+  if (group->pending_.fetchSub<ATOMIC_SEQ_CST>(1) == 2) {
+    onLastJob(group);
+  }
+
+  group->nFinishing_.fetchSub<ATOMIC_RELEASE>(1);
+}
+
+bool JobSystem::executeOne()
+{
+  Job job;
+
+  if ((Thread::isMain() && mainQueue.popFront(&job, false)) || popJob(&job)) {
+    execute(job);
+    return true;
+  }
+  return false;
+}
+
+void JobSystem::push(const Job& job)
+{
+  int own = queueIndex < 0 ? workerCount : queueIndex;
+
+  if (queues == nullptr || !queues[own].push(job)) {
+    execute(job);
+  }
+  else if (nSleeping.load<ATOMIC_SEQ_CST>() != 0) {
+    wakeSemaphore.post();
+  }
+}
+
+void JobSystem::pushMain(const Job& job)
+{
+  if (Thread::isMain()) {
+    execute(job);
+  }
+  else {
+    while (!mainQueue.push(job)) {
+      executeOne();
+    }
+  }
+}
+
+void JobSystem::onLastJob(Group* group)
+{
+  // Only continuation is pending.
+  if (group->pending_.load<ATOMIC_SEQ_CST>() == 1 &&
+      group->isArmed_.exchange<ATOMIC_SEQ_CST>(false))
+  {
+    push(group->continuation_);
+  }
+}
+
+JobSystem::Group::~Group()
+{
+  JobSystem::wait(*this);
+}
+
+void JobSystem::init(int nWorkers)
+{
+  destroy();
+
+  if (nWorkers < 0) {
+    nWorkers = System::cpuTopology().nCpus - 1;
+  }
+  nWorkers = clamp<int>(nWorkers, 0, MAX_WORKERS);
+
+  if (nWorkers == 0) {
+    return;
+  }
+
+  workerCount = nWorkers;
+  queues      = new JobQueue[nWorkers + 1];
+  workers     = new Thread[nWorkers];
+
+  areWorkersAlive.store<ATOMIC_RELEASE>(true);
+
+  for (int i = 0; i < nWorkers; ++i) {
+    snprintf(workerNames[i], sizeof(workerNames[i]), "job%d", i);
+
+    workers[i] = Thread(workerNames[i], workerMain, reinterpret_cast<void*>(size_t(i)));
+  }
+}
+
+void JobSystem::destroy()
+{
+  if (queues == nullptr) {
+    return;
+  }
+
+  areWorkersAlive.store<ATOMIC_SEQ_CST>(false);
+  wakeSemaphore.post(workerCount);
+
+  delete[] workers;
+
+  // Jobs left in queues are executed on the caller's thread.
+  Job job;
+
+  for (int i = 0; i <= workerCount; ++i) {
+    while (queues[i].popFront(&job, false)) {
+      execute(job);
+    }
+  }
+
+  delete[] queues;
+
+  workers     = nullptr;
+  queues      = nullptr;
+  workerCount = 0;
+}
+
+int JobSystem::nWorkers()
+{
+  return workerCount;
+}
+
+void JobSystem::wait(Group& group)
+{
+  while (!group.isDone()) {
+    if (!executeOne()) {
+#if defined(__ARM_ACLE__)
+      __builtin_arm_yield();
+#elif defined(__i386__) || defined(__x86_64__)
+      __builtin_ia32_pause();
+#endif
+    }
+  }
+}
+
+void JobSystem::processMain()
+{
+  Job job;
+
+  while (mainQueue.popFront(&job, false)) {
+    execute(job);
+  }
+}
+
+}
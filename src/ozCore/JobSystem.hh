@@ -0,0 +1,291 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file ozCore/JobSystem.hh
+ *
+ * `JobSystem` class.
+ */
+
+#pragma once
+
+#include "Atomic.hh"
+
+namespace oz
+{
+
+/**
+ * Work-stealing job system.
+ *
+ * A pool of worker threads, one per remaining CPU core, executes jobs. Each worker owns a job queue
+ * that it uses as a stack while idle workers steal the oldest jobs from other queues. Threads that
+ * are not workers (main thread, auxiliary game threads) push jobs to a shared queue and help
+ * executing jobs while waiting for them in `wait()`.
+ *
+ * Jobs pinned to the main thread (e.g. GL and AL calls) are executed by the main thread only,
+ * either in `processMain()`, which the main loop should call every frame, or while the main thread
+ * waits.
+ *
+ * Jobs are copies of function objects (mostly lambdas), which must be trivially copyable and may be
+ * at most `Job::STORAGE_SIZE` bytes large. Captures by reference are fine as long as the referenced
+ * variables outlive the job, i.e. until the group is waited for.
+ *
+ * If `init()` has not been called (or with zero workers) jobs are executed immediately on the
+ * caller's thread, except main-thread jobs that are still deferred to the main thread.
+ */
+class JobSystem
+{
+public:
+
+  /// Maximum number of worker threads.
+  static const int MAX_WORKERS = 64;
+
+  /// Capacity of each job queue, a job is executed immediately when its queue is full.
+  static const int QUEUE_SIZE = 1024;
+
+  class Group;
+
+  /**
+   * Type-erased job.
+   */
+  class Job
+  {
+    friend class JobSystem;
+
+  public:
+
+    /// Maximum size of a job's function object.
+    static const int STORAGE_SIZE = 48;
+
+  private:
+
+    /// Invoker for the stored function object.
+    typedef void Invoke(const Job* job);
+
+    Invoke* invoke_;                                  ///< Invoker.
+    Group*  group_;                                   ///< Group this job belongs to.
+    alignas(OZ_ALIGNMENT) char storage_[STORAGE_SIZE]; ///< Copy of the function object.
+
+  private:
+
+    /**
+     * Store a copy of a function object.
+     */
+    template <class Function>
+    void set(Group* group, const Function& function)
+    {
+      static_assert(sizeof(Function) <= STORAGE_SIZE, "Job function object is too large");
+      static_assert(__is_trivially_copyable(Function), "Job function must be trivially copyable");
+
+      invoke_ = [](const Job* job)
+      {
+        (*reinterpret_cast<const Function*>(job->storage_))();
+      };
+      group_  = group;
+
+      new(storage_) Function(function);
+    }
+
+  };
+
+  /**
+   * Group of jobs that can be waited for and can have a continuation.
+   */
+  class Group
+  {
+    friend class JobSystem;
+
+  private:
+
+    Atomic<int>  pending_    = {0};     ///< Number of unfinished jobs (including continuation).
+    Atomic<int>  nFinishing_ = {0};     ///< Number of threads still accessing the group.
+    Atomic<bool> isArmed_    = {false}; ///< Continuation is set but not yet scheduled.
+    Job          continuation_;         ///< Continuation job.
+
+  public:
+
+    /**
+     * Create an empty group.
+     */
+    Group() = default;
+
+    /**
+     * Wait for the pending jobs.
+     */
+    ~Group();
+
+    /**
+     * No copying.
+     */
+    Group(const Group&) = delete;
+
+    /**
+     * No copying.
+     */
+    Group& operator=(const Group&) = delete;
+
+    /**
+     * True iff all jobs (and continuation) have finished.
+     */
+    bool isDone() const
+    {
+      return pending_.load<ATOMIC_ACQUIRE>() == 0 && nFinishing_.load<ATOMIC_ACQUIRE>() == 0;
+    }
+
+    /**
+     * Set a job that is run after all jobs of the group that have already been started finish.
+     *
+     * `JobSystem::wait()` on the group also waits for the continuation.
+     */
+    template <class Function>
+    void then(const Function& function)
+    {
+      pending_.fetchAdd<ATOMIC_SEQ_CST>(1);
+      continuation_.set(this, function);
+      isArmed_.store<ATOMIC_SEQ_CST>(true);
+
+      JobSystem::onLastJob(this);
+    }
+
+  };
+
+private:
+
+  /**
+   * Worker thread's main function.
+   */
+  static void workerMain(void* data);
+
+  /**
+   * Execute a job and mark it finished in its group.
+   */
+  static void execute(const Job& job);
+
+  /**
+   * Execute a queued job if any, including main-thread jobs when called on the main thread.
+   */
+  static bool executeOne();
+
+  /**
+   * Push a job onto the current thread's queue or execute it if there's no room.
+   */
+  static void push(const Job& job);
+
+  /**
+   * Push a job onto the main-thread queue or execute it immediately if on the main thread.
+   */
+  static void pushMain(const Job& job);
+
+  /**
+   * Schedule continuation if it is armed and only the continuation is pending.
+   */
+  static void onLastJob(Group* group);
+
+public:
+
+  /**
+   * Start worker threads.
+   *
+   * @param nWorkers number of workers, by default one less than the number of CPU cores.
+   */
+  static void init(int nWorkers = -1);
+
+  /**
+   * Stop worker threads and execute the remaining jobs on the caller's thread.
+   */
+  static void destroy();
+
+  /**
+   * Number of worker threads.
+   */
+  static int nWorkers();
+
+  /**
+   * Run a job in a given group.
+   */
+  template <class Function>
+  static void run(Group& group, const Function& function)
+  {
+    Job job;
+    job.set(&group, function);
+
+    group.pending_.fetchAdd<ATOMIC_RELAXED>(1);
+    push(job);
+  }
+
+  /**
+   * Run a job in a given group on the main thread.
+   */
+  template <class Function>
+  static void runMain(Group& group, const Function& function)
+  {
+    Job job;
+    job.set(&group, function);
+
+    group.pending_.fetchAdd<ATOMIC_RELAXED>(1);
+    pushMain(job);
+  }
+
+  /**
+   * Wait until all jobs in a group finish, executing other jobs meanwhile.
+   */
+  static void wait(Group& group);
+
+  /**
+   * Execute all jobs pinned to the main thread.
+   *
+   * Must be called from the main thread.
+   */
+  static void processMain();
+
+  /**
+   * Call `function(chunkBegin, chunkEnd)` in parallel for chunks of `[begin, end)` range that are
+   * at most `grain` long and wait for them to finish.
+   */
+  template <class Function>
+  static void parallelFor(int begin, int end, int grain, const Function& function)
+  {
+    const Function* func = &function;
+    Group           group;
+
+    grain = max<int>(grain, 1);
+
+    while (end - begin > grain) {
+      int chunkEnd = begin + grain;
+
+      run(group, [func, begin, chunkEnd]
+      {
+        (*func)(begin, chunkEnd);
+      });
+
+      begin = chunkEnd;
+    }
+
+    if (begin < end) {
+      function(begin, end);
+    }
+    wait(group);
+  }
+
+};
+
+}
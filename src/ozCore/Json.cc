@@ -65,6 +65,7 @@ private:
   };
 
   Stream*     is;
+  List<char>  chars;
   String      lastComment;
   const char* path;
   int         line;
@@ -209,9 +210,10 @@ public:
   OZ_INTERNAL
   String parseString()
   {
-    List<char> chars;
     char ch = '"';
 
+    chars.clear();
+
     do {
       ch = readChar();
 
@@ -1366,4 +1368,540 @@ bool Json::save(const File& file, const Format& format) const
   return file.write(os);
 }
 
+void Json::Reader::error(const char* message) const
+{
+  int line   = 1;
+  int column = 0;
+
+  // Position is only needed for error messages, so it is not tracked while parsing.
+  for (const char* p = begin_; p < pos_; ++p) {
+    if (*p == '\n') {
+      ++line;
+      column = 0;
+    }
+    else {
+      ++column;
+    }
+  }
+
+  OZ_ERROR("oz::Json: %s at %s:%d:%d", message, path_, line, column);
+}
+
+char Json::Reader::skipBlanks()
+{
+  while (pos_ != end_) {
+    char ch = *pos_++;
+
+    if (String::isBlank(ch)) {
+      continue;
+    }
+    else if (ch == '/' && pos_ != end_ && *pos_ == '/') {
+      while (pos_ != end_ && *pos_ != '\n') {
+        ++pos_;
+      }
+      continue;
+    }
+    else if (ch == '/' && pos_ != end_ && *pos_ == '*') {
+      ++pos_;
+
+      while (pos_ + 1 < end_ && (pos_[0] != '*' || pos_[1] != '/')) {
+        ++pos_;
+      }
+      if (pos_ + 1 >= end_) {
+        error("Unexpected end of file in a comment");
+      }
+
+      pos_ += 2;
+      continue;
+    }
+    return ch;
+  }
+  return '\0';
+}
+
+void Json::Reader::parseString(List<char>* buffer)
+{
+  buffer->clear();
+
+  while (true) {
+    if (pos_ == end_) {
+      error("End of file while looking for end of string (Is ending \" missing?)");
+    }
+
+    char ch = *pos_++;
+
+    if (ch == '"') {
+      break;
+    }
+    else if (ch == '\n' || ch == '\r') {
+      continue;
+    }
+    else if (ch == '\\') {
+      if (pos_ == end_) {
+        error("End of file while looking for end of string (Is ending \" missing?)");
+      }
+
+      ch = *pos_++;
+
+      switch (ch) {
+        case 'b': {
+          ch = '\b';
+          break;
+        }
+        case 'f': {
+          ch = '\f';
+          break;
+        }
+        case 'n': {
+          ch = '\n';
+          break;
+        }
+        case 'r': {
+          ch = '\r';
+          break;
+        }
+        case 't': {
+          ch = '\t';
+          break;
+        }
+        default: {
+          break;
+        }
+      }
+    }
+
+    buffer->add(ch);
+  }
+  buffer->add('\0');
+}
+
+Json::Reader::Event Json::Reader::parseValue(char ch)
+{
+  switch (ch) {
+    case '{': {
+      stack_.add(true);
+      isFirst_ = true;
+      return BEGIN_OBJECT;
+    }
+    case '[': {
+      stack_.add(false);
+      isFirst_ = true;
+      return BEGIN_ARRAY;
+    }
+    default: {
+      break;
+    }
+  }
+
+  Event event;
+
+  if (ch == '"') {
+    parseString(&string_);
+    event = STRING;
+  }
+  else if (ch == 'n') {
+    if (end_ - pos_ < 3 || pos_[0] != 'u' || pos_[1] != 'l' || pos_[2] != 'l') {
+      error("Unknown value type");
+    }
+
+    pos_   += 3;
+    number_ = 0.0;
+    event   = NIL;
+  }
+  else if (ch == 't') {
+    if (end_ - pos_ < 3 || pos_[0] != 'r' || pos_[1] != 'u' || pos_[2] != 'e') {
+      error("Unknown value type");
+    }
+
+    pos_   += 3;
+    number_ = 1.0;
+    event   = BOOLEAN;
+  }
+  else if (ch == 'f') {
+    if (end_ - pos_ < 4 || pos_[0] != 'a' || pos_[1] != 'l' || pos_[2] != 's' || pos_[3] != 'e') {
+      error("Unknown value type");
+    }
+
+    pos_   += 4;
+    number_ = 0.0;
+    event   = BOOLEAN;
+  }
+  else {
+    char buffer[32];
+    int  length = 0;
+
+    buffer[length++] = ch;
+
+    while (pos_ != end_ && !String::isBlank(*pos_) && *pos_ != ',' && *pos_ != '}' &&
+           *pos_ != ']')
+    {
+      if (length >= 31) {
+        error("Too long number");
+      }
+      buffer[length++] = *pos_++;
+    }
+    buffer[length] = '\0';
+
+    const char* end;
+    number_ = String::parseDouble(buffer, &end);
+
+    if (end == buffer) {
+      error("Unknown value type");
+    }
+    event = NUMBER;
+  }
+
+  isDone_ = stack_.isEmpty();
+  return event;
+}
+
+Json::Reader::Event Json::Reader::endContainer()
+{
+  bool isObject = stack_.popLast();
+
+  hasKey_ = false;
+  isDone_ = stack_.isEmpty();
+  return isObject ? END_OBJECT : END_ARRAY;
+}
+
+Json::Reader::Reader(Stream* is, const char* path)
+  : begin_(is->begin()), pos_(is->pos()), end_(is->end()), is_(is), path_(path), number_(0.0),
+    hasKey_(false), isFirst_(false), isDone_(false)
+{
+  key_.add('\0');
+  string_.add('\0');
+}
+
+Json::Reader::Event Json::Reader::next()
+{
+  if (isDone_) {
+    if (skipBlanks() != '\0') {
+      error("End of file expected but some content found after");
+    }
+
+    hasKey_ = false;
+    is_->seek(int(pos_ - begin_));
+    return END;
+  }
+
+  char ch = skipBlanks();
+
+  if (stack_.isEmpty()) {
+    if (ch == '\0') {
+      error("Unexpected end of file");
+    }
+    return parseValue(ch);
+  }
+
+  bool isObject = stack_.last();
+
+  if (ch == (isObject ? '}' : ']')) {
+    isFirst_ = false;
+    return endContainer();
+  }
+  else if (isFirst_) {
+    isFirst_ = false;
+  }
+  else if (ch != ',') {
+    error(isObject ? "Expected ',' or '}' while parsing object entry" :
+                     "Expected ',' or ']' while parsing array (Is ',' is missing?)");
+  }
+  else {
+    ch = skipBlanks();
+  }
+
+  if (isObject) {
+    if (ch != '"') {
+      error("Expected key while parsing object (Is there ',' after last entry?)");
+    }
+
+    parseString(&key_);
+
+    if (skipBlanks() != ':') {
+      error("Expected ':' after key in object entry");
+    }
+    ch = skipBlanks();
+  }
+
+  if (ch == '\0') {
+    error("Unexpected end of file");
+  }
+
+  hasKey_ = isObject;
+  return parseValue(ch);
+}
+
+void Json::Reader::skip()
+{
+  int level = stack_.size();
+
+  while (stack_.size() >= level && next() != END) {
+  }
+}
+
+static const Json::Document::Value NIL_DOCUMENT_VALUE = Json::Document::Value();
+
+const Json::Document::Value& Json::Document::Value::operator[](int i) const
+{
+  return type_ == ARRAY && uint(i) < uint(size_) ? elements_[i] : NIL_DOCUMENT_VALUE;
+}
+
+const Json::Document::Value& Json::Document::Value::operator[](const char* key) const
+{
+  if (type_ == OBJECT) {
+    for (int i = 0; i < size_; ++i) {
+      if (String::equals(entries_[i].key, key)) {
+        return entries_[i].value;
+      }
+    }
+  }
+  return NIL_DOCUMENT_VALUE;
+}
+
+bool Json::Document::Value::contains(const char* key) const
+{
+  return &operator[](key) != &NIL_DOCUMENT_VALUE;
+}
+
+bool Json::Document::Value::getVector(float* vector, int count) const
+{
+  if (type_ != ARRAY || size_ != count) {
+    return false;
+  }
+
+  for (int i = 0; i < count; ++i) {
+    if (elements_[i].type_ != NUMBER) {
+      return false;
+    }
+    vector[i] = float(elements_[i].number_);
+  }
+  return true;
+}
+
+Vec3 Json::Document::Value::get(const Vec3& defaultValue) const
+{
+  Vec3 v;
+  return getVector(v, 3) ? v : defaultValue;
+}
+
+Point Json::Document::Value::get(const Point& defaultValue) const
+{
+  Point p;
+  return getVector(p, 3) ? p : defaultValue;
+}
+
+Vec4 Json::Document::Value::get(const Vec4& defaultValue) const
+{
+  Vec4 v;
+  return getVector(v, 4) ? v : defaultValue;
+}
+
+Quat Json::Document::Value::get(const Quat& defaultValue) const
+{
+  Quat q;
+  return getVector(q, 4) ? q : defaultValue;
+}
+
+/**
+ * Open array or object while building a document.
+ */
+struct DocumentFrame
+{
+  bool isObject;      ///< Container is an object.
+  bool isInObject;    ///< Container is an entry in its parent object.
+  int  slot;          ///< Container's index in its parent's scratch list, -1 for root.
+  int  childrenBegin; ///< Index of the first child in the scratch list.
+};
+
+Json::Document::~Document()
+{
+  clear();
+}
+
+Json::Document::Document(Document&& other) noexcept
+  : block_(other.block_), root_(other.root_)
+{
+  other.block_ = nullptr;
+  other.root_  = Value();
+}
+
+Json::Document& Json::Document::operator=(Document&& other) noexcept
+{
+  if (&other != this) {
+    clear();
+
+    block_ = other.block_;
+    root_  = other.root_;
+
+    other.block_ = nullptr;
+    other.root_  = Value();
+  }
+  return *this;
+}
+
+void Json::Document::read(Stream* is, const char* path)
+{
+  clear();
+
+  int start = is->tell();
+
+  // First pass: count array elements, object entries and string bytes.
+  int    nElements   = 0;
+  int    nEntries    = 0;
+  size_t stringBytes = 0;
+  bool   isRoot      = true;
+
+  Reader reader(is, path);
+
+  for (Reader::Event event = reader.next(); event != Reader::END; event = reader.next()) {
+    if (event == Reader::END_ARRAY || event == Reader::END_OBJECT) {
+      continue;
+    }
+
+    if (isRoot) {
+      isRoot = false;
+    }
+    else if (reader.key() != nullptr) {
+      stringBytes += size_t(String::length(reader.key()) + 1);
+      ++nEntries;
+    }
+    else {
+      ++nElements;
+    }
+
+    if (event == Reader::STRING) {
+      stringBytes += size_t(reader.length() + 1);
+    }
+  }
+
+  size_t elementsSize = size_t(nElements) * sizeof(Value);
+  size_t entriesSize  = size_t(nEntries) * sizeof(Entry);
+
+  block_ = new char[elementsSize + entriesSize + stringBytes];
+
+  Value* elementsPos = reinterpret_cast<Value*>(block_);
+  Entry* entriesPos  = reinterpret_cast<Entry*>(block_ + elementsSize);
+  char*  stringsPos  = block_ + elementsSize + entriesSize;
+
+  // Second pass: children are collected on scratch lists and moved into the block when their
+  // container ends, so each container's children are contiguous.
+  List<Value>         elements;
+  List<Entry>         entries;
+  List<DocumentFrame> frames;
+
+  is->seek(start);
+
+  Reader builder(is, path);
+
+  for (Reader::Event event = builder.next(); event != Reader::END; event = builder.next()) {
+    if (event == Reader::END_ARRAY || event == Reader::END_OBJECT) {
+      DocumentFrame frame = frames.popLast();
+      Value*        value = frame.slot < 0 ? &root_ :
+                            frame.isInObject ? &entries[frame.slot].value : &elements[frame.slot];
+
+      if (frame.isObject) {
+        int nChildren = entries.size() - frame.childrenBegin;
+
+        memcpy(entriesPos, entries.begin() + frame.childrenBegin,
+               size_t(nChildren) * sizeof(Entry));
+        value->entries_ = entriesPos;
+        value->size_    = nChildren;
+        entriesPos     += nChildren;
+
+        entries.resize(frame.childrenBegin);
+      }
+      else {
+        int nChildren = elements.size() - frame.childrenBegin;
+
+        memcpy(elementsPos, elements.begin() + frame.childrenBegin,
+               size_t(nChildren) * sizeof(Value));
+        value->elements_ = elementsPos;
+        value->size_     = nChildren;
+        elementsPos     += nChildren;
+
+        elements.resize(frame.childrenBegin);
+      }
+      continue;
+    }
+
+    Value value;
+
+    switch (event) {
+      case Reader::BOOLEAN: {
+        value.type_    = BOOLEAN;
+        value.boolean_ = builder.boolean();
+        break;
+      }
+      case Reader::NUMBER: {
+        value.type_   = NUMBER;
+        value.number_ = builder.number();
+        break;
+      }
+      case Reader::STRING: {
+        value.type_   = STRING;
+        value.string_ = stringsPos;
+        value.size_   = builder.length();
+
+        memcpy(stringsPos, builder.string(), size_t(builder.length() + 1));
+        stringsPos += builder.length() + 1;
+        break;
+      }
+      case Reader::BEGIN_ARRAY: {
+        value.type_ = ARRAY;
+        break;
+      }
+      case Reader::BEGIN_OBJECT: {
+        value.type_ = OBJECT;
+        break;
+      }
+      default: {
+        break;
+      }
+    }
+
+    int  slot       = -1;
+    bool isInObject = builder.key() != nullptr;
+
+    if (frames.isEmpty()) {
+      root_ = value;
+    }
+    else if (isInObject) {
+      int keyLength = String::length(builder.key());
+
+      memcpy(stringsPos, builder.key(), size_t(keyLength + 1));
+      entries.add(Entry{stringsPos, value});
+      stringsPos += keyLength + 1;
+      slot        = entries.size() - 1;
+    }
+    else {
+      elements.add(value);
+      slot = elements.size() - 1;
+    }
+
+    if (event == Reader::BEGIN_ARRAY || event == Reader::BEGIN_OBJECT) {
+      int childrenBegin = event == Reader::BEGIN_OBJECT ? entries.size() : elements.size();
+      frames.add(DocumentFrame{event == Reader::BEGIN_OBJECT, isInObject, slot, childrenBegin});
+    }
+  }
+}
+
+bool Json::Document::load(const File& file)
+{
+  Stream is = file.map();
+  if (is.available() == 0) {
+    return false;
+  }
+
+  read(&is, file);
+  return true;
+}
+
+void Json::Document::clear()
+{
+  delete[] block_;
+
+  block_ = nullptr;
+  root_  = Value();
+}
+
 }
@@ -99,6 +99,9 @@ public:
    */
   typedef Map<String, Json>::Iterator ObjectIterator;
 
+  class Reader;
+  class Document;
+
 private:
 
   struct Parser;
@@ -577,4 +580,398 @@ public:
 
 };
 
+/**
+ * Pull (SAX-like) JSON parser that reads a stream token by token without building a DOM.
+ *
+ * It accepts the same syntax as `Json::load()`. Strings and keys are decoded into internal buffers
+ * that are reused for the whole document, so no memory is allocated per value. On a syntax error
+ * `System::error()` is invoked like for `Json::load()`.
+ *
+ * @code
+ * Json::Reader reader(&is);
+ *
+ * for (Json::Reader::Event event = reader.next(); event != Json::Reader::END;
+ *      event = reader.next())
+ * {
+ *   if (event == Json::Reader::STRING && String::equals(reader.key(), "class")) {
+ *     Log() << reader.string();
+ *   }
+ * }
+ * @endcode
+ */
+class Json::Reader
+{
+public:
+
+  /**
+   * Parser events.
+   */
+  enum Event
+  {
+    END,
+    NIL,
+    BOOLEAN,
+    NUMBER,
+    STRING,
+    BEGIN_ARRAY,
+    END_ARRAY,
+    BEGIN_OBJECT,
+    END_OBJECT
+  };
+
+private:
+
+  const char* begin_;        ///< Beginning of the input.
+  const char* pos_;          ///< Current position in the input.
+  const char* end_;          ///< End of the input.
+  Stream*     is_;           ///< Input stream, its position is updated at `END`.
+  const char* path_;         ///< File path for error messages.
+  List<bool>  stack_;        ///< True for objects, false for arrays on the path to current value.
+  List<char>  key_;          ///< Key of the current value if its parent is an object.
+  List<char>  string_;       ///< String value.
+  double      number_;       ///< Number or boolean value.
+  bool        hasKey_;       ///< Current value is an object entry.
+  bool        isFirst_;      ///< Just entered a container, no separator expected.
+  bool        isDone_;       ///< Root value has been read.
+
+private:
+
+  OZ_NORETURN
+  OZ_INTERNAL
+  void error(const char* message) const;
+
+  OZ_INTERNAL
+  Event endContainer();
+
+  OZ_INTERNAL
+  char skipBlanks();
+
+  OZ_INTERNAL
+  void parseString(List<char>* buffer);
+
+  OZ_INTERNAL
+  Event parseValue(char ch);
+
+public:
+
+  /**
+   * Create a reader for the remaining contents of a given stream.
+   *
+   * @param path file path used in error messages.
+   */
+  explicit Reader(Stream* is, const char* path = "");
+
+  /**
+   * Read the next token.
+   *
+   * For values inside objects, `key()` returns the key of the current entry. `END` is returned
+   * after the root value and all subsequent calls.
+   */
+  Event next();
+
+  /**
+   * Skip the rest of the array or object the last `BEGIN_ARRAY` or `BEGIN_OBJECT` event started.
+   */
+  void skip();
+
+  /**
+   * Number of currently open arrays and objects.
+   */
+  OZ_ALWAYS_INLINE
+  int depth() const
+  {
+    return stack_.size();
+  }
+
+  /**
+   * Key of the current value or container if it is an object entry, `nullptr` otherwise.
+   */
+  OZ_ALWAYS_INLINE
+  const char* key() const
+  {
+    return hasKey_ ? key_.begin() : nullptr;
+  }
+
+  /**
+   * Value of the last `BOOLEAN` event.
+   */
+  OZ_ALWAYS_INLINE
+  bool boolean() const
+  {
+    return number_ != 0.0;
+  }
+
+  /**
+   * Value of the last `NUMBER` event.
+   */
+  OZ_ALWAYS_INLINE
+  double number() const
+  {
+    return number_;
+  }
+
+  /**
+   * Value of the last `STRING` event, valid until the next call to `next()`.
+   */
+  OZ_ALWAYS_INLINE
+  const char* string() const
+  {
+    return string_.begin();
+  }
+
+  /**
+   * Length of the last `STRING` event's value.
+   */
+  OZ_ALWAYS_INLINE
+  int length() const
+  {
+    return string_.size() - 1;
+  }
+
+};
+
+/**
+ * Read-only JSON DOM whose nodes and strings are all stored in a single memory block.
+ *
+ * The document is parsed in two passes with `Json::Reader`. The first one measures the document
+ * and the second one fills the block, so loading performs only one large allocation. Comments are
+ * discarded and object entries keep file order; keys are looked up linearly.
+ */
+class Json::Document
+{
+public:
+
+  class Value;
+
+  /**
+   * Object entry.
+   */
+  struct Entry;
+
+  /**
+   * Value node.
+   */
+  class Value
+  {
+  private:
+
+    union
+    {
+      bool         boolean_;
+      double       number_ = 0.0;
+      const char*  string_;
+      const Value* elements_;
+      const Entry* entries_;
+    };
+    Type           type_   = NIL;
+    int            size_   = 0;   ///< String length or number of elements or entries.
+
+    friend class Document;
+
+  public:
+
+    /**
+     * Type of value.
+     */
+    OZ_ALWAYS_INLINE
+    Type type() const
+    {
+      return type_;
+    }
+
+    /**
+     * True iff null.
+     */
+    OZ_ALWAYS_INLINE
+    bool isNull() const
+    {
+      return type_ == NIL;
+    }
+
+    /**
+     * Length of a string, number of elements in an array or entries in an object, -1 otherwise.
+     */
+    OZ_ALWAYS_INLINE
+    int size() const
+    {
+      return type_ >= STRING ? size_ : -1;
+    }
+
+    /**
+     * First array element, `nullptr` if not an array.
+     */
+    OZ_ALWAYS_INLINE
+    const Value* begin() const
+    {
+      return type_ == ARRAY ? elements_ : nullptr;
+    }
+
+    /**
+     * Past the last array element, `nullptr` if not an array.
+     */
+    OZ_ALWAYS_INLINE
+    const Value* end() const
+    {
+      return type_ == ARRAY ? elements_ + size_ : nullptr;
+    }
+
+    /**
+     * First object entry, `nullptr` if not an object.
+     */
+    OZ_ALWAYS_INLINE
+    const Entry* entries() const
+    {
+      return type_ == OBJECT ? entries_ : nullptr;
+    }
+
+    /**
+     * Array element, null value if not an array or index is out of range.
+     */
+    const Value& operator[](int i) const;
+
+    /**
+     * Object entry with a given key, null value if not an object or key is missing.
+     */
+    const Value& operator[](const char* key) const;
+
+    /**
+     * True iff an object with a given key.
+     */
+    bool contains(const char* key) const;
+
+    /**
+     * Boolean value or `defaultValue` if not a boolean.
+     */
+    OZ_ALWAYS_INLINE
+    bool get(bool defaultValue) const
+    {
+      return type_ == BOOLEAN ? boolean_ : defaultValue;
+    }
+
+    /**
+     * Number value or `defaultValue` if not a number.
+     */
+    OZ_ALWAYS_INLINE
+    double get(double defaultValue) const
+    {
+      return type_ == NUMBER ? number_ : defaultValue;
+    }
+
+    /**
+     * Number value or `defaultValue` if not a number.
+     */
+    OZ_ALWAYS_INLINE
+    float get(float defaultValue) const
+    {
+      return type_ == NUMBER ? float(number_) : defaultValue;
+    }
+
+    /**
+     * Number value or `defaultValue` if not a number.
+     */
+    OZ_ALWAYS_INLINE
+    int get(int defaultValue) const
+    {
+      return type_ == NUMBER ? int(number_) : defaultValue;
+    }
+
+    /**
+     * String value or `defaultValue` if not a string.
+     */
+    OZ_ALWAYS_INLINE
+    const char* get(const char* defaultValue) const
+    {
+      return type_ == STRING ? string_ : defaultValue;
+    }
+
+    /**
+     * Read an array of numbers into `vector` if it is an array of `count` numbers.
+     *
+     * @return true iff read.
+     */
+    bool getVector(float* vector, int count) const;
+
+    /**
+     * `Vec3` from an array of 3 numbers or `defaultValue` on type mismatch.
+     */
+    Vec3 get(const Vec3& defaultValue) const;
+
+    /**
+     * `Point` from an array of 3 numbers or `defaultValue` on type mismatch.
+     */
+    Point get(const Point& defaultValue) const;
+
+    /**
+     * `Vec4` from an array of 4 numbers or `defaultValue` on type mismatch.
+     */
+    Vec4 get(const Vec4& defaultValue) const;
+
+    /**
+     * `Quat` from an array of 4 numbers or `defaultValue` on type mismatch.
+     */
+    Quat get(const Quat& defaultValue) const;
+
+  };
+
+  struct Entry
+  {
+    const char* key;   ///< Key.
+    Value       value; ///< Value.
+  };
+
+private:
+
+  char* block_ = nullptr; ///< All nodes followed by all strings.
+  Value root_;            ///< Root value.
+
+public:
+
+  /**
+   * Create an empty document with a null root.
+   */
+  Document() = default;
+
+  /**
+   * Destructor.
+   */
+  ~Document();
+
+  /**
+   * Move constructor.
+   */
+  Document(Document&& other) noexcept;
+
+  /**
+   * Move operator.
+   */
+  Document& operator=(Document&& other) noexcept;
+
+  /**
+   * Root value.
+   */
+  OZ_ALWAYS_INLINE
+  const Value& root() const
+  {
+    return root_;
+  }
+
+  /**
+   * Replace contents with a document parsed from the remaining contents of a stream.
+   */
+  void read(Stream* is, const char* path = "");
+
+  /**
+   * Replace contents with a document read from a file.
+   *
+   * @return true iff file is successfully read and parsed.
+   */
+  bool load(const File& file);
+
+  /**
+   * Free the block and reset root to null.
+   */
+  void clear();
+
+};
+
 }
@@ -33,6 +33,33 @@
 namespace oz
 {
 
+/**
+ * Default `List` storage policy, element arrays are allocated with `new[]`.
+ */
+struct HeapAllocator
+{
+  /**
+   * Reallocate an array of `capacity` elements to `newCapacity` elements, moving first `size`
+   * elements.
+   */
+  template <typename Elem>
+  OZ_ALWAYS_INLINE
+  static Elem* reallocate(Elem* array, int size, int, int newCapacity)
+  {
+    return Arrays::reallocate<Elem>(array, size, newCapacity);
+  }
+
+  /**
+   * Delete an array.
+   */
+  template <typename Elem>
+  OZ_ALWAYS_INLINE
+  static void deallocate(Elem* array, int)
+  {
+    delete[] array;
+  }
+};
+
 /**
  * Array list.
  *
@@ -40,11 +67,12 @@ namespace oz
  * slightly better performance and simplifies implementation. When an element is removed its
  * destruction is still guaranteed.
  *
- * Memory is allocated when the first element is added.
+ * Memory is allocated when the first element is added. Element arrays are allocated through the
+ * `Allocator` policy, which provides `reallocate()` and `deallocate()` like `HeapAllocator`.
  *
- * @sa `oz::SList`, `oz::Set`, `oz::Heap`
+ * @sa `oz::SList`, `oz::Set`, `oz::Heap`, `oz::FrameList`
  */
-template <typename Elem>
+template <typename Elem, class Allocator = HeapAllocator>
 class List
 {
 public:
@@ -79,9 +107,11 @@ protected:
       OZ_ERROR("oz::List: Negative capacity (overflow?)");
     }
     else if (capacity_ < requestedCapacity) {
-      capacity_ = capacity_ == 0 ? 8 : capacity_ + capacity_ / 2;
-      capacity_ = max<int>(capacity_, requestedCapacity);
-      data_     = Arrays::reallocate<Elem>(data_, size_, capacity_);
+      int newCapacity = capacity_ == 0 ? 8 : capacity_ + capacity_ / 2;
+      newCapacity = max<int>(newCapacity, requestedCapacity);
+
+      data_     = Allocator::template reallocate<Elem>(data_, size_, capacity_, newCapacity);
+      capacity_ = newCapacity;
     }
   }
 
@@ -96,7 +126,8 @@ public:
    * Create a list with a given initial length and capacity.
    */
   explicit List(int size)
-    : data_(Arrays::reallocate<Elem>(nullptr, 0, size)), size_(size), capacity_(size)
+    : data_(Allocator::template reallocate<Elem>(nullptr, 0, 0, size)), size_(size),
+      capacity_(size)
   {}
 
   /**
@@ -120,7 +151,7 @@ public:
    */
   ~List()
   {
-    delete[] data_;
+    Allocator::template deallocate<Elem>(data_, capacity_);
   }
 
   /**
@@ -161,7 +192,7 @@ public:
   List& operator=(List&& other) noexcept
   {
     if (&other != this) {
-      delete[] data_;
+      Allocator::template deallocate<Elem>(data_, capacity_);
 
       data_     = other.data_;
       size_     = other.size_;
@@ -591,7 +622,7 @@ public:
   }
 
   /**
-   * Sort elements with quicksort.
+   * Sort elements with introsort.
    */
   template <class LessFunc = Less<Elem>>
   void sort()
@@ -606,7 +637,7 @@ public:
   {
     if (exactCapacity) {
       if (newCount != capacity_) {
-        data_     = Arrays::reallocate<Elem>(data_, size_, newCount);
+        data_     = Allocator::template reallocate<Elem>(data_, size_, capacity_, newCount);
         capacity_ = newCount;
       }
     }
@@ -625,7 +656,7 @@ public:
   {
     if (exactCapacity) {
       if (capacity_ < capacity) {
-        data_     = Arrays::reallocate<Elem>(data_, size_, capacity);
+        data_     = Allocator::template reallocate<Elem>(data_, size_, capacity_, capacity);
         capacity_ = capacity;
       }
     }
@@ -640,7 +671,7 @@ public:
   void trim()
   {
     if (size_ < capacity_) {
-      data_     = Arrays::reallocate<Elem>(data_, size_, size_);
+      data_     = Allocator::template reallocate<Elem>(data_, size_, capacity_, size_);
       capacity_ = size_;
     }
   }
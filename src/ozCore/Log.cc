@@ -23,21 +23,26 @@
 #include "Log.hh"
 
 #include "Alloc.hh"
+#include "ConcurrentPool.hh"
 #include "Profiler.hh"
+#include "SpinLock.hh"
+#include "Semaphore.hh"
+#include "Thread.hh"
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 #ifdef __GLIBC__
 # include <execinfo.h>
 # include <unistd.h>
 #endif
 
-#define OZ_VAARGS_BUFFER(buffer) \
-  char buffer[OUT_BUFFER_SIZE]; \
+#define OZ_VAARGS_BUFFER(buffer, length, doIndent, doEnd) \
+  char buffer[LINE_BUFFER_SIZE]; \
   va_list ap; \
   va_start(ap, s); \
-  vsnprintf(buffer, OUT_BUFFER_SIZE, s, ap); \
+  int length = formatLine(buffer, doIndent, s, ap, doEnd); \
   va_end(ap);
 
 #define OZ_PRINT_BOTH(code) \
@@ -54,10 +59,52 @@ static const int  OUT_BUFFER_SIZE      = 4096;
 static const int  INDENT_SPACES        = 2;
 static const char INDENT_BUFFER[49]    = "                                                ";
 static const int  INDENT_BUFFER_LENGTH = sizeof(INDENT_BUFFER) - 1;
-
-static File  logFile;
-static FILE* logFileStream = nullptr;
-static int   indentLevel   = 0;
+static const int  LINE_BUFFER_SIZE     = INDENT_BUFFER_LENGTH + OUT_BUFFER_SIZE + 1;
+
+static const int  RECORD_SIZE          = 256;
+static const int  RECORD_TEXT_SIZE     = RECORD_SIZE - 8;
+static const int  N_RECORDS            = 4096;
+static const int  MAX_RECORD_SPAN      = 64;
+static const int  MAX_IDLE_POLLS       = 100;
+static const int  STDOUT_BIT           = 0x01;
+static const int  FILE_BIT             = 0x02;
+
+// Slot of the asynchronous log ring. Slot at position `pos` is free for writing when its sequence
+// equals `pos` and holds a published record when it equals `pos + 1` (Vyukov's bounded queue).
+struct LogRecord
+{
+  Atomic<uint> sequence;
+  ushort       length;
+  ubyte        targets;
+  char         text[RECORD_TEXT_SIZE];
+};
+
+static_assert(sizeof(LogRecord) == RECORD_SIZE, "LogRecord must fill exactly one slot");
+
+static File                   logFile;
+static FILE*                  logFileStream = nullptr;
+static thread_local int       indentLevel   = 0;
+
+static LogRecord*             records       = nullptr;
+static Atomic<uint>           tail          = {0};
+static uint                   head          = 0;
+static SpinLock               drainLock;
+static Atomic<bool>           asyncMode     = {false};
+static Atomic<bool>           isRunning     = {false};
+static Atomic<bool>           isWriterIdle  = {false};
+static Semaphore              writerSemaphore;
+static Thread                 writerThread;
+
+// Stops the writer thread at exit if `Log::destroy()` has not been called.
+static struct LogWriterGuard
+{
+  ~LogWriterGuard()
+  {
+    if (records != nullptr) {
+      Log::destroy();
+    }
+  }
+} logWriterGuard;
 
 bool Log::showVerbose = false;
 bool Log::verboseMode = false;
@@ -70,6 +117,191 @@ static inline const char* getIndent()
   return &INDENT_BUFFER[bias];
 }
 
+// Indent, format and optionally terminate a line in a buffer of `LINE_BUFFER_SIZE` bytes.
+OZ_PRINTF_FORMAT(3, 0)
+static int formatLine(char* buffer, bool doIndent, const char* s, va_list ap, bool doEnd)
+{
+  int length = 0;
+
+  if (doIndent) {
+    const char* indent = getIndent();
+
+    length = INDENT_BUFFER_LENGTH - int(indent - INDENT_BUFFER);
+    memcpy(buffer, indent, size_t(length));
+  }
+
+  int textLength = vsnprintf(buffer + length, OUT_BUFFER_SIZE, s, ap);
+  length += clamp(textLength, 0, OUT_BUFFER_SIZE - 1);
+
+  if (doEnd) {
+    buffer[length++] = '\n';
+  }
+  return length;
+}
+
+// Write all published records, caller must hold `drainLock`. Return true iff any was written.
+static bool drainRecords()
+{
+  uint begin = head;
+
+  while (true) {
+    LogRecord& record = records[head % N_RECORDS];
+
+    if (record.sequence.load<ATOMIC_ACQUIRE>() != head + 1) {
+      break;
+    }
+
+    if (record.targets & STDOUT_BIT) {
+      fwrite(record.text, 1, record.length, stdout);
+    }
+    if ((record.targets & FILE_BIT) && logFileStream != nullptr) {
+      fwrite(record.text, 1, record.length, logFileStream);
+    }
+
+    record.sequence.store<ATOMIC_RELEASE>(head + N_RECORDS);
+    ++head;
+  }
+  return head != begin;
+}
+
+// Caller must hold `drainLock`, producers advance `head` when they drain a full ring.
+static bool hasPendingRecords()
+{
+  return records[head % N_RECORDS].sequence.load<ATOMIC_ACQUIRE>() == head + 1;
+}
+
+// Polls the ring every millisecond and only blocks after it has been empty for a while, so callers
+// seldom need to post the semaphore.
+static void writerMain(void*)
+{
+  int nIdlePolls = 0;
+
+  while (true) {
+    drainLock.lock();
+    bool hasWritten = drainRecords();
+    drainLock.unlock();
+
+    if (!isRunning.load<ATOMIC_ACQUIRE>()) {
+      break;
+    }
+    if (hasWritten) {
+      nIdlePolls = 0;
+    }
+    if (nIdlePolls < MAX_IDLE_POLLS) {
+      ++nIdlePolls;
+      Thread::sleepFor(1_ms);
+      continue;
+    }
+
+    nIdlePolls = 0;
+    isWriterIdle.store<ATOMIC_SEQ_CST>(true);
+
+    drainLock.lock();
+    bool hasPending = hasPendingRecords();
+    drainLock.unlock();
+
+    if (hasPending || !isRunning.load<ATOMIC_SEQ_CST>()) {
+      isWriterIdle.store<ATOMIC_RELAXED>(false);
+    }
+    else {
+      writerSemaphore.wait();
+    }
+  }
+
+  drainLock.lock();
+  drainRecords();
+  drainLock.unlock();
+}
+
+static void wakeWriter()
+{
+  Atomic<bool>::threadFence<ATOMIC_SEQ_CST>();
+
+  if (isWriterIdle.load<ATOMIC_RELAXED>() && isWriterIdle.exchange<ATOMIC_ACQ_REL>(false)) {
+    writerSemaphore.post();
+  }
+}
+
+// Copy text into consecutive ring slots, the writer thread preserves the order of slots.
+static void enqueue(const char* s, int length, int targets)
+{
+  while (length > 0) {
+    int  nSlots = min((length + RECORD_TEXT_SIZE - 1) / RECORD_TEXT_SIZE, MAX_RECORD_SPAN);
+    uint pos    = tail.load<ATOMIC_RELAXED>();
+
+    while (true) {
+      uint lastPos  = pos + uint(nSlots) - 1;
+      uint sequence = records[lastPos % N_RECORDS].sequence.load<ATOMIC_ACQUIRE>();
+
+      if (sequence == lastPos) {
+        if (tail.compareExchange<ATOMIC_RELAXED>(pos, pos + uint(nSlots))) {
+          break;
+        }
+      }
+      else if (int(sequence - lastPos) < 0) {
+        // The ring is full. Help the writer, it might be busy or not running at all.
+        wakeWriter();
+
+        if (drainLock.tryLock()) {
+          drainRecords();
+          drainLock.unlock();
+        }
+        else {
+#if defined(__ARM_ACLE__)
+          __builtin_arm_yield();
+#elif defined(__i386__) || defined(__x86_64__)
+          __builtin_ia32_pause();
+#endif
+        }
+        pos = tail.load<ATOMIC_RELAXED>();
+      }
+      else {
+        pos = tail.load<ATOMIC_RELAXED>();
+      }
+    }
+
+    for (int i = 0; i < nSlots; ++i) {
+      LogRecord& record      = records[(pos + uint(i)) % N_RECORDS];
+      int        chunkLength = min(length, RECORD_TEXT_SIZE);
+
+      memcpy(record.text, s, size_t(chunkLength));
+      record.length  = ushort(chunkLength);
+      record.targets = ubyte(targets);
+      record.sequence.store<ATOMIC_RELEASE>(pos + uint(i) + 1);
+
+      s      += chunkLength;
+      length -= chunkLength;
+    }
+
+    wakeWriter();
+  }
+}
+
+// Write text to stdout and/or log file, directly or through the ring in asynchronous mode.
+static void writeText(const char* s, int length, bool doFlush)
+{
+  if (asyncMode.load<ATOMIC_ACQUIRE>()) {
+    int targets = logFileStream == nullptr ? 0 : FILE_BIT;
+
+    if (!Log::verboseMode || Log::showVerbose || logFileStream == nullptr) {
+      targets |= STDOUT_BIT;
+    }
+    enqueue(s, length, targets);
+  }
+  else {
+    bool verboseMode = Log::verboseMode;
+    bool showVerbose = Log::showVerbose;
+
+    OZ_PRINT_BOTH(
+      fwrite(s, 1, size_t(length), stream);
+
+      if (doFlush) {
+        fflush(stream);
+      }
+    );
+  }
+}
+
 Log::Log()
 {
   print();
@@ -85,6 +317,11 @@ const File& Log::file()
   return logFile;
 }
 
+bool Log::isAsync()
+{
+  return asyncMode.load<ATOMIC_ACQUIRE>();
+}
+
 void Log::resetIndent()
 {
   indentLevel = 0;
@@ -104,78 +341,75 @@ void Log::unindent()
 
 void Log::putsRaw(const char* s)
 {
-  OZ_PRINT_BOTH(
-    fputs(s, stream);
-  );
+  writeText(s, String::length(s), false);
 }
 
 void Log::vprintRaw(const char* s, va_list ap)
 {
-  char buffer[OUT_BUFFER_SIZE];
-  vsnprintf(buffer, OUT_BUFFER_SIZE, s, ap);
+  char buffer[LINE_BUFFER_SIZE];
+  int  length = formatLine(buffer, false, s, ap, false);
 
-  putsRaw(buffer);
+  writeText(buffer, length, false);
 }
 
 void Log::printRaw(const char* s, ...)
 {
-  OZ_VAARGS_BUFFER(buffer);
+  OZ_VAARGS_BUFFER(buffer, length, false, false);
 
-  putsRaw(buffer);
+  writeText(buffer, length, false);
 }
 
 void Log::print(const char* s, ...)
 {
-  OZ_VAARGS_BUFFER(buffer);
+  OZ_VAARGS_BUFFER(buffer, length, true, false);
 
-  const char* indent = getIndent();
-
-  OZ_PRINT_BOTH(
-    fputs(indent, stream);
-    fputs(buffer, stream);
-  );
+  writeText(buffer, length, false);
 }
 
 void Log::print()
 {
   const char* indent = getIndent();
 
-  OZ_PRINT_BOTH(
-    fputs(indent, stream);
-  );
+  writeText(indent, INDENT_BUFFER_LENGTH - int(indent - INDENT_BUFFER), false);
 }
 
 void Log::printEnd(const char* s, ...)
 {
-  OZ_VAARGS_BUFFER(buffer);
+  OZ_VAARGS_BUFFER(buffer, length, false, true);
 
-  OZ_PRINT_BOTH(
-    fputs(buffer, stream);
-    fputc('\n', stream);
-    fflush(stream);
-  );
+  writeText(buffer, length, true);
 }
 
 void Log::println(const char* s, ...)
 {
-  OZ_VAARGS_BUFFER(buffer);
-
-  const char* indent = getIndent();
+  OZ_VAARGS_BUFFER(buffer, length, true, true);
 
-  OZ_PRINT_BOTH(
-    fputs(indent, stream);
-    fputs(buffer, stream);
-    fputc('\n', stream);
-    fflush(stream);
-  );
+  writeText(buffer, length, true);
 }
 
 void Log::println()
 {
-  OZ_PRINT_BOTH(
-    fputc('\n', stream);
-    fflush(stream);
-  );
+  writeText("\n", 1, true);
+}
+
+void Log::flush()
+{
+  if (records != nullptr) {
+    // Bounded spinning, the writer thread might have crashed while holding the lock.
+    for (int i = 0; i < 1 << 24; ++i) {
+      if (drainLock.tryLock()) {
+        drainRecords();
+        drainLock.unlock();
+        break;
+      }
+    }
+  }
+
+  fflush(stdout);
+
+  if (logFileStream != nullptr) {
+    fflush(logFileStream);
+  }
 }
 
 bool Log::printMemorySummary()
@@ -211,6 +445,9 @@ void Log::printTrace(const StackTrace& st)
 
   printEnd("  stack trace:");
 
+  // Frames are written directly to file descriptors, previous output must come first.
+  flush();
+
   for (int i = 0; i < st.nFrames; ++i) {
     write(STDOUT_FILENO, "    ", 4);
     backtrace_symbols_fd(&st.frames[i], 1, STDOUT_FILENO);
@@ -262,7 +499,7 @@ void Log::printProfilerStatistics()
     indent();
 
     for (const auto& i : Profiler::citerator()) {
-      println("%.6f s\t %s", double(i.value) / 1e6, i.key.c());
+      println("%.6f s\t %s", double(i.value.ns()) / 1e9, i.key.c());
     }
 
     unindent();
@@ -270,7 +507,31 @@ void Log::printProfilerStatistics()
   }
 }
 
-bool Log::init(const File& file, bool clearFile)
+void Log::printPoolStatistics()
+{
+  println("Pool statistics {");
+  indent();
+
+  for (ConcurrentPoolAlloc* pool = ConcurrentPoolAlloc::first(); pool != nullptr;
+       pool = pool->next())
+  {
+    ConcurrentPoolAlloc::Stats stats = pool->statistics();
+
+    if (stats.highWater == 0) {
+      continue;
+    }
+
+    println("%-16s %7d used %7d peak %7d held %8.2f MiB %5.1f %% free %9.1f allocs/s",
+            pool->name(), stats.size, stats.highWater, stats.capacity,
+            double(stats.bytesHeld) / (1024.0 * 1024.0), stats.fragmentation * 100.0f,
+            stats.allocsPerSecond);
+  }
+
+  unindent();
+  println("}");
+}
+
+bool Log::init(const File& file, bool clearFile, bool async)
 {
   destroy();
 
@@ -280,11 +541,50 @@ bool Log::init(const File& file, bool clearFile)
   if (!file.isEmpty()) {
     logFileStream = fopen(file, clearFile ? "w" : "a");
   }
+
+  if (async) {
+    records = new LogRecord[N_RECORDS];
+    tail.store<ATOMIC_RELAXED>(0);
+    head = 0;
+
+    for (int i = 0; i < N_RECORDS; ++i) {
+      records[i].sequence.store<ATOMIC_RELAXED>(uint(i));
+    }
+
+    isRunning.store<ATOMIC_RELAXED>(true);
+    writerThread = Thread("log", writerMain);
+    asyncMode.store<ATOMIC_RELEASE>(true);
+  }
   return logFile.isEmpty();
 }
 
+void Log::stopAsync()
+{
+  if (records != nullptr) {
+    asyncMode.store<ATOMIC_RELEASE>(false);
+    isRunning.store<ATOMIC_SEQ_CST>(false);
+    writerSemaphore.post();
+    writerThread.join();
+
+    // The writer thread drained all records. Records from threads that were still enqueueing
+    // when the mode was switched off are written here.
+    drainRecords();
+
+    delete[] records;
+    records = nullptr;
+
+    fflush(stdout);
+
+    if (logFileStream != nullptr) {
+      fflush(logFileStream);
+    }
+  }
+}
+
 void Log::destroy()
 {
+  stopAsync();
+
   if (!logFile.isEmpty()) {
     fclose(logFileStream);
 
@@ -454,9 +754,7 @@ const Log& Log::operator<<(const Mat4& m) const
 
 const Log& Log::operator<<(const Stream& is) const
 {
-  OZ_PRINT_BOTH(
-    fwrite(is.begin(), 1, is.capacity(), stream);
-  );
+  writeText(is.begin(), is.capacity(), false);
   return *this;
 }
 
@@ -38,8 +38,14 @@ namespace oz
 /**
  * %Log writing utility.
  *
- * Logging service, can write to terminal and into a file. After each operation stream is flushed,
- * so no data is lost on a crash.
+ * Logging service, can write to terminal and into a file. After each line stream is flushed, so no
+ * data is lost on a crash.
+ *
+ * In asynchronous mode, callers only format text and copy it into a lock-free ring buffer. A
+ * background thread writes the buffer out. Streams are not flushed after each line; `flush()`
+ * writes out pending text and is called on `OZ_ERROR` and crashes.
+ *
+ * Indentation is kept per thread.
  *
  * Two spaces are used for indentation.
  */
@@ -80,6 +86,11 @@ public:
    */
   static const File& file();
 
+  /**
+   * True iff the log is in asynchronous mode.
+   */
+  static bool isAsync();
+
   /**
    * %Set indent to zero.
    */
@@ -140,6 +151,14 @@ public:
    */
   static void println();
 
+  /**
+   * Write pending asynchronous output and flush streams.
+   *
+   * Safe to call from an error handler, it does not wait forever if the writer thread died while
+   * holding the ring lock. It writes through stdio, so it is not async-signal-safe.
+   */
+  static void flush();
+
   /**
    * Print stored thread's name and stack trace.
    */
@@ -176,13 +195,33 @@ public:
   static void printProfilerStatistics();
 
   /**
-   * First parameter is the log file (if null file, it only writes to stdout), the other tells
-   * whether to clear its content if the file already exists.
+   * Print statistics of all `ConcurrentPoolAlloc` instances that have been used.
+   *
+   * This restarts their allocation rate measurements.
+   *
+   * @sa `oz::ConcurrentPoolAlloc`
    */
-  static bool init(const File& file = File(), bool clearFile = true);
+  static void printPoolStatistics();
 
   /**
-   * Close log file.
+   * First parameter is the log file (if null file, it only writes to stdout), the second tells
+   * whether to clear its content if the file already exists and the third one enables
+   * asynchronous mode.
+   */
+  static bool init(const File& file = File(), bool clearFile = true, bool async = false);
+
+  /**
+   * Stop asynchronous writer, keep log file open.
+   *
+   * Output that is already queued is written out before this returns and all further output is
+   * written synchronously. No other thread may be logging during this call.
+   */
+  static void stopAsync();
+
+  /**
+   * Stop asynchronous writer and close log file.
+   *
+   * No other thread may be logging during this call.
    */
   static void destroy();
 
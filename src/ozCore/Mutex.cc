@@ -22,47 +22,30 @@
 
 #include "Mutex.hh"
 
-#include "System.hh"
-
-#include <cstdlib>
-#include <pthread.h>
-
 namespace oz
 {
 
-struct Mutex::Descriptor
+void Mutex::lockSlow()
 {
-  pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
-};
-
-Mutex::Mutex()
-{
-  descriptor_ = new(malloc(sizeof(Descriptor))) Descriptor;
-  if (descriptor_ == nullptr) {
-    OZ_ERROR("oz::Mutex: Descriptor initialisation failed");
+  for (int i = 0; i < SPIN_COUNT; ++i) {
+    int state = state_.load<ATOMIC_RELAXED>();
+
+    if (state == 0) {
+      if (state_.compareExchange<ATOMIC_ACQUIRE>(state, 1)) {
+        return;
+      }
+    }
+    else if (state == 2) {
+      // Others are already sleeping, no point in spinning.
+      break;
+    }
+    Futex::pause();
   }
-}
-
-Mutex::~Mutex()
-{
-  pthread_mutex_destroy(&descriptor_->mutex);
-
-  free(descriptor_);
-}
 
-void Mutex::lock()
-{
-  pthread_mutex_lock(&descriptor_->mutex);
-}
-
-bool Mutex::tryLock()
-{
-  return pthread_mutex_trylock(&descriptor_->mutex) == 0;
-}
-
-void Mutex::unlock()
-{
-  pthread_mutex_unlock(&descriptor_->mutex);
+  // Mark the lock as contended, so the owner wakes us on unlock.
+  while (state_.exchange<ATOMIC_ACQUIRE>(2) != 0) {
+    Futex::wait(&state_, 2);
+  }
 }
 
 }
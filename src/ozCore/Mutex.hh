@@ -28,7 +28,7 @@
 
 #pragma once
 
-#include "common.hh"
+#include "Futex.hh"
 
 namespace oz
 {
@@ -36,27 +36,36 @@ namespace oz
 /**
  * %Mutex.
  *
+ * Adaptive lock: it spins for `SPIN_COUNT` iterations first, since locks in the engine are mostly
+ * held very briefly, and only then puts the thread to sleep on a futex. Uncontended locking and
+ * unlocking is a single atomic operation without a system call.
+ *
  * @sa `oz::Atomic`, `oz::SpinLock`, `oz::LockGuard`, `oz::Semaphore`, `oz::CallOnce`, `oz::Thread`
  */
 class Mutex
 {
-private:
+public:
 
-  struct Descriptor;
+  /// Number of spins before the thread goes to sleep.
+  static const int SPIN_COUNT = 100;
 
-  Descriptor* descriptor_ = nullptr; ///< Internal mutex descriptor.
+private:
 
-public:
+  Atomic<int> state_ = {0}; ///< 0 unlocked, 1 locked, 2 locked with possibly sleeping waiters.
+
+private:
 
   /**
-   * Create and initialise mutex.
+   * Spin, then sleep until lock is obtained.
    */
-  Mutex();
+  void lockSlow();
+
+public:
 
   /**
-   * Destroy mutex.
+   * Create an unlocked mutex.
    */
-  ~Mutex();
+  Mutex() = default;
 
   /**
    * Copying or moving is not possible.
@@ -74,7 +83,15 @@ public:
    * @note
    * Locking a mutex that is already locked by the current thread results in undefined behaviour.
    */
-  void lock();
+  OZ_ALWAYS_INLINE
+  void lock()
+  {
+    int expected = 0;
+
+    if (!state_.compareExchange<ATOMIC_ACQUIRE>(expected, 1)) {
+      lockSlow();
+    }
+  }
 
   /**
    * Lock if not already locked.
@@ -84,7 +101,14 @@ public:
    *
    * @return True on success.
    */
-  bool tryLock();
+  OZ_ALWAYS_INLINE
+  bool tryLock()
+  {
+    int expected = 0;
+
+    return state_.load<ATOMIC_RELAXED>() == 0 &&
+           state_.compareExchange<ATOMIC_ACQUIRE>(expected, 1);
+  }
 
   /**
    * Unlock.
@@ -92,7 +116,13 @@ public:
    * @note
    * Unlocking an unlocked mutex results in undefined behaviour.
    */
-  void unlock();
+  OZ_ALWAYS_INLINE
+  void unlock()
+  {
+    if (state_.exchange<ATOMIC_RELEASE>(0) == 2) {
+      Futex::wake(&state_, 1);
+    }
+  }
 
   /**
    * Wrap a (lambda) function with the mutex.
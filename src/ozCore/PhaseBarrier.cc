@@ -0,0 +1,70 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "PhaseBarrier.hh"
+
+#include "System.hh"
+
+namespace oz
+{
+
+PhaseBarrier::PhaseBarrier(int nParties)
+  : nParties_(nParties)
+{
+  if (nParties < 1) {
+    OZ_ERROR("oz::PhaseBarrier: Number of parties must be at least 1");
+  }
+}
+
+bool PhaseBarrier::wait()
+{
+  int phase = phase_.load<ATOMIC_ACQUIRE>();
+
+  if (nArrived_.fetchAdd<ATOMIC_ACQ_REL>(1) == nParties_ - 1) {
+    // Reset must be visible before the new phase, threads may arrive again right after they see it.
+    nArrived_.store<ATOMIC_RELAXED>(0);
+    phase_.store<ATOMIC_SEQ_CST>(phase + 1);
+
+    if (nSleepers_.load<ATOMIC_SEQ_CST>() != 0) {
+      Futex::wakeAll(&phase_);
+    }
+    return true;
+  }
+
+  for (int i = 0; phase_.load<ATOMIC_ACQUIRE>() == phase; ++i) {
+    if (i < SPIN_COUNT) {
+      Futex::pause();
+    }
+    else {
+      nSleepers_.fetchAdd<ATOMIC_SEQ_CST>(1);
+
+      if (phase_.load<ATOMIC_SEQ_CST>() == phase) {
+        Futex::wait(&phase_, phase);
+      }
+
+      nSleepers_.fetchSub<ATOMIC_RELAXED>(1);
+    }
+  }
+  return false;
+}
+
+}
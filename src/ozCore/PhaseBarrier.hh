@@ -0,0 +1,106 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file ozCore/PhaseBarrier.hh
+ *
+ * `PhaseBarrier` class.
+ */
+
+#pragma once
+
+#include "Futex.hh"
+
+namespace oz
+{
+
+/**
+ * Reusable barrier for a fixed number of threads.
+ *
+ * Each `wait()` call blocks until all parties have called it, then all of them proceed into the
+ * next phase and the barrier can be used again right away. This replaces pairs of semaphores when
+ * threads hand off phases of a pipeline to each other.
+ *
+ * Waiting threads spin for `SPIN_COUNT` iterations first, since phases are usually short, and then
+ * sleep on a futex. The last arriving thread only issues a wake-up call if anyone went to sleep.
+ *
+ * @sa `oz::Semaphore`, `oz::Futex`
+ */
+class PhaseBarrier
+{
+public:
+
+  /// Number of spins before a waiting thread goes to sleep.
+  static const int SPIN_COUNT = 1000;
+
+private:
+
+  Atomic<int> nArrived_  = {0}; ///< Number of threads that have arrived in the current phase.
+  Atomic<int> phase_     = {0}; ///< Phase counter.
+  Atomic<int> nSleepers_ = {0}; ///< Threads sleeping on `phase_`.
+  int         nParties_;        ///< Number of threads taking part.
+
+public:
+
+  /**
+   * Create a barrier for a given number of threads.
+   */
+  explicit PhaseBarrier(int nParties);
+
+  /**
+   * Copying or moving is not possible.
+   */
+  PhaseBarrier(const PhaseBarrier&) = delete;
+
+  /**
+   * Copying or moving is not possible.
+   */
+  PhaseBarrier& operator=(const PhaseBarrier&) = delete;
+
+  /**
+   * Number of threads taking part.
+   */
+  OZ_ALWAYS_INLINE
+  int nParties() const
+  {
+    return nParties_;
+  }
+
+  /**
+   * Number of completed phases (wraps around).
+   */
+  OZ_ALWAYS_INLINE
+  int phase() const
+  {
+    return phase_.load<ATOMIC_ACQUIRE>();
+  }
+
+  /**
+   * Wait until all parties have arrived.
+   *
+   * @return True for exactly one thread per phase, the last one to arrive.
+   */
+  bool wait();
+
+};
+
+}
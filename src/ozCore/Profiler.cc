@@ -22,32 +22,230 @@
 
 #include "Profiler.hh"
 
+#include "Atomic.hh"
+#include "File.hh"
+#include "List.hh"
+#include "Thread.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
 namespace oz
 {
 
-static HashMap<String, ulong64> profileTimes;
+static_assert((Profiler::BUFFER_SIZE & (Profiler::BUFFER_SIZE - 1)) == 0,
+              "Profiler::BUFFER_SIZE must be a power of two");
 
-Profiler::CIterator Profiler::citerator()
+struct ZoneRecord
+{
+  const char* name;
+  long64      begin;
+  long64      end;
+};
+
+/*
+ * Ring buffer of zones for a thread. Buffers are never freed, when a thread exits its buffer is
+ * marked unused and taken over by the next thread that starts recording.
+ */
+struct ThreadBuffer
+{
+  ThreadBuffer* next;
+  Atomic<bool>  isUsed;
+  Atomic<uint>  head;  ///< Total number of zones ever written into this buffer.
+  Atomic<uint>  start; ///< Zones before this one were discarded.
+  Atomic<int>   id;
+  char          name[Thread::NAME_LENGTH + 1];
+  ZoneRecord    records[Profiler::BUFFER_SIZE];
+};
+
+struct ThreadState
+{
+  ThreadBuffer* buffer = nullptr;
+
+  ~ThreadState()
+  {
+    if (buffer != nullptr) {
+      buffer->isUsed.store<ATOMIC_RELEASE>(false);
+    }
+  }
+};
+
+static Atomic<ThreadBuffer*>     firstBuffer  = {nullptr};
+static Atomic<int>               nextThreadId = {1};
+static thread_local ThreadState  threadState;
+static HashMap<String, Duration> totals;
+
+static ThreadBuffer* acquireBuffer()
+{
+  ThreadBuffer* buffer = firstBuffer.load<ATOMIC_ACQUIRE>();
+
+  for (; buffer != nullptr; buffer = buffer->next) {
+    if (!buffer->isUsed.load<ATOMIC_RELAXED>() && !buffer->isUsed.testAndSet<ATOMIC_ACQUIRE>()) {
+      break;
+    }
+  }
+
+  if (buffer == nullptr) {
+    buffer = static_cast<ThreadBuffer*>(malloc(sizeof(ThreadBuffer)));
+    if (buffer == nullptr) {
+      OZ_ERROR("oz::Profiler: Thread buffer allocation failed");
+    }
+
+    buffer->isUsed.value = true;
+    buffer->head.value   = 0;
+    buffer->start.value  = 0;
+    buffer->next         = firstBuffer.load<ATOMIC_RELAXED>();
+
+    while (!firstBuffer.compareExchange<ATOMIC_RELEASE>(buffer->next, buffer)) {
+    }
+  }
+
+  // Records from a previous thread are discarded.
+  buffer->start.store<ATOMIC_RELEASE>(buffer->head.load<ATOMIC_RELAXED>());
+  buffer->id.store<ATOMIC_RELAXED>(nextThreadId.fetchAdd<ATOMIC_RELAXED>(1));
+
+  strncpy(buffer->name, Thread::name(), Thread::NAME_LENGTH);
+  buffer->name[Thread::NAME_LENGTH] = '\0';
+
+  return buffer;
+}
+
+/*
+ * Copy zones still present in a buffer. Records are copied without synchronisation with the owning
+ * thread, so the ones that may have been overwritten during copying must be skipped. Index of the
+ * first valid zone is returned.
+ */
+static int readBuffer(ThreadBuffer* buffer, List<ZoneRecord>* zones)
+{
+  uint start = buffer->start.load<ATOMIC_ACQUIRE>();
+  uint head  = buffer->head.load<ATOMIC_ACQUIRE>();
+  uint first = head - start > uint(Profiler::BUFFER_SIZE) ? head - Profiler::BUFFER_SIZE : start;
+
+  zones->clear();
+
+  for (uint i = first; i != head; ++i) {
+    zones->add(buffer->records[i & (Profiler::BUFFER_SIZE - 1)]);
+  }
+
+  Atomic<uint>::threadFence<ATOMIC_ACQUIRE>();
+
+  // Writer overwrites zone `i` while writing zone `i + BUFFER_SIZE`.
+  uint newHead  = buffer->head.load<ATOMIC_RELAXED>();
+  int  nDropped = int(newHead - first) - Profiler::BUFFER_SIZE + 1;
+
+  return clamp<int>(nDropped, 0, zones->size());
+}
+
+static void writeEscaped(Stream* os, const char* s)
 {
-  return profileTimes.citerator();
+  for (; *s != '\0'; ++s) {
+    if (*s == '"' || *s == '\\') {
+      os->writeChar('\\');
+    }
+    os->writeChar(*s);
+  }
 }
 
-void Profiler::add(const char* key, uint micros)
+void Profiler::record(const char* name, Instant begin, Instant end)
 {
-  ulong64* time = profileTimes.find(key);
+  ThreadBuffer* buffer = threadState.buffer;
 
-  if (time == nullptr) {
-    profileTimes.add(key, micros);
+  if (buffer == nullptr) {
+    buffer = acquireBuffer();
+    threadState.buffer = buffer;
   }
-  else {
-    *time += micros;
+
+  uint head = buffer->head.load<ATOMIC_RELAXED>();
+
+  buffer->records[head & (BUFFER_SIZE - 1)] = {name, begin.ns(), end.ns()};
+  buffer->head.store<ATOMIC_RELEASE>(head + 1);
+}
+
+Profiler::CIterator Profiler::citerator()
+{
+  List<ZoneRecord> zones;
+
+  totals.clear();
+
+  for (ThreadBuffer* buffer = firstBuffer.load<ATOMIC_ACQUIRE>(); buffer != nullptr;
+       buffer = buffer->next)
+  {
+    int first = readBuffer(buffer, &zones);
+
+    for (int i = first; i < zones.size(); ++i) {
+      const ZoneRecord& zone     = zones[i];
+      Duration          duration = Duration(zone.end - zone.begin);
+      Duration*         total    = totals.find(zone.name);
+
+      if (total == nullptr) {
+        totals.add(zone.name, duration);
+      }
+      else {
+        *total += duration;
+      }
+    }
   }
+
+  return totals.citerator();
+}
+
+bool Profiler::exportTrace(const File& file)
+{
+  List<ZoneRecord> zones;
+  Stream           os(0);
+  char             buffer[128];
+  bool             isFirst = true;
+
+  os.writeLine("{\"traceEvents\":[");
+
+  for (ThreadBuffer* thread = firstBuffer.load<ATOMIC_ACQUIRE>(); thread != nullptr;
+       thread = thread->next)
+  {
+    int tid = thread->id.load<ATOMIC_RELAXED>();
+
+    int first = readBuffer(thread, &zones);
+
+    if (first == zones.size()) {
+      continue;
+    }
+
+    snprintf(buffer, sizeof(buffer),
+             "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"",
+             isFirst ? "" : ",\n", tid);
+    os.write(buffer, int(strlen(buffer)));
+    writeEscaped(&os, thread->name);
+    os.write("\"}}", 3);
+
+    isFirst = false;
+
+    for (int i = first; i < zones.size(); ++i) {
+      const ZoneRecord& zone = zones[i];
+
+      os.write(",\n{\"ph\":\"X\",\"name\":\"", 20);
+      writeEscaped(&os, zone.name);
+
+      snprintf(buffer, sizeof(buffer), "\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+               tid, double(zone.begin) / 1e3, double(zone.end - zone.begin) / 1e3);
+      os.write(buffer, int(strlen(buffer)));
+    }
+  }
+
+  os.writeLine("\n]}");
+
+  return file.write(os);
 }
 
 void Profiler::clear()
 {
-  profileTimes.clear();
-  profileTimes.trim();
+  for (ThreadBuffer* buffer = firstBuffer.load<ATOMIC_ACQUIRE>(); buffer != nullptr;
+       buffer = buffer->next)
+  {
+    buffer->start.store<ATOMIC_RELEASE>(buffer->head.load<ATOMIC_ACQUIRE>());
+  }
+
+  totals.clear();
+  totals.trim();
 }
 
 }
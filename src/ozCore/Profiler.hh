@@ -32,55 +32,110 @@
 #include "Instant.hh"
 
 /**
- * Remember current time for a later `OZ_PROFILER_END()` macro with the same key.
+ * @def OZ_PROFILER_ZONE
+ * Declare a `oz::Profiler::Zone` that measures time until the end of the enclosing scope.
  */
-#define OZ_PROFILER_BEGIN(key) \
-  uint key##_profilerTime = oz::Time::uclock()
+#define OZ_PROFILER_ZONE(name) \
+  oz::Profiler::Zone OZ_PROFILER_ZONE_VAR(__LINE__)(name)
 
-/**
- * Enter time difference into the `oz::Profiler` under a given key.
- *
- * Time difference is calculated as difference in microseconds between the current time and the
- * saved time from a previous `oz_PROFILER_BEGIN()` with the same key.
- */
-#define OZ_PROFILER_END(key) \
-  oz::Profiler::add(#key, oz::Time::uclock() - key##_profilerTime)
+/// @cond
+#define OZ_PROFILER_ZONE_VAR(line)  OZ_PROFILER_ZONE_VAR_(line)
+#define OZ_PROFILER_ZONE_VAR_(line) ozProfilerZone##line
+/// @endcond
 
 namespace oz
 {
 
+class File;
+
 /**
- * Profiling statistics.
+ * Hierarchical per-thread profiler.
+ *
+ * Each thread records timed zones into its own ring buffer of the last `BUFFER_SIZE` zones. Only
+ * the owning thread writes to its buffer, so recording is lock-free and never allocates after the
+ * first zone on a thread. Nesting of zones is given by their begin and end instants, trace viewers
+ * reconstruct the call hierarchy from it.
+ *
+ * Recorded zones can be summed up per name via `citerator()` or exported as a Chrome trace
+ * (`chrome://tracing`, Perfetto) via `exportTrace()`. Both may be called from any thread while
+ * other threads keep recording; zones that get overwritten during reading are skipped.
  *
- * This class has an internal hashtable of string-microseconds pairs. `add()` function may be used
- * to add a new entry or add time to an existing entry, but `OZ_PROFILER_BEGIN()` and
- * `OZ_PROFILER_END()` macros are probably better suited.
+ * Zone names must be string literals or otherwise outlive the profiler, only pointers are stored.
  */
 class Profiler
 {
 public:
 
+  /// Number of zones each thread keeps (must be a power of two).
+  static const int BUFFER_SIZE = 1 << 14;
+
   /**
    * Constant iterator for accumulated times.
    */
-  typedef HashMap<String, ulong64>::CIterator CIterator;
+  typedef HashMap<String, Duration>::CIterator CIterator;
+
+  /**
+   * RAII zone, recorded when it goes out of scope.
+   */
+  class Zone
+  {
+  private:
+
+    const char* name_;  ///< Zone name.
+    Instant     begin_; ///< Time when the zone was entered.
+
+  public:
+
+    /**
+     * Enter a zone.
+     */
+    OZ_ALWAYS_INLINE
+    explicit Zone(const char* name)
+      : name_(name), begin_(Instant::now())
+    {}
+
+    /**
+     * Leave the zone and record it.
+     */
+    OZ_ALWAYS_INLINE
+    ~Zone()
+    {
+      Profiler::record(name_, begin_, Instant::now());
+    }
+
+    /**
+     * No copying.
+     */
+    Zone(const Zone&) = delete;
+
+    /**
+     * No copying.
+     */
+    Zone& operator=(const Zone&) = delete;
+
+  };
 
 public:
 
   /**
-   * Return constant iterator for accumulated times.
+   * Record a zone for the current thread.
    */
-  static CIterator citerator();
+  static void record(const char* name, Instant begin, Instant end);
 
   /**
-   * Add a time in microseconds to a named sum.
+   * Sum up durations of recorded zones per name and return constant iterator over sums.
    *
-   * If the key doesn't exist, a new key with initial value `micros` is added.
+   * Each call recalculates sums, iterator is invalidated by the next call.
+   */
+  static CIterator citerator();
+
+  /**
+   * Write recorded zones from all threads into a file in Chrome trace event JSON format.
    */
-  static void add(const char* key, uint micros);
+  static bool exportTrace(const File& file);
 
   /**
-   * Clear internal hashtable, deleting all times.
+   * Discard all recorded zones.
    */
   static void clear();
 
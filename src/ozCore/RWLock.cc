@@ -0,0 +1,114 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "RWLock.hh"
+
+namespace oz
+{
+
+void RWLock::sleep(int state)
+{
+  // Sleepers must be announced before the state is re-checked, otherwise an unlocking thread might
+  // miss them and never wake them.
+  nSleepers_.fetchAdd<ATOMIC_SEQ_CST>(1);
+
+  if (state_.load<ATOMIC_SEQ_CST>() == state) {
+    Futex::wait(&state_, state);
+  }
+
+  nSleepers_.fetchSub<ATOMIC_RELAXED>(1);
+}
+
+void RWLock::wakeSleepers()
+{
+  if (nSleepers_.load<ATOMIC_SEQ_CST>() != 0) {
+    Futex::wakeAll(&state_);
+  }
+}
+
+void RWLock::lockReadSlow()
+{
+  for (int i = 0; ; ++i) {
+    int state = state_.load<ATOMIC_RELAXED>();
+
+    if (!(state & WRITER) && nWaitingWriters_.load<ATOMIC_RELAXED>() == 0) {
+      if (state_.compareExchange<ATOMIC_ACQUIRE>(state, state + 1)) {
+        return;
+      }
+    }
+    else if (i < SPIN_COUNT) {
+      Futex::pause();
+    }
+    else {
+      sleep(state);
+    }
+  }
+}
+
+void RWLock::lockSlow()
+{
+  nWaitingWriters_.fetchAdd<ATOMIC_RELAXED>(1);
+
+  for (int i = 0; ; ++i) {
+    int state = state_.load<ATOMIC_RELAXED>();
+
+    if (state == 0) {
+      if (state_.compareExchange<ATOMIC_ACQUIRE>(state, WRITER)) {
+        break;
+      }
+    }
+    else if (i < SPIN_COUNT) {
+      Futex::pause();
+    }
+    else {
+      sleep(state);
+    }
+  }
+
+  nWaitingWriters_.fetchSub<ATOMIC_RELAXED>(1);
+}
+
+bool RWLock::tryLockRead()
+{
+  int state = state_.load<ATOMIC_RELAXED>();
+
+  while (!(state & WRITER) && nWaitingWriters_.load<ATOMIC_RELAXED>() == 0) {
+    if (state_.compareExchange<ATOMIC_ACQUIRE>(state, state + 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RWLock::tryLock()
+{
+  int state = state_.load<ATOMIC_RELAXED>();
+
+  while (state == 0) {
+    if (state_.compareExchange<ATOMIC_ACQUIRE>(state, WRITER)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}
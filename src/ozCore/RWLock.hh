@@ -0,0 +1,166 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file ozCore/RWLock.hh
+ *
+ * `RWLock` class.
+ */
+
+#pragma once
+
+#include "Futex.hh"
+
+namespace oz
+{
+
+/**
+ * Reader/writer lock.
+ *
+ * Any number of readers or a single writer may hold the lock. Writers are preferred: once a writer
+ * is waiting, new readers wait too, so a steady stream of readers cannot starve it. Waiting threads
+ * spin for `SPIN_COUNT` iterations before they go to sleep on a futex.
+ *
+ * `lock()` and `unlock()` take the write lock, so `LockGuard` can be used for writers.
+ *
+ * @sa `oz::Mutex`, `oz::SpinLock`, `oz::LockGuard`
+ */
+class RWLock
+{
+public:
+
+  /// Number of spins before the thread goes to sleep.
+  static const int SPIN_COUNT = 100;
+
+private:
+
+  static const int WRITER = 1 << 30; ///< State bit when write-locked.
+
+  Atomic<int> state_           = {0}; ///< Number of readers or `WRITER`.
+  Atomic<int> nWaitingWriters_ = {0}; ///< Writers waiting for the lock.
+  Atomic<int> nSleepers_       = {0}; ///< Threads sleeping on `state_`.
+
+private:
+
+  /**
+   * Sleep while state equals `state`.
+   */
+  void sleep(int state);
+
+  /**
+   * Wake sleeping threads if there are any.
+   */
+  void wakeSleepers();
+
+  /**
+   * Spin, then sleep until read lock is obtained.
+   */
+  void lockReadSlow();
+
+  /**
+   * Spin, then sleep until write lock is obtained.
+   */
+  void lockSlow();
+
+public:
+
+  /**
+   * Create an unlocked lock.
+   */
+  RWLock() = default;
+
+  /**
+   * Copying or moving is not possible.
+   */
+  RWLock(const RWLock&) = delete;
+
+  /**
+   * Copying or moving is not possible.
+   */
+  RWLock& operator=(const RWLock&) = delete;
+
+  /**
+   * Wait until read lock is obtained.
+   */
+  OZ_ALWAYS_INLINE
+  void lockRead()
+  {
+    int state = state_.load<ATOMIC_RELAXED>();
+
+    if ((state & WRITER) || nWaitingWriters_.load<ATOMIC_RELAXED>() != 0 ||
+        !state_.compareExchange<ATOMIC_ACQUIRE>(state, state + 1))
+    {
+      lockReadSlow();
+    }
+  }
+
+  /**
+   * Obtain read lock if no writer holds or waits for the lock.
+   *
+   * @return True on success.
+   */
+  bool tryLockRead();
+
+  /**
+   * Release read lock.
+   */
+  OZ_ALWAYS_INLINE
+  void unlockRead()
+  {
+    if (state_.fetchSub<ATOMIC_SEQ_CST>(1) == 1) {
+      wakeSleepers();
+    }
+  }
+
+  /**
+   * Wait until write lock is obtained.
+   */
+  OZ_ALWAYS_INLINE
+  void lock()
+  {
+    int expected = 0;
+
+    if (!state_.compareExchange<ATOMIC_ACQUIRE>(expected, WRITER)) {
+      lockSlow();
+    }
+  }
+
+  /**
+   * Obtain write lock if the lock is free.
+   *
+   * @return True on success.
+   */
+  bool tryLock();
+
+  /**
+   * Release write lock.
+   */
+  OZ_ALWAYS_INLINE
+  void unlock()
+  {
+    state_.store<ATOMIC_SEQ_CST>(0);
+    wakeSleepers();
+  }
+
+};
+
+}
@@ -197,6 +197,81 @@ public:
     return true;
   }
 
+  /**
+   * Number of true bits.
+   */
+  int count() const
+  {
+    int n = 0;
+
+    for (int i = 0; i < SIZE; ++i) {
+      n += __builtin_popcountll(data_[i]);
+    }
+    return n;
+  }
+
+  /**
+   * Index of the first true bit at position `i` or after it, -1 if there is none.
+   */
+  int findNextSet(int i) const
+  {
+    int unit = i / UNIT_BITS;
+
+    if (unit >= SIZE) {
+      return -1;
+    }
+
+    size_t bits = data_[unit] & (~size_t(0) << (i % UNIT_BITS));
+
+    while (bits == 0) {
+      if (++unit == SIZE) {
+        return -1;
+      }
+      bits = data_[unit];
+    }
+    return unit * UNIT_BITS + __builtin_ctzll(bits);
+  }
+
+  /**
+   * Index of the first false bit at position `i` or after it, -1 if there is none.
+   */
+  int findNextClear(int i) const
+  {
+    int unit = i / UNIT_BITS;
+
+    if (unit >= SIZE) {
+      return -1;
+    }
+
+    size_t bits = ~data_[unit] & (~size_t(0) << (i % UNIT_BITS));
+
+    while (bits == 0) {
+      if (++unit == SIZE) {
+        return -1;
+      }
+      bits = ~data_[unit];
+    }
+    return unit * UNIT_BITS + __builtin_ctzll(bits);
+  }
+
+  /**
+   * Call `func(i)` for index of each true bit in ascending order.
+   *
+   * Empty units are skipped as a whole and each call costs only one bit scan.
+   */
+  template <typename Func>
+  void forEachSet(Func func) const
+  {
+    for (int i = 0; i < SIZE; ++i) {
+      size_t bits = data_[i];
+
+      while (bits != 0) {
+        func(i * UNIT_BITS + __builtin_ctzll(bits));
+        bits &= bits - 1;
+      }
+    }
+  }
+
   /**
    * Get the `i`-th bit.
    */
@@ -321,6 +396,17 @@ public:
     return *this;
   }
 
+  /**
+   * Clear all bits that are true in a given bitset, i.e. `*this &= ~b` without a temporary.
+   */
+  SBitset& andNot(const SBitset& b)
+  {
+    for (int i = 0; i < SIZE; ++i) {
+      data_[i] &= ~b.data_[i];
+    }
+    return *this;
+  }
+
 };
 
 }
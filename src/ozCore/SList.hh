@@ -513,7 +513,7 @@ public:
   }
 
   /**
-   * Sort elements with quicksort.
+   * Sort elements with introsort.
    */
   template <class LessFunc = Less<Elem>>
   void sort()
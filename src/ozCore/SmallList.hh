@@ -0,0 +1,735 @@
+/*
+ * ozCore - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file ozCore/SmallList.hh
+ *
+ * `SmallList` class template.
+ */
+
+#pragma once
+
+#include "Arrays.hh"
+
+namespace oz
+{
+
+/**
+ * Array list with inline storage for the first `INLINE_SIZE` elements.
+ *
+ * Elements are kept in a member array until they no longer fit, then they are moved to a heap array
+ * that grows like `List` storage. `trim()`, `resize()` and `reserve()` with exact capacity move
+ * them back when they fit again. Capacity is never less than `INLINE_SIZE`.
+ *
+ * All inline elements are constructed all the time and elements are moved between the inline and
+ * the heap storage, so addresses of elements change on spill, on move and whenever the list itself
+ * is moved. Moving a list with inline elements moves elements one by one.
+ *
+ * The interface is the same as `List`, so it is a drop-in replacement for small hot collections
+ * whose size is usually bounded, like items in an inventory or structures in a cell.
+ *
+ * @sa `oz::List`, `oz::SList`
+ */
+template <typename Elem, int INLINE_SIZE>
+class SmallList
+{
+  static_assert(INLINE_SIZE > 0, "oz::SmallList inline size must be at least 1");
+
+public:
+
+  /**
+   * %Iterator with constant access to elements.
+   */
+  typedef Arrays::CIterator<Elem> CIterator;
+
+  /**
+   * %Iterator with non-constant access to elements.
+   */
+  typedef Arrays::Iterator<Elem> Iterator;
+
+private:
+
+  Elem* data_                    = inlineData_; ///< Inline or heap array of elements.
+  int   size_                    = 0;           ///< Number of elements.
+  int   capacity_                = INLINE_SIZE; ///< Capacity, number of elements in storage.
+  Elem  inlineData_[INLINE_SIZE] = {};          ///< Inline storage.
+
+private:
+
+  /**
+   * Move elements to new storage of a given capacity, which is inline if it fits.
+   *
+   * Only first `min(size_, newCapacity)` elements are preserved, `size_` is not updated.
+   */
+  void reallocate(int newCapacity)
+  {
+    int nKept = min<int>(size_, newCapacity);
+
+    if (newCapacity <= INLINE_SIZE) {
+      if (data_ != inlineData_) {
+        Arrays::move<Elem>(data_, nKept, inlineData_);
+        delete[] data_;
+
+        data_     = inlineData_;
+        capacity_ = INLINE_SIZE;
+      }
+    }
+    else if (newCapacity != capacity_) {
+      Elem* newData = new Elem[newCapacity] {};
+
+      Arrays::move<Elem>(data_, nKept, newData);
+
+      if (data_ == inlineData_) {
+        Arrays::clear<Elem>(inlineData_, size_);
+      }
+      else {
+        delete[] data_;
+      }
+
+      data_     = newData;
+      capacity_ = newCapacity;
+    }
+  }
+
+  /**
+   * Ensure a given capacity.
+   *
+   * The capacity is increased if necessary with growth factor 1.5.
+   */
+  void ensureCapacity(int requestedCapacity)
+  {
+    if (requestedCapacity < 0) {
+      OZ_ERROR("oz::SmallList: Negative capacity (overflow?)");
+    }
+    else if (capacity_ < requestedCapacity) {
+      reallocate(max<int>(capacity_ + capacity_ / 2, requestedCapacity));
+    }
+  }
+
+  /**
+   * Take storage or elements of another list, this list must be empty and inline.
+   */
+  void take(SmallList& other)
+  {
+    if (other.data_ == other.inlineData_) {
+      Arrays::move<Elem>(other.inlineData_, other.size_, inlineData_);
+    }
+    else {
+      data_     = other.data_;
+      capacity_ = other.capacity_;
+
+      other.data_     = other.inlineData_;
+      other.capacity_ = INLINE_SIZE;
+    }
+
+    size_       = other.size_;
+    other.size_ = 0;
+  }
+
+public:
+
+  /**
+   * Create an empty list.
+   */
+  SmallList() = default;
+
+  /**
+   * Create a list with a given initial length and capacity.
+   */
+  explicit SmallList(int size)
+  {
+    resize(size, true);
+  }
+
+  /**
+   * Initialise from a C++ array.
+   */
+  explicit SmallList(const Elem* array, int size)
+  {
+    addAll(array, size);
+  }
+
+  /**
+   * Initialise from an initialiser list.
+   */
+  SmallList(InitialiserList<Elem> il)
+    : SmallList(il.begin(), int(il.size()))
+  {}
+
+  /**
+   * Destructor.
+   */
+  ~SmallList()
+  {
+    if (data_ != inlineData_) {
+      delete[] data_;
+    }
+  }
+
+  /**
+   * Copy constructor, copies elements.
+   */
+  SmallList(const SmallList& other)
+    : SmallList(other.data_, other.size_)
+  {}
+
+  /**
+   * Move constructor, moves heap storage or inline elements.
+   */
+  SmallList(SmallList&& other) noexcept
+  {
+    take(other);
+  }
+
+  /**
+   * Copy operator, copies elements.
+   *
+   * Existing storage is reused if it suffices.
+   */
+  SmallList& operator=(const SmallList& other)
+  {
+    if (&other != this) {
+      clear();
+      addAll(other.data_, other.size_);
+    }
+    return *this;
+  }
+
+  /**
+   * Move operator, moves heap storage or inline elements.
+   */
+  SmallList& operator=(SmallList&& other) noexcept
+  {
+    if (&other != this) {
+      clear();
+
+      if (data_ != inlineData_) {
+        delete[] data_;
+
+        data_     = inlineData_;
+        capacity_ = INLINE_SIZE;
+      }
+
+      take(other);
+    }
+    return *this;
+  }
+
+  /**
+   * Assign from an initialiser list.
+   *
+   * Existing storage is reused if it suffices.
+   */
+  SmallList& operator=(InitialiserList<Elem> il)
+  {
+    clear();
+    addAll(il.begin(), int(il.size()));
+
+    return *this;
+  }
+
+  /**
+   * True iff respective elements are equal.
+   */
+  bool operator==(const SmallList& other) const
+  {
+    return size_ == other.size_ && Arrays::equals<Elem>(data_, size_, other.data_);
+  }
+
+  /**
+   * False iff respective elements are equal.
+   */
+  bool operator!=(const SmallList& other) const
+  {
+    return !operator==(other);
+  }
+
+  /**
+   * %Iterator with constant access, initially points to the first element.
+   */
+  OZ_ALWAYS_INLINE
+  CIterator citerator() const
+  {
+    return CIterator(data_, data_ + size_);
+  }
+
+  /**
+   * %Iterator with non-constant access, initially points to the first element.
+   */
+  OZ_ALWAYS_INLINE
+  Iterator iterator()
+  {
+    return Iterator(data_, data_ + size_);
+  }
+
+  /**
+   * STL-style constant begin iterator.
+   */
+  OZ_ALWAYS_INLINE
+  const Elem* begin() const
+  {
+    return data_;
+  }
+
+  /**
+   * STL-style begin iterator.
+   */
+  OZ_ALWAYS_INLINE
+  Elem* begin()
+  {
+    return data_;
+  }
+
+  /**
+   * STL-style constant end iterator.
+   */
+  OZ_ALWAYS_INLINE
+  const Elem* end() const
+  {
+    return data_ + size_;
+  }
+
+  /**
+   * STL-style end iterator.
+   */
+  OZ_ALWAYS_INLINE
+  Elem* end()
+  {
+    return data_ + size_;
+  }
+
+  /**
+   * Number of elements.
+   */
+  OZ_ALWAYS_INLINE
+  int size() const
+  {
+    return size_;
+  }
+
+  /**
+   * True iff empty.
+   */
+  OZ_ALWAYS_INLINE
+  bool isEmpty() const
+  {
+    return size_ == 0;
+  }
+
+  /**
+   * Number of elements in storage, at least `INLINE_SIZE`.
+   */
+  OZ_ALWAYS_INLINE
+  int capacity() const
+  {
+    return capacity_;
+  }
+
+  /**
+   * True iff elements are stored inline.
+   */
+  OZ_ALWAYS_INLINE
+  bool isInline() const
+  {
+    return data_ == inlineData_;
+  }
+
+  /**
+   * Constant reference to the `i`-th element.
+   */
+  OZ_ALWAYS_INLINE
+  const Elem& operator[](int i) const
+  {
+    OZ_ASSERT(uint(i) < uint(size_));
+
+    return data_[i];
+  }
+
+  /**
+   * Reference to the `i`-th element.
+   */
+  OZ_ALWAYS_INLINE
+  Elem& operator[](int i)
+  {
+    OZ_ASSERT(uint(i) < uint(size_));
+
+    return data_[i];
+  }
+
+  /**
+   * Constant reference to the first element.
+   */
+  OZ_ALWAYS_INLINE
+  const Elem& first() const
+  {
+    OZ_ASSERT(size_ != 0);
+
+    return data_[0];
+  }
+
+  /**
+   * Reference to the first element.
+   */
+  OZ_ALWAYS_INLINE
+  Elem& first()
+  {
+    OZ_ASSERT(size_ != 0);
+
+    return data_[0];
+  }
+
+  /**
+   * Constant reference to the last element.
+   */
+  OZ_ALWAYS_INLINE
+  const Elem& last() const
+  {
+    OZ_ASSERT(size_ != 0);
+
+    return data_[size_ - 1];
+  }
+
+  /**
+   * Reference to the last element.
+   */
+  OZ_ALWAYS_INLINE
+  Elem& last()
+  {
+    OZ_ASSERT(size_ != 0);
+
+    return data_[size_ - 1];
+  }
+
+  /**
+   * True iff a given value is found in the list.
+   */
+  template <typename Key>
+  bool contains(const Key& key) const
+  {
+    return Arrays::contains<Elem, Key>(data_, size_, key);
+  }
+
+  /**
+   * Index of the first occurrence of the value or -1 if not found.
+   */
+  template <typename Key>
+  int index(const Key& key) const
+  {
+    return Arrays::index<Elem, Key>(data_, size_, key);
+  }
+
+  /**
+   * Index of the last occurrence of the value or -1 if not found.
+   */
+  template <typename Key>
+  int lastIndex(const Key& key) const
+  {
+    return Arrays::lastIndex<Elem, Key>(data_, size_, key);
+  }
+
+  /**
+   * Add an element to the end.
+   */
+  template <typename Elem_>
+  Elem& add(Elem_&& elem)
+  {
+    return insert<Elem_>(size_, static_cast<Elem_&&>(elem));
+  }
+
+  /**
+   * Add (copy) elements from a given array to the end.
+   */
+  void addAll(const Elem* array, int arrayCount)
+  {
+    int newCount = size_ + arrayCount;
+
+    ensureCapacity(newCount);
+
+    Arrays::copy<Elem>(array, arrayCount, data_ + size_);
+    size_ = newCount;
+  }
+
+  /**
+   * Add (move) elements from a given array to the end.
+   */
+  void takeAll(Elem* array, int arrayCount)
+  {
+    int newCount = size_ + arrayCount;
+
+    ensureCapacity(newCount);
+
+    Arrays::move<Elem>(array, arrayCount, data_ + size_);
+    size_ = newCount;
+  }
+
+  /**
+   * Add an element to the end if there is no equal element in the list.
+   *
+   * @return Position of the inserted or the existing equal element.
+   */
+  template <typename Elem_>
+  Elem& include(Elem_&& elem)
+  {
+    int i = Arrays::index<Elem, Elem>(data_, size_, elem);
+
+    if (i >= 0) {
+      return data_[i];
+    }
+    else {
+      return insert<Elem_>(size_, static_cast<Elem_&&>(elem));
+    }
+  }
+
+  /**
+   * Insert an element at a given position.
+   *
+   * All later elements are shifted to make the gap.
+   */
+  template <typename Elem_>
+  Elem& insert(int i, Elem_&& elem)
+  {
+    OZ_ASSERT(uint(i) <= uint(size_));
+
+    ensureCapacity(size_ + 1);
+
+    Arrays::moveBackward<Elem>(data_ + i, size_ - i, data_ + i + 1);
+    data_[i] = static_cast<Elem_&&>(elem);
+    ++size_;
+
+    return data_[i];
+  }
+
+  /**
+   * Remove the element at a given position.
+   *
+   * All later elements are shifted to fill the gap.
+   */
+  void erase(int i)
+  {
+    OZ_ASSERT(uint(i) < uint(size_));
+
+    --size_;
+
+    if (i == size_) {
+      // When removing the last element, no shift is performed, so it is not implicitly destroyed by
+      // the move operation.
+      data_[size_] = Elem();
+    }
+    else {
+      Arrays::move<Elem>(data_ + i + 1, size_ - i, data_ + i);
+    }
+  }
+
+  /**
+   * Remove the element at a given position from an unordered list.
+   *
+   * The last element is moved to its place.
+   */
+  void eraseUnordered(int i)
+  {
+    OZ_ASSERT(uint(i) < uint(size_));
+
+    --size_;
+
+    if (i == size_) {
+      // When removing the last element, no shift is performed, so it is not implicitly destroyed by
+      // the move operation.
+      data_[size_] = Elem();
+    }
+    else {
+      data_[i] = static_cast<Elem&&>(data_[size_]);
+    }
+  }
+
+  /**
+   * Find and remove the first element with a given value.
+   *
+   * @return Index of the removed element or -1 if not found.
+   */
+  template <typename Key>
+  int exclude(const Key& key)
+  {
+    int i = Arrays::index<Elem, Key>(data_, size_, key);
+
+    if (i >= 0) {
+      erase(i);
+    }
+    return i;
+  }
+
+  /**
+   * Find and remove the first element with a given value from an unordered list.
+   *
+   * The last element is moved to its place.
+   *
+   * @return Index of the removed element or -1 if not found.
+   */
+  template <typename Key>
+  int excludeUnordered(const Key& key)
+  {
+    int i = Arrays::index<Elem, Key>(data_, size_, key);
+
+    if (i >= 0) {
+      eraseUnordered(i);
+    }
+    return i;
+  }
+
+  /**
+   * Add an element to the beginning.
+   *
+   * All elements are shifted to make a gap.
+   */
+  template <typename Elem_>
+  Elem& pushFirst(Elem_&& elem)
+  {
+    return insert<Elem_>(0, static_cast<Elem_&&>(elem));
+  }
+
+  /**
+   * Add an element to the end.
+   */
+  template <typename Elem_>
+  Elem& pushLast(Elem_&& elem)
+  {
+    return insert<Elem_>(size_, static_cast<Elem_&&>(elem));
+  }
+
+  /**
+   * Remove the first element.
+   *
+   * All elements are shifted to fill the gap.
+   *
+   * @return Value of the removed element.
+   */
+  Elem popFirst()
+  {
+    if (size_ == 0) {
+      return Elem();
+    }
+    else {
+      Elem elem = static_cast<Elem&&>(data_[0]);
+
+      --size_;
+      Arrays::move<Elem>(data_ + 1, size_, data_);
+      return elem;
+    }
+  }
+
+  /**
+   * Remove the last element.
+   *
+   * @return Value of the removed element.
+   */
+  Elem popLast()
+  {
+    if (size_ == 0) {
+      return Elem();
+    }
+    else {
+      --size_;
+      return static_cast<Elem&&>(data_[size_]);
+    }
+  }
+
+  /**
+   * Reverse elements.
+   */
+  void reverse()
+  {
+    Arrays::reverse<Elem>(data_, size_);
+  }
+
+  /**
+   * Sort elements with introsort.
+   */
+  template <class LessFunc = Less<Elem>>
+  void sort()
+  {
+    Arrays::sort<Elem, LessFunc>(data_, size_);
+  }
+
+  /**
+   * Resize the list (and optionally its capacity too) to the specified number of elements.
+   *
+   * Exact capacity moves elements back inline if they fit.
+   */
+  void resize(int newCount, bool exactCapacity = false)
+  {
+    if (exactCapacity) {
+      Arrays::clear<Elem>(data_ + newCount, size_ - newCount);
+      reallocate(newCount);
+    }
+    else {
+      ensureCapacity(newCount);
+      Arrays::clear<Elem>(data_ + newCount, size_ - newCount);
+    }
+
+    size_ = newCount;
+  }
+
+  /**
+   * Increase capacity (exactly) to the given value if smaller.
+   */
+  void reserve(int capacity, bool exactCapacity = false)
+  {
+    if (exactCapacity) {
+      if (capacity_ < capacity) {
+        reallocate(capacity);
+      }
+    }
+    else {
+      ensureCapacity(capacity);
+    }
+  }
+
+  /**
+   * Trim capacity to the current number of elements or move them inline if they fit.
+   */
+  void trim()
+  {
+    if (size_ < capacity_) {
+      reallocate(size_);
+    }
+  }
+
+  /**
+   * Clear the list.
+   */
+  void clear()
+  {
+    Arrays::clear<Elem>(data_, size_);
+    size_ = 0;
+  }
+
+  /**
+   * Delete all objects referenced by elements (must be pointers) and clear the list.
+   */
+  void free()
+  {
+    Arrays::free<Elem>(data_, size_);
+    size_ = 0;
+  }
+
+};
+
+}
@@ -28,7 +28,7 @@
 
 #pragma once
 
-#include "Atomic.hh"
+#include "Futex.hh"
 
 namespace oz
 {
@@ -40,6 +40,11 @@ namespace oz
  */
 class SpinLock
 {
+public:
+
+  /// Maximum number of pause instructions between two reads of a taken lock.
+  static const int MAX_BACKOFF = 64;
+
 private:
 
   Atomic<bool> isLocked_ = {false}; ///< True iff locked.
@@ -63,15 +68,24 @@ public:
 
   /**
    * Loop performing a lock operation until it succeeds.
+   *
+   * While the lock is taken it only reads its state, backing off exponentially up to
+   * `MAX_BACKOFF` pause instructions between reads, so waiting threads do not keep stealing the
+   * cache line from the owner.
    */
   void lock()
   {
+    int backoff    = 1;
+    int maxBackoff = MAX_BACKOFF;
+
     while (isLocked_.testAndSet<ATOMIC_ACQUIRE>()) {
-#if defined(__ARM_ACLE__)
-      __builtin_arm_yield();
-#elif defined(__i386__) || defined(__x86_64__)
-      __builtin_ia32_pause();
-#endif
+      do {
+        for (int i = 0; i < backoff; ++i) {
+          Futex::pause();
+        }
+        backoff = min<int>(backoff * 2, maxBackoff);
+      }
+      while (isLocked_.load<ATOMIC_RELAXED>());
     }
   }
 
@@ -23,13 +23,25 @@
 #include "Stream.hh"
 
 #include "Alloc.hh"
+#include "JobSystem.hh"
 
 #include <cstring>
+#include <lz4/lz4.h>
 #include <zlib.h>
+#if !defined(__native_client__) && !defined(_WIN32)
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
 
 namespace oz
 {
 
+static const int   QUAT_COMPONENT_BITS = 10;
+static const uint  QUAT_COMPONENT_MASK = (1u << QUAT_COMPONENT_BITS) - 1;
+static const float QUAT_COMPONENT_MAX  = 0.70710678f; // 1/sqrt(2), bound of non-largest components.
+
+const int Stream::CHUNK_SIZE;
+
 void Stream::readFloats(float* values, int count)
 {
   const char* data = readSkip(count * sizeof(float));
@@ -211,6 +223,20 @@ void Stream::free()
     begin_ = nullptr;
     end_   = nullptr;
   }
+#if !defined(__native_client__) && !defined(_WIN32)
+  else if (flags_ & MAPPED) {
+    // Mappings start at a page boundary, data may begin later when mapped from inside an archive.
+    size_t pageSize = size_t(sysconf(_SC_PAGESIZE));
+    char*  mapping  = begin_ - size_t(begin_) % pageSize;
+
+    munmap(mapping, size_t(end_ - mapping));
+
+    pos_   = nullptr;
+    begin_ = nullptr;
+    end_   = nullptr;
+    flags_ = 0;
+  }
+#endif
 }
 
 void Stream::read(char* array, int count)
@@ -447,6 +473,205 @@ void Stream::writeDouble(double d)
   }
 }
 
+uint Stream::readVarUInt()
+{
+  return uint(readVarULong64());
+}
+
+void Stream::writeVarUInt(uint i)
+{
+  writeVarULong64(i);
+}
+
+int Stream::readVarInt()
+{
+  uint z = readVarUInt();
+  return int(z >> 1) ^ -int(z & 1);
+}
+
+void Stream::writeVarInt(int i)
+{
+  writeVarUInt((uint(i) << 1) ^ uint(i >> 31));
+}
+
+ulong64 Stream::readVarULong64()
+{
+  ulong64 l = 0;
+
+  for (int shift = 0; shift < 64; shift += 7) {
+    ubyte b = readUByte();
+
+    l |= ulong64(b & 0x7f) << shift;
+
+    if (!(b & 0x80)) {
+      return l;
+    }
+  }
+
+  OZ_ERROR("oz::Stream: Malformed varint");
+}
+
+void Stream::writeVarULong64(ulong64 l)
+{
+  while (l >= 0x80) {
+    writeUByte(ubyte(l | 0x80));
+    l >>= 7;
+  }
+  writeUByte(ubyte(l));
+}
+
+long64 Stream::readVarLong64()
+{
+  ulong64 z = readVarULong64();
+  return long64(z >> 1) ^ -long64(z & 1);
+}
+
+void Stream::writeVarLong64(long64 l)
+{
+  writeVarULong64((ulong64(l) << 1) ^ ulong64(l >> 63));
+}
+
+int Stream::readDeltaInt(int reference)
+{
+  return int(uint(reference) + uint(readVarInt()));
+}
+
+void Stream::writeDeltaInt(int i, int reference)
+{
+  writeVarInt(int(uint(i) - uint(reference)));
+}
+
+uint Stream::readFlags(uint mask)
+{
+  uint flags = 0;
+  uint bits  = 0;
+  int  nBits = 0;
+
+  for (uint m = mask; m != 0; m &= m - 1) {
+    if (nBits % 8 == 0) {
+      bits = readUByte();
+    }
+
+    flags |= ((bits >> (nBits % 8)) & 1u) << __builtin_ctz(m);
+    ++nBits;
+  }
+  return flags;
+}
+
+void Stream::writeFlags(uint flags, uint mask)
+{
+  uint bits  = 0;
+  int  nBits = 0;
+
+  for (uint m = mask; m != 0; m &= m - 1) {
+    bits |= ((flags >> __builtin_ctz(m)) & 1u) << (nBits % 8);
+    ++nBits;
+
+    if (nBits % 8 == 0) {
+      writeUByte(ubyte(bits));
+      bits = 0;
+    }
+  }
+  if (nBits % 8 != 0) {
+    writeUByte(ubyte(bits));
+  }
+}
+
+Point Stream::readQuantizedPoint(float precision)
+{
+  float x = float(readVarInt()) * precision;
+  float y = float(readVarInt()) * precision;
+  float z = float(readVarInt()) * precision;
+
+  return Point(x, y, z);
+}
+
+void Stream::writeQuantizedPoint(const Point& p, float precision)
+{
+  writeVarInt(Math::lround(p.x / precision));
+  writeVarInt(Math::lround(p.y / precision));
+  writeVarInt(Math::lround(p.z / precision));
+}
+
+Vec3 Stream::readQuantizedVec3(float precision)
+{
+  float x = float(readVarInt()) * precision;
+  float y = float(readVarInt()) * precision;
+  float z = float(readVarInt()) * precision;
+
+  return Vec3(x, y, z);
+}
+
+void Stream::writeQuantizedVec3(const Vec3& v, float precision)
+{
+  writeVarInt(Math::lround(v.x / precision));
+  writeVarInt(Math::lround(v.y / precision));
+  writeVarInt(Math::lround(v.z / precision));
+}
+
+Point Stream::readDeltaPoint(const Point& reference, float precision)
+{
+  float x = float(readDeltaInt(Math::lround(reference.x / precision))) * precision;
+  float y = float(readDeltaInt(Math::lround(reference.y / precision))) * precision;
+  float z = float(readDeltaInt(Math::lround(reference.z / precision))) * precision;
+
+  return Point(x, y, z);
+}
+
+void Stream::writeDeltaPoint(const Point& p, const Point& reference, float precision)
+{
+  writeDeltaInt(Math::lround(p.x / precision), Math::lround(reference.x / precision));
+  writeDeltaInt(Math::lround(p.y / precision), Math::lround(reference.y / precision));
+  writeDeltaInt(Math::lround(p.z / precision), Math::lround(reference.z / precision));
+}
+
+Quat Stream::readCompressedQuat()
+{
+  uint  packed  = readUInt();
+  int   largest = int(packed >> 30);
+  float sum     = 0.0f;
+  Quat  q;
+
+  for (int i = 3, shift = 0; i >= 0; --i) {
+    if (i != largest) {
+      float c = float((packed >> shift) & QUAT_COMPONENT_MASK) / float(QUAT_COMPONENT_MASK);
+
+      q[i]   = (2.0f * c - 1.0f) * QUAT_COMPONENT_MAX;
+      sum   += q[i] * q[i];
+      shift += QUAT_COMPONENT_BITS;
+    }
+  }
+
+  q[largest] = Math::sqrt(max(1.0f - sum, 0.0f));
+  return q;
+}
+
+void Stream::writeCompressedQuat(const Quat& q)
+{
+  int largest = 0;
+
+  for (int i = 1; i < 4; ++i) {
+    if (abs(q[i]) > abs(q[largest])) {
+      largest = i;
+    }
+  }
+
+  // Store the rotation with the positive largest component, so it needs no sign.
+  float sign   = q[largest] < 0.0f ? -1.0f : 1.0f;
+  uint  packed = uint(largest) << 30;
+
+  for (int i = 3, shift = 0; i >= 0; --i) {
+    if (i != largest) {
+      float c = clamp(sign * q[i] / QUAT_COMPONENT_MAX * 0.5f + 0.5f, 0.0f, 1.0f);
+
+      packed |= uint(Math::lround(c * float(QUAT_COMPONENT_MASK))) << shift;
+      shift  += QUAT_COMPONENT_BITS;
+    }
+  }
+
+  writeUInt(packed);
+}
+
 const char* Stream::readString()
 {
   const char* begin = pos_;
@@ -499,8 +724,81 @@ void Stream::writeLine(const char* s)
   pos_[-1] = '\n';
 }
 
+static int readHeaderInt(const char* data, int index)
+{
+  int value = reinterpret_cast<const int*>(data)[index];
+
+#if OZ_BYTE_ORDER == 4321
+  return Endian::bswap32(value);
+#else
+  return value;
+#endif
+}
+
+static void writeHeaderInt(char* data, int index, int value)
+{
+#if OZ_BYTE_ORDER == 4321
+  reinterpret_cast<int*>(data)[index] = Endian::bswap32(value);
+#else
+  reinterpret_cast<int*>(data)[index] = value;
+#endif
+}
+
 Stream Stream::compress(int level) const
 {
+  return compress(DEFLATE, level);
+}
+
+Stream Stream::compress(Codec codec, int level) const
+{
+  if (codec == LZ4) {
+    // Header: original size, order | codec << 8, chunk size and compressed size for each chunk.
+    int size       = tell();
+    int nChunks    = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    int headerSize = (3 + nChunks) * int(sizeof(int));
+    int slotSize   = LZ4_compressBound(CHUNK_SIZE);
+    int outSize    = headerSize + nChunks * slotSize;
+    Stream out     = Stream(outSize, Endian::LITTLE);
+    char*  outData = out.begin_;
+
+    // Each chunk is compressed into its own worst-case slot, slots are compacted afterwards.
+    JobSystem::parallelFor(0, nChunks, 1, [&](int first, int last)
+    {
+      for (int i = first; i < last; ++i) {
+        int inSize = min<int>(size - i * CHUNK_SIZE, CHUNK_SIZE);
+        int nBytes = LZ4_compress(begin_ + i * CHUNK_SIZE, outData + headerSize + i * slotSize,
+                                  inSize);
+
+        writeHeaderInt(outData, 3 + i, nBytes);
+      }
+    });
+
+    bool isFailed = false;
+
+    int offset = headerSize;
+
+    for (int i = 0; i < nChunks; ++i) {
+      int chunkSize = readHeaderInt(outData, 3 + i);
+
+      isFailed |= chunkSize <= 0;
+      memmove(outData + offset, outData + headerSize + i * slotSize,
+              size_t(max<int>(chunkSize, 0)));
+      offset += chunkSize;
+    }
+
+    if (isFailed) {
+      return Stream();
+    }
+
+    writeHeaderInt(outData, 0, size);
+    writeHeaderInt(outData, 1, order_ | LZ4 << 8);
+    writeHeaderInt(outData, 2, CHUNK_SIZE);
+
+    out.seek(offset);
+    out.resize(offset);
+    return out;
+  }
+
   z_stream zstream;
   zstream.zalloc = nullptr;
   zstream.zfree  = nullptr;
@@ -532,15 +830,8 @@ Stream Stream::compress(int level) const
     out.resize(outSize);
 
     // Write size and order of the original data (in little endian).
-    int* start = reinterpret_cast<int*>(out.begin_);
-
-#if OZ_BYTE_ORDER == 4321
-    start[0] = Endian::bswap32(tell());
-    start[1] = Endian::bswap32(order_);
-#else
-    start[0] = tell();
-    start[1] = order_;
-#endif
+    writeHeaderInt(out.begin_, 0, tell());
+    writeHeaderInt(out.begin_, 1, order_);
 
     return out;
   }
@@ -552,6 +843,73 @@ Stream Stream::decompress() const
     return Stream();
   }
 
+  int           outSize  = readHeaderInt(begin_, 0);
+  int           flags    = readHeaderInt(begin_, 1);
+  Endian::Order outOrder = Endian::Order(flags & 0xff);
+  Codec         codec    = Codec(flags >> 8);
+
+  if (outSize < 0) {
+    return Stream();
+  }
+  else if (codec == LZ4) {
+    if (capacity() < 12) {
+      return Stream();
+    }
+
+    int chunkSize  = readHeaderInt(begin_, 2);
+    int nChunks    = chunkSize <= 0 ? 0 : int((long64(outSize) + chunkSize - 1) / chunkSize);
+    int headerSize = (3 + nChunks) * int(sizeof(int));
+
+    if (chunkSize <= 0 || capacity() < headerSize) {
+      return Stream();
+    }
+
+    // Chunk offsets are prefix sums of compressed sizes, computed upfront so chunks can be decoded
+    // independently.
+    List<int> offsets(nChunks);
+    long64    offset = headerSize;
+
+    for (int i = 0; i < nChunks; ++i) {
+      int compressedSize = readHeaderInt(begin_, 3 + i);
+
+      if (compressedSize <= 0) {
+        return Stream();
+      }
+
+      offsets[i] = int(offset);
+      offset    += compressedSize;
+    }
+
+    if (offset != capacity()) {
+      return Stream();
+    }
+
+    Stream      out(outSize, outOrder);
+    Atomic<int> nFailed = {0};
+
+    JobSystem::parallelFor(0, nChunks, 1, [&](int first, int last)
+    {
+      for (int i = first; i < last; ++i) {
+        int inSize  = (i == nChunks - 1 ? capacity() : offsets[i + 1]) - offsets[i];
+        int outSize = min<int>(out.capacity() - i * chunkSize, chunkSize);
+        int nBytes  = LZ4_decompress_safe(begin_ + offsets[i], out.begin_ + i * chunkSize, inSize,
+                                          outSize);
+
+        if (nBytes != outSize) {
+          nFailed.fetchAdd<ATOMIC_RELAXED>(1);
+        }
+      }
+    });
+
+    if (nFailed.load<ATOMIC_RELAXED>() != 0) {
+      return Stream();
+    }
+    return out;
+  }
+  else if (codec != DEFLATE) {
+    return Stream();
+  }
+
   z_stream zstream;
   zstream.zalloc = nullptr;
   zstream.zfree  = nullptr;
@@ -561,16 +919,6 @@ Stream Stream::decompress() const
     return Stream();
   }
 
-  const int* start = reinterpret_cast<int*>(begin_);
-
-#if OZ_BYTE_ORDER == 4321
-  int           outSize  = Endian::bswap32(start[0]);
-  Endian::Order outOrder = Endian::Order(Endian::bswap32(start[1]));
-#else
-  int           outSize  = start[0];
-  Endian::Order outOrder = Endian::Order(start[1]);
-#endif
-
   Stream out(outSize, outOrder);
 
   zstream.next_in   = reinterpret_cast<ubyte*>(const_cast<char*>(begin_ + 8));
@@ -40,6 +40,23 @@ namespace oz
  */
 class Stream
 {
+public:
+
+  /**
+   * Compression codec.
+   */
+  enum Codec
+  {
+    /// Deflate (ZIP/GZip) over the whole stream, small output.
+    DEFLATE,
+
+    /// LZ4 over independent chunks that are compressed and decompressed in parallel, very fast.
+    LZ4
+  };
+
+  /// Chunk size for chunked codecs.
+  static const int CHUNK_SIZE = 256 * 1024;
+
 private:
 
   /// Writing to stream is enabled.
@@ -48,6 +65,9 @@ private:
   /// Stream has its own internal buffer.
   static const int BUFFERED = 0x2;
 
+  /// Stream is a read-only memory mapping of a file (created by `File::map()`).
+  static const int MAPPED = 0x4;
+
 private:
 
   char*         pos_   = nullptr;        ///< Current position.
@@ -68,6 +88,8 @@ private:
    */
   void writeFloats(const float* values, int count);
 
+  friend class File;
+
 public:
 
   /**
@@ -199,6 +221,15 @@ public:
     return flags_ & BUFFERED;
   }
 
+  /**
+   * True iff it is a read-only view of a memory-mapped file.
+   */
+  OZ_ALWAYS_INLINE
+  bool isMapped() const
+  {
+    return flags_ & MAPPED;
+  }
+
   /**
    * %Endian order.
    */
@@ -289,7 +320,7 @@ public:
   char* writeSkip(int count);
 
   /**
-   * Deallocate underlaying buffer if the stream is buffered.
+   * Deallocate underlaying buffer if the stream is buffered or unmap it if the stream is mapped.
    */
   void free();
 
@@ -423,6 +454,119 @@ public:
    */
   void writeDouble(double d);
 
+  /**
+   * Read LEB128-encoded unsigned integer.
+   */
+  uint readVarUInt();
+
+  /**
+   * Write unsigned integer in LEB128 encoding, 1 byte for values < 128, up to 5 bytes.
+   */
+  void writeVarUInt(uint i);
+
+  /**
+   * Read zigzag LEB128-encoded integer.
+   */
+  int readVarInt();
+
+  /**
+   * Write integer in zigzag LEB128 encoding, so values of small magnitude take few bytes even when
+   * negative.
+   */
+  void writeVarInt(int i);
+
+  /**
+   * Read LEB128-encoded unsigned 64-bit integer.
+   */
+  ulong64 readVarULong64();
+
+  /**
+   * Write unsigned 64-bit integer in LEB128 encoding, up to 10 bytes.
+   */
+  void writeVarULong64(ulong64 l);
+
+  /**
+   * Read zigzag LEB128-encoded 64-bit integer.
+   */
+  long64 readVarLong64();
+
+  /**
+   * Write 64-bit integer in zigzag LEB128 encoding.
+   */
+  void writeVarLong64(long64 l);
+
+  /**
+   * Read integer written by `writeDeltaInt()` against the same reference.
+   */
+  int readDeltaInt(int reference);
+
+  /**
+   * Write difference from a reference value as a zigzag varint.
+   */
+  void writeDeltaInt(int i, int reference);
+
+  /**
+   * Read bits written by `writeFlags()` with the same mask, other bits are zero.
+   */
+  uint readFlags(uint mask);
+
+  /**
+   * Write only bits of `flags` that are selected by `mask`, packed together.
+   *
+   * Takes `ceil(popcount(mask) / 8)` bytes, so flags that are known to the reader (e.g. the ones
+   * that come from an object class) need not be stored.
+   */
+  void writeFlags(uint flags, uint mask);
+
+  /**
+   * Read point written by `writeQuantizedPoint()` with the same precision.
+   */
+  Point readQuantizedPoint(float precision);
+
+  /**
+   * Write point rounded to a multiple of `precision` as three zigzag varints.
+   *
+   * Reading returns the point snapped to the grid, at most `precision / 2` off on each axis.
+   */
+  void writeQuantizedPoint(const Point& p, float precision);
+
+  /**
+   * Read vector written by `writeQuantizedVec3()` with the same precision.
+   */
+  Vec3 readQuantizedVec3(float precision);
+
+  /**
+   * Write vector rounded to a multiple of `precision` as three zigzag varints.
+   */
+  void writeQuantizedVec3(const Vec3& v, float precision);
+
+  /**
+   * Read point written by `writeDeltaPoint()` against the same reference and precision.
+   */
+  Point readDeltaPoint(const Point& reference, float precision);
+
+  /**
+   * Write quantised point as a difference from a quantised reference point.
+   *
+   * Decoding is exact on the grid: the result equals what `readQuantizedPoint()` would return for
+   * the point, independent of the reference.
+   */
+  void writeDeltaPoint(const Point& p, const Point& reference, float precision);
+
+  /**
+   * Read quaternion written by `writeCompressedQuat()`.
+   */
+  Quat readCompressedQuat();
+
+  /**
+   * Write unit quaternion in 4 bytes using smallest-three encoding.
+   *
+   * The largest component is dropped and restored from the unit length on reading, the other three
+   * are stored in 10 bits each. The maximum error per component is about 0.0007. The result may be
+   * negated, which represents the same rotation.
+   */
+  void writeCompressedQuat(const Quat& q);
+
   /**
    * Read string.
    */
@@ -515,7 +659,19 @@ public:
   Stream compress(int level = -1) const;
 
   /**
-   * Decompress data compressed with deflate (ZIP/GZip) algorithm.
+   * Compress using a given codec.
+   *
+   * `LZ4` output is split into `CHUNK_SIZE` chunks that are compressed independently via
+   * `JobSystem::parallelFor()`.
+   *
+   * An empty stream is returned on an error.
+   *
+   * @param level compression level for `DEFLATE`, ignored by `LZ4`.
+   */
+  Stream compress(Codec codec, int level = -1) const;
+
+  /**
+   * Decompress data compressed by `compress()`, codec is detected from the header.
    *
    * An empty stream is returned on an error.
    */
@@ -33,6 +33,31 @@ static const int LOCAL_BUFFER_SIZE = 4096;
 
 const String String::EMPTY = String();
 
+static const ulong64 POWERS_OF_10[] = {
+  1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+/**
+ * Write decimal digits of `n`, zero-padded to `minDigits`, without terminating null byte.
+ */
+static int writeDigits(char* buffer, ulong64 n, int minDigits)
+{
+  char digits[20];
+  int  nDigits = 0;
+
+  do {
+    digits[nDigits] = char('0' + n % 10);
+    ++nDigits;
+    n /= 10;
+  }
+  while (n != 0 || nDigits < minDigits);
+
+  for (int i = 0; i < nDigits; ++i) {
+    buffer[i] = digits[nDigits - 1 - i];
+  }
+  return nDigits;
+}
+
 char* String::resize(int newSize, bool keepContents)
 {
   OZ_ASSERT(size_ >= 0 && newSize >= 0);
@@ -307,6 +332,53 @@ String::String(String&& other) noexcept
   other.baseData_[0] = '\0';
 }
 
+int String::formatInt(char* buffer, long64 i)
+{
+  ulong64 n      = ulong64(i);
+  int     length = 0;
+
+  if (i < 0) {
+    buffer[length] = '-';
+    ++length;
+    n = 0 - n;
+  }
+
+  length += writeDigits(buffer + length, n, 1);
+  buffer[length] = '\0';
+  return length;
+}
+
+int String::formatFloat(char* buffer, double d, int precision)
+{
+  OZ_ASSERT(0 <= precision && precision <= 9);
+
+  double scaled = abs(d) * double(POWERS_OF_10[precision]);
+
+  // Also catches NaN and infinity.
+  if (!(scaled < 1e19)) {
+    return snprintf(buffer, FLOAT_BUFFER_SIZE, "%.*e", precision, d);
+  }
+
+  ulong64 n      = ulong64(scaled + 0.5);
+  int     length = 0;
+
+  if (d < 0.0 && n != 0) {
+    buffer[length] = '-';
+    ++length;
+  }
+
+  length += writeDigits(buffer + length, n / POWERS_OF_10[precision], 1);
+
+  if (precision != 0) {
+    buffer[length] = '.';
+    ++length;
+    length += writeDigits(buffer + length, n % POWERS_OF_10[precision], precision);
+  }
+
+  buffer[length] = '\0';
+  return length;
+}
+
 String& String::operator=(const String& other)
 {
   if (&other != this) {
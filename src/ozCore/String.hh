@@ -51,6 +51,12 @@ public:
   /// Empty string. Useful when a function needs to return a reference to an empty string.
   static const String EMPTY;
 
+  /// Buffer size sufficient for any `formatInt()` output.
+  static const int INT_BUFFER_SIZE = 21;
+
+  /// Buffer size sufficient for any `formatFloat()` output.
+  static const int FLOAT_BUFFER_SIZE = 32;
+
 public:
 
   /**
@@ -261,6 +267,24 @@ public:
    */
   static double parseDouble(const char* s, const char** end = nullptr);
 
+  /**
+   * Write decimal representation of an integer to a buffer and return its length.
+   *
+   * Same as `snprintf(buffer, INT_BUFFER_SIZE, "%lld", i)` without parsing a format string.
+   */
+  static int formatInt(char* buffer, long64 i);
+
+  /**
+   * Write a number with a fixed number of decimals to a buffer and return its length.
+   *
+   * Same as `snprintf(buffer, FLOAT_BUFFER_SIZE, "%.*f", precision, d)` for finite values whose
+   * magnitude times `10^precision` is below 10^19, except that ties are rounded away from zero and
+   * values that round to zero are never printed with a sign. Other values fall back to `%.*e`.
+   *
+   * @param precision number of decimals, 0 to 9.
+   */
+  static int formatFloat(char* buffer, double d, int precision);
+
   /*
    * Functions that operate on a String object.
    */
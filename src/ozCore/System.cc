@@ -22,6 +22,7 @@
 
 #include "System.hh"
 
+#include "CallOnce.hh"
 #include "SpinLock.hh"
 #include "Log.hh"
 #include "Pepper.hh"
@@ -40,6 +41,7 @@
 #elif defined(__EMSCRIPTEN__)
 # include <pthread.h>
 # include <SDL2/SDL.h>
+# include <unistd.h>
 #elif defined(__native_client__)
 # include <ppapi/cpp/audio.h>
 # include <ppapi/cpp/completion_callback.h>
@@ -47,6 +49,7 @@
 # include <ppapi_simple/ps.h>
 # include <ppapi_simple/ps_interface.h>
 # include <pthread.h>
+# include <unistd.h>
 #elif defined(_WIN32)
 # include <pthread.h>
 # include <windows.h>
@@ -54,6 +57,7 @@
 #else
 # include <alsa/asoundlib.h>
 # include <pthread.h>
+# include <unistd.h>
 #endif
 
 namespace oz
@@ -114,6 +118,8 @@ static pthread_t             bellThread;
 static bool                  hasBellThread = false;
 static System::CrashHandler* crashHandler  = nullptr;
 static int                   initFlags     = 0;
+static System::CpuTopology   topology;
+static CallOnce              topologyOnce;
 
 OZ_NORETURN
 static void abort(bool doHalt);
@@ -130,6 +136,7 @@ static void signalHandler(int sigNum)
 #endif
   Log::printTrace(StackTrace::current(1));
   Log::println();
+  Log::flush();
 
 #ifdef __ANDROID__
   __android_log_print(ANDROID_LOG_FATAL, "oz", "Signal %d\n", sigNum);
@@ -418,8 +425,163 @@ static void abort(bool doHalt)
   _Exit(EXIT_FAILURE);
 }
 
+#ifdef __linux__
+
+/**
+ * Read an integer from a sysfs file, -1 on failure. Size suffixes 'K' and 'M' are applied.
+ */
+static int readSysInt(const char* path)
+{
+  FILE* file = fopen(path, "r");
+  if (file == nullptr) {
+    return -1;
+  }
+
+  long value  = 0;
+  char suffix = '\0';
+  int  nRead  = fscanf(file, "%ld%c", &value, &suffix);
+
+  fclose(file);
+
+  if (nRead < 1) {
+    return -1;
+  }
+  return int(suffix == 'K' ? value * 1024 : suffix == 'M' ? value * 1024 * 1024 : value);
+}
+
+/**
+ * Mark CPUs from a sysfs CPU list like "0-3,8,10-11".
+ */
+static bool readSysCpuList(const char* path, bool* cpus)
+{
+  FILE* file = fopen(path, "r");
+  if (file == nullptr) {
+    return false;
+  }
+
+  int first;
+  while (fscanf(file, "%d", &first) == 1) {
+    int last = first;
+    int ch   = fgetc(file);
+
+    if (ch == '-') {
+      if (fscanf(file, "%d", &last) != 1) {
+        break;
+      }
+      ch = fgetc(file);
+    }
+
+    for (int i = max<int>(first, 0); i <= last && i < System::MAX_CPUS; ++i) {
+      cpus[i] = true;
+    }
+
+    if (ch != ',') {
+      break;
+    }
+  }
+
+  fclose(file);
+  return true;
+}
+
+static void readSysTopology()
+{
+  bool online[System::MAX_CPUS] = {};
+  int  coreIds[System::MAX_CPUS];
+  int  corePackages[System::MAX_CPUS];
+  int  packageIds[System::MAX_CPUS];
+  char path[128];
+
+  if (!readSysCpuList("/sys/devices/system/cpu/online", online)) {
+    return;
+  }
+
+  for (int i = 0; i < System::MAX_CPUS; ++i) {
+    if (!online[i]) {
+      continue;
+    }
+
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/core_id", i);
+    int coreId = readSysInt(path);
+
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", i);
+    int packageId = max(readSysInt(path), 0);
+
+    // Unknown core id, treat the CPU as a core of its own.
+    if (coreId < 0) {
+      coreId = -1 - i;
+    }
+
+    int core = 0;
+    while (core < topology.nCores &&
+           (coreIds[core] != coreId || corePackages[core] != packageId))
+    {
+      ++core;
+    }
+
+    bool isPrimary = core == topology.nCores;
+    if (isPrimary) {
+      coreIds[core]      = coreId;
+      corePackages[core] = packageId;
+      ++topology.nCores;
+    }
+
+    int package = 0;
+    while (package < topology.nPackages && packageIds[package] != packageId) {
+      ++package;
+    }
+    if (package == topology.nPackages) {
+      packageIds[package] = packageId;
+      ++topology.nPackages;
+    }
+
+    topology.cpus[topology.nCpus] = {i, core, packageId, isPrimary};
+    ++topology.nCpus;
+  }
+
+  for (int i = 0; i < 16; ++i) {
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/level", i);
+    int level = readSysInt(path);
+
+    if (level < 0) {
+      break;
+    }
+
+    char type[16] = "";
+
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/type", i);
+    FILE* file = fopen(path, "r");
+    if (file != nullptr) {
+      if (fscanf(file, "%15s", type) != 1) {
+        type[0] = '\0';
+      }
+      fclose(file);
+    }
+
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/size", i);
+    int size = max(readSysInt(path), 0);
+
+    if (level == 1 && !String::equals(type, "Instruction")) {
+      snprintf(path, sizeof(path),
+               "/sys/devices/system/cpu/cpu0/cache/index%d/coherency_line_size", i);
+
+      topology.l1DataCacheSize = size;
+      topology.cacheLineSize   = max(readSysInt(path), 0);
+    }
+    else if (level == 2) {
+      topology.l2CacheSize = size;
+    }
+    else if (level == 3) {
+      topology.l3CacheSize = size;
+    }
+  }
+}
+
+#endif
+
 const int System::HANDLER_BIT;
 const int System::HALT_BIT;
+const int System::MAX_CPUS;
 
 void System::trap()
 {
@@ -468,11 +630,42 @@ void System::error(const char* function, const char* file, int line, int nSkippe
 
   Log::printTrace(StackTrace::current(nSkippedFrames + 1));
   Log::println();
+  Log::flush();
 
   bell();
   abort(initFlags & HALT_BIT);
 }
 
+const System::CpuTopology& System::cpuTopology()
+{
+  topologyOnce << []
+  {
+#ifdef __linux__
+    readSysTopology();
+#endif
+
+    if (topology.nCpus == 0) {
+#ifdef _WIN32
+      SYSTEM_INFO systemInfo;
+      GetSystemInfo(&systemInfo);
+
+      int nCpus = clamp<int>(int(systemInfo.dwNumberOfProcessors), 1, MAX_CPUS);
+#else
+      int nCpus = clamp<int>(int(sysconf(_SC_NPROCESSORS_ONLN)), 1, MAX_CPUS);
+#endif
+
+      for (int i = 0; i < nCpus; ++i) {
+        topology.cpus[i] = {i, i, 0, true};
+      }
+
+      topology.nCpus     = nCpus;
+      topology.nCores    = nCpus;
+      topology.nPackages = 1;
+    }
+  };
+  return topology;
+}
+
 void System::init(int flags, CrashHandler* handler)
 {
   initFlags    = flags | INITIALISED_BIT;
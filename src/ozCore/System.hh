@@ -76,6 +76,37 @@ public:
   /// Type for crash handler function passed to `System::init()`.
   typedef void CrashHandler();
 
+  /// Maximum number of logical CPUs `cpuTopology()` reports.
+  static const int MAX_CPUS = 256;
+
+  /**
+   * Logical CPU (hardware thread).
+   */
+  struct Cpu
+  {
+    int  id;        ///< CPU number as used by the OS, e.g. for affinity masks.
+    int  core;      ///< Index of its physical core, from 0 to `CpuTopology::nCores - 1`.
+    int  package;   ///< Physical package (socket) id.
+    bool isPrimary; ///< True for the first hardware thread of its core.
+  };
+
+  /**
+   * Processor layout and cache sizes.
+   *
+   * Cache sizes are in bytes and 0 if unknown.
+   */
+  struct CpuTopology
+  {
+    Cpu cpus[MAX_CPUS];   ///< Online logical CPUs, ordered by id.
+    int nCpus;            ///< Number of online logical CPUs.
+    int nCores;           ///< Number of physical cores.
+    int nPackages;        ///< Number of physical packages.
+    int cacheLineSize;    ///< L1 data cache line size.
+    int l1DataCacheSize;  ///< L1 data cache size per core.
+    int l2CacheSize;      ///< L2 cache size.
+    int l3CacheSize;      ///< L3 cache size, shared by a package.
+  };
+
 public:
 
   /**
@@ -125,6 +156,14 @@ public:
    * @param crashHandler user-provided function called when the application is aborted by a signal
    *        `System::error()`. If non-null, it is invoked after the stack trace is printed.
    */
+  /**
+   * Processor topology, detected on the first call.
+   *
+   * On Linux, it is parsed from `/sys/devices/system/cpu`. On other platforms or if that fails,
+   * each online logical CPU is reported as a separate core and cache sizes are unknown.
+   */
+  static const CpuTopology& cpuTopology();
+
   static void init(int flags = DEFAULT_MASK, CrashHandler* crashHandler = nullptr);
 
 };
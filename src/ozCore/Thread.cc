@@ -25,6 +25,7 @@
 #include "SpinLock.hh"
 #include "Java.hh"
 #include "Pepper.hh"
+#include "System.hh"
 
 #include <cstdlib>
 #include <cstring>
@@ -38,12 +39,22 @@
 # include <pthread.h>
 #endif
 
+#if defined(__linux__)
+# include <sched.h>
+# include <sys/resource.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
 namespace oz
 {
 
 static const pthread_t          MAIN_THREAD = pthread_self();
 static thread_local const char* threadName  = "";
 
+static Thread::Placement placement      = Thread::FREE;
+static int               nCriticalCores = 3;
+
 struct Thread::Descriptor
 {
   pthread_t   thread;
@@ -129,6 +140,82 @@ bool Thread::isMain()
   return pthread_equal(pthread_self(), MAIN_THREAD);
 }
 
+bool Thread::setAffinity(const int* cpus, int nCpus)
+{
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+
+  for (int i = 0; i < nCpus; ++i) {
+    CPU_SET(cpus[i], &set);
+  }
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  static_cast<void>(cpus);
+  static_cast<void>(nCpus);
+  return false;
+#endif
+}
+
+bool Thread::setPriority(Priority priority)
+{
+#if defined(__linux__)
+  int nice = priority == LOW ? 10 : priority == HIGH ? -5 : 0;
+
+  // Linux threads have separate nice values, addressed by thread id.
+  return setpriority(PRIO_PROCESS, id_t(syscall(SYS_gettid)), nice) == 0;
+#else
+  static_cast<void>(priority);
+  return false;
+#endif
+}
+
+void Thread::setPlacement(Placement placement_, int nCriticalCores_)
+{
+  placement      = placement_;
+  nCriticalCores = max(nCriticalCores_, 1);
+}
+
+bool Thread::place(Role role, int index)
+{
+  const System::CpuTopology& topology = System::cpuTopology();
+
+  if (placement == FREE || topology.nCores < 2) {
+    return false;
+  }
+
+  int nCritical = min(nCriticalCores, topology.nCores - 1);
+  int cpus[System::MAX_CPUS];
+  int nCpus = 0;
+
+  if (role == CRITICAL) {
+    // More critical threads than reserved cores, let the scheduler handle the surplus ones.
+    if (index >= nCritical) {
+      return false;
+    }
+
+    for (int i = 0; i < topology.nCpus; ++i) {
+      if (topology.cpus[i].core == index && topology.cpus[i].isPrimary) {
+        cpus[nCpus] = topology.cpus[i].id;
+        ++nCpus;
+        break;
+      }
+    }
+  }
+  else {
+    setPriority(LOW);
+
+    for (int i = 0; i < topology.nCpus; ++i) {
+      if (topology.cpus[i].core >= nCritical || !topology.cpus[i].isPrimary) {
+        cpus[nCpus] = topology.cpus[i].id;
+        ++nCpus;
+      }
+    }
+  }
+
+  return nCpus != 0 && setAffinity(cpus, nCpus);
+}
+
 Thread::Thread(const char* name, Main* main, void* data)
 {
   descriptor_ = new(malloc(sizeof(Descriptor))) Descriptor;
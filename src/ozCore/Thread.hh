@@ -50,6 +50,40 @@ public:
   /// %Thread's main function type.
   typedef void Main(void* data);
 
+  /**
+   * Scheduling priority.
+   */
+  enum Priority
+  {
+    LOW,
+    NORMAL,
+    HIGH
+  };
+
+  /**
+   * Kind of work a thread does, determines where `place()` puts it.
+   */
+  enum Role
+  {
+    /// Frame-critical thread that should have a physical core for itself.
+    CRITICAL,
+
+    /// Background thread (sound, loading, saving) that may share cores.
+    BACKGROUND
+  };
+
+  /**
+   * Placement policy applied by `place()`.
+   */
+  enum Placement
+  {
+    /// Leave everything to the OS scheduler.
+    FREE,
+
+    /// Pin critical threads to separate physical cores, keep background threads off them.
+    SEPARATE_CORES
+  };
+
 private:
 
   struct Descriptor;
@@ -81,6 +115,42 @@ public:
    */
   static bool isMain();
 
+  /**
+   * Restrict the calling thread to given logical CPUs (see `System::cpuTopology()`).
+   *
+   * @return false if not supported on this platform or the call fails.
+   */
+  static bool setAffinity(const int* cpus, int nCpus);
+
+  /**
+   * %Set the calling thread's scheduling priority.
+   *
+   * On Linux this sets the thread's nice value. `HIGH` usually requires privileges.
+   *
+   * @return false if not supported on this platform or the call fails.
+   */
+  static bool setPriority(Priority priority);
+
+  /**
+   * %Set placement policy used by subsequent `place()` calls.
+   *
+   * With `SEPARATE_CORES`, the first `nCriticalCores` physical cores (but always leaving at least
+   * one) are reserved for critical threads, one core per critical thread index. Background threads
+   * run at low priority on the remaining logical CPUs, including SMT siblings of critical cores.
+   */
+  static void setPlacement(Placement placement, int nCriticalCores = 3);
+
+  /**
+   * Apply placement policy to the calling thread.
+   *
+   * Critical threads should pass distinct indices, e.g. 0 for the main thread and 1 for the world
+   * update thread. Critical threads with an index beyond the reserved cores are not pinned. Nothing
+   * happens with `FREE` policy or on a single-core machine.
+   *
+   * @return true iff affinity was set.
+   */
+  static bool place(Role role, int index = 0);
+
   /**
    * Create an empty instance, no thread is started.
    */
@@ -54,28 +54,35 @@
  */
 #include "Alloc.hh"
 #include "Pool.hh"
+#include "ConcurrentPool.hh"
 
 /*
  * Containers.
  */
 #include "List.hh"
 #include "SList.hh"
+#include "SmallList.hh"
 #include "Heap.hh"
 #include "Set.hh"
 #include "Map.hh"
 #include "HashSet.hh"
 #include "HashMap.hh"
+#include "FlatHashSet.hh"
+#include "FlatHashMap.hh"
+#include "FrameArena.hh"
 
 /*
  * Bit arrays.
  */
 #include "Bitset.hh"
 #include "SBitset.hh"
+#include "HBitset.hh"
 
 /*
  * String.
  */
 #include "String.hh"
+#include "Atom.hh"
 
 /*
  * Math.
@@ -89,6 +96,7 @@
 #include "Plane.hh"
 #include "Mat3.hh"
 #include "Mat4.hh"
+#include "Batch.hh"
 
 /*
  * I/O.
@@ -101,12 +109,16 @@
  * Threads.
  */
 #include "Atomic.hh"
+#include "Futex.hh"
 #include "SpinLock.hh"
 #include "Mutex.hh"
+#include "RWLock.hh"
 #include "LockGuard.hh"
 #include "Semaphore.hh"
+#include "PhaseBarrier.hh"
 #include "CallOnce.hh"
 #include "Thread.hh"
+#include "JobSystem.hh"
 #include "StackTrace.hh"
 
 /*
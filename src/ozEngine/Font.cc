@@ -44,7 +44,7 @@ void Font::close()
 }
 
 Font::Font(const File& file, int height)
-  : fontHeight(height), fileBuffer(file.read())
+  : fontHeight(height), fileBuffer(file.map())
 {
   if (fileBuffer.available() == 0) {
     OZ_ERROR("oz::Font: Failed to read font file `%s'", file.c());
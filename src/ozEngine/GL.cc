@@ -318,7 +318,7 @@ int GL::textureDataFromStream(Stream* is, int bias)
 
 int GL::textureDataFromFile(const File& file, int bias)
 {
-  Stream is = file.read(Endian::LITTLE);
+  Stream is = file.map(Endian::LITTLE);
   return textureDataFromStream(&is, bias);
 }
 
@@ -0,0 +1,141 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "ozbench.hh"
+
+using namespace oz;
+
+static const int N = 10000;
+
+OZ_BENCHMARK(ListAdd, N)
+{
+  List<int> list;
+
+  for (int i = 0; i < N; ++i) {
+    list.add(i);
+  }
+  benchmarkKeep(list);
+}
+
+OZ_BENCHMARK(ListIterate, N)
+{
+  static List<int> list;
+
+  if (list.isEmpty()) {
+    for (int i = 0; i < N; ++i) {
+      list.add(i);
+    }
+  }
+
+  int sum = 0;
+
+  for (int i : list) {
+    sum += i;
+  }
+  benchmarkKeep(sum);
+}
+
+OZ_BENCHMARK(HashMapAdd, N)
+{
+  HashMap<int, int> map;
+
+  for (int i = 0; i < N; ++i) {
+    map.add(i * 7919, i);
+  }
+  benchmarkKeep(map);
+}
+
+OZ_BENCHMARK(HashMapFind, N)
+{
+  static HashMap<int, int> map;
+
+  if (map.isEmpty()) {
+    for (int i = 0; i < N; ++i) {
+      map.add(i * 7919, i);
+    }
+  }
+
+  int nFound = 0;
+
+  for (int i = 0; i < N; ++i) {
+    nFound += map.find(i * 7919) != nullptr;
+  }
+  benchmarkKeep(nFound);
+}
+
+OZ_BENCHMARK(MapAdd, N)
+{
+  Map<int, int> map;
+
+  for (int i = 0; i < N; ++i) {
+    map.add(i * 7919 % N, i);
+  }
+  benchmarkKeep(map);
+}
+
+OZ_BENCHMARK(MapFind, N)
+{
+  static Map<int, int> map;
+
+  if (map.isEmpty()) {
+    for (int i = 0; i < N; ++i) {
+      map.add(i, i);
+    }
+  }
+
+  int nFound = 0;
+
+  for (int i = 0; i < N; ++i) {
+    nFound += map.find(i * 7919 % N) != nullptr;
+  }
+  benchmarkKeep(nFound);
+}
+
+OZ_BENCHMARK(ArraysSort, N)
+{
+  static int input[N];
+  static int array[N];
+
+  if (input[0] == 0) {
+    for (int i = 0; i < N; ++i) {
+      input[i] = 1 + (i * 7919) % N;
+    }
+  }
+
+  Arrays::copy<int>(input, N, array);
+  Arrays::sort<int>(array, N);
+  benchmarkKeep(array);
+}
+
+OZ_BENCHMARK(PoolAllocAllocFree, N)
+{
+  static PoolAlloc pool(16);
+  static void*     slots[N];
+
+  for (int i = 0; i < N; ++i) {
+    slots[i] = pool.allocate();
+  }
+  for (int i = N - 1; i >= 0; --i) {
+    pool.deallocate(slots[i]);
+  }
+  benchmarkKeep(slots);
+}
@@ -0,0 +1,75 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "ozbench.hh"
+
+using namespace oz;
+
+static const int  N           = 1000;
+static const char FILE_PATH[] = "/tmp/ozbench.json";
+
+static const Json& document()
+{
+  static Json json;
+
+  if (json.isNull()) {
+    json = Json::ARRAY;
+
+    for (int i = 0; i < N; ++i) {
+      Json& entry = json.add(Json::OBJECT);
+
+      entry.add("name", String::format("entity%d", i));
+      entry.add("position", Vec3(float(i), 2.0f * float(i), -float(i)));
+      entry.add("health", 100.0f * Math::rand());
+      entry.add("isActive", i % 3 != 0);
+    }
+
+    json.save(FILE_PATH);
+  }
+  return json;
+}
+
+OZ_BENCHMARK(JsonFormat, N)
+{
+  String s = document().toString();
+  benchmarkKeep(s);
+}
+
+OZ_BENCHMARK(JsonLoad, N)
+{
+  document();
+
+  Json json;
+  json.load(FILE_PATH);
+  benchmarkKeep(json);
+}
+
+OZ_BENCHMARK(JsonDocumentRead, N)
+{
+  static String text = document().toString();
+
+  Stream         is(text.begin(), text.end());
+  Json::Document json;
+
+  json.read(&is);
+  benchmarkKeep(json);
+}
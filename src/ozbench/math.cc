@@ -0,0 +1,95 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "ozbench.hh"
+
+using namespace oz;
+
+static const int N = 10000;
+
+static Mat4 matrices[N];
+static Quat quats[N];
+static Vec3 vectors[N];
+
+static void initData()
+{
+  static bool isInitialised = false;
+
+  if (!isInitialised) {
+    isInitialised = true;
+
+    for (int i = 0; i < N; ++i) {
+      quats[i]    = ~Quat(Math::centralRand(), Math::centralRand(), Math::centralRand(),
+                          1.0f + Math::rand());
+      vectors[i]  = Vec3(Math::centralRand(), Math::centralRand(), Math::centralRand());
+      matrices[i] = Mat4::translation(vectors[i]) ^ Mat4::rotation(quats[i]);
+    }
+  }
+}
+
+OZ_BENCHMARK(Mat4Multiply, N)
+{
+  initData();
+
+  Mat4 m = Mat4::ID;
+
+  for (int i = 0; i < N; ++i) {
+    m = matrices[i] * m;
+  }
+  benchmarkKeep(m);
+}
+
+OZ_BENCHMARK(Mat4TransformPoint, N)
+{
+  initData();
+
+  Point p = Point::ORIGIN;
+
+  for (int i = 0; i < N; ++i) {
+    p = matrices[i] * p;
+  }
+  benchmarkKeep(p);
+}
+
+OZ_BENCHMARK(QuatMultiply, N)
+{
+  initData();
+
+  Quat q = Quat::ID;
+
+  for (int i = 0; i < N; ++i) {
+    q = quats[i] * q;
+  }
+  benchmarkKeep(q);
+}
+
+OZ_BENCHMARK(QuatRotateVec3, N)
+{
+  initData();
+
+  Vec3 v = Vec3(1.0f, 0.0f, 0.0f);
+
+  for (int i = 0; i < N; ++i) {
+    v = quats[i] * v;
+  }
+  benchmarkKeep(v);
+}
@@ -0,0 +1,235 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "ozbench.hh"
+
+#include <cstdlib>
+#include <cstring>
+#include <getopt.h>
+
+using namespace oz;
+
+Benchmark* Benchmark::first = nullptr;
+
+struct Result
+{
+  const Benchmark* benchmark;
+  double           median;
+  double           p95;
+  double           mad;
+  double           min;
+};
+
+struct BenchmarkLess
+{
+  bool operator()(const Benchmark* a, const Benchmark* b) const
+  {
+    return String::compare(a->name, b->name) < 0;
+  }
+};
+
+static int    nWarmups  = 3;
+static int    nRuns     = 15;
+static double threshold = 0.10;
+
+static void printUsage()
+{
+  Log::printRaw(
+    "Usage: ozbench [-l] [-f <filter>] [-w <warmups>] [-r <runs>] [-o <output>]\n"
+    "               [-b <baseline>] [-t <threshold>]\n"
+    "  -l  List benchmarks and exit\n"
+    "  -f  Run only benchmarks whose names contain <filter>\n"
+    "  -w  Number of untimed warm-up runs, 3 by default\n"
+    "  -r  Number of timed runs, 15 by default\n"
+    "  -o  Write results to JSON file <output>\n"
+    "  -b  Compare to results in JSON file <baseline> and fail on slowdowns\n"
+    "  -t  Relative slowdown of the median that counts as a regression, 0.10 by default\n\n");
+}
+
+/**
+ * Median of a sorted array.
+ */
+static double median(const double* values, int count)
+{
+  return count % 2 == 1 ? values[count / 2] : (values[count / 2 - 1] + values[count / 2]) / 2.0;
+}
+
+static Result run(const Benchmark* benchmark)
+{
+  List<double> samples(nRuns);
+  List<double> deviations(nRuns);
+
+  for (int i = 0; i < nWarmups; ++i) {
+    benchmark->function();
+  }
+
+  for (int i = 0; i < nRuns; ++i) {
+    Instant beginInstant = Instant::now();
+
+    benchmark->function();
+
+    samples[i] = double((Instant::now() - beginInstant).ns()) / double(benchmark->nOps);
+  }
+
+  Arrays::sort(samples.begin(), nRuns);
+
+  Result result;
+  result.benchmark = benchmark;
+  result.median    = median(samples.begin(), nRuns);
+  result.p95       = samples[min(nRuns - 1, int(Math::ceil(0.95f * float(nRuns))) - 1)];
+  result.min       = samples[0];
+
+  for (int i = 0; i < nRuns; ++i) {
+    deviations[i] = abs(samples[i] - result.median);
+  }
+
+  Arrays::sort(deviations.begin(), nRuns);
+  result.mad = median(deviations.begin(), nRuns);
+
+  return result;
+}
+
+int main(int argc, char** argv)
+{
+  System::init();
+
+  const char* filter       = "";
+  const char* outputPath   = nullptr;
+  const char* baselinePath = nullptr;
+  bool        doList       = false;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "lf:w:r:o:b:t:")) >= 0) {
+    switch (opt) {
+      case 'l': {
+        doList = true;
+        break;
+      }
+      case 'f': {
+        filter = optarg;
+        break;
+      }
+      case 'w': {
+        nWarmups = max(String::parseInt(optarg), 0);
+        break;
+      }
+      case 'r': {
+        nRuns = max(String::parseInt(optarg), 1);
+        break;
+      }
+      case 'o': {
+        outputPath = optarg;
+        break;
+      }
+      case 'b': {
+        baselinePath = optarg;
+        break;
+      }
+      case 't': {
+        threshold = String::parseDouble(optarg);
+        break;
+      }
+      default: {
+        printUsage();
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  if (optind != argc) {
+    printUsage();
+    return EXIT_FAILURE;
+  }
+
+  List<const Benchmark*> benchmarks;
+
+  for (const Benchmark* benchmark = Benchmark::first; benchmark != nullptr;
+       benchmark = benchmark->next)
+  {
+    if (strstr(benchmark->name, filter) != nullptr) {
+      benchmarks.add(benchmark);
+    }
+  }
+
+  Arrays::sort<const Benchmark*, BenchmarkLess>(benchmarks.begin(), benchmarks.size());
+
+  if (doList) {
+    for (const Benchmark* benchmark : benchmarks) {
+      Log::printRaw("%s\n", benchmark->name);
+    }
+    return EXIT_SUCCESS;
+  }
+
+  Json baseline;
+
+  if (baselinePath != nullptr && !baseline.load(baselinePath)) {
+    OZ_ERROR("Failed to read baseline '%s'", baselinePath);
+  }
+
+  const Json& baselineResults = baseline["benchmarks"];
+
+  Json  output        = Json::OBJECT;
+  Json& outputResults = output.add("benchmarks", Json::OBJECT);
+  int   nRegressions  = 0;
+
+  Log::printRaw("%-28s %12s %12s %12s %9s\n", "benchmark [ns/op]", "median", "p95", "MAD",
+                baselinePath == nullptr ? "" : "vs. base");
+
+  for (const Benchmark* benchmark : benchmarks) {
+    Result result = run(benchmark);
+
+    Json& entry = outputResults.add(benchmark->name, Json::OBJECT);
+
+    entry.add("median", result.median);
+    entry.add("p95", result.p95);
+    entry.add("mad", result.mad);
+    entry.add("min", result.min);
+    entry.add("runs", nRuns);
+
+    Log::printRaw("%-28s %12.2f %12.2f %12.2f", benchmark->name, result.median, result.p95,
+                  result.mad);
+
+    double baseMedian = baselineResults[benchmark->name]["median"].get(-1.0);
+
+    if (baseMedian > 0.0) {
+      double change = result.median / baseMedian - 1.0;
+
+      // Require the slowdown to also stand out of noise, not only to exceed the threshold.
+      bool isRegression = change > threshold && result.median - baseMedian > 3.0 * result.mad;
+
+      Log::printRaw(" %+8.1f%%%s", 100.0 * change, isRegression ? "  REGRESSION" : "");
+      nRegressions += isRegression;
+    }
+
+    Log::printRaw("\n");
+  }
+
+  if (outputPath != nullptr && !output.save(outputPath)) {
+    OZ_ERROR("Failed to write results to '%s'", outputPath);
+  }
+
+  if (nRegressions != 0) {
+    Log::printRaw("\n%d regression(s) over %.0f%% threshold\n", nRegressions, 100.0 * threshold);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
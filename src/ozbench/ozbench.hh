@@ -0,0 +1,92 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file ozbench/ozbench.hh
+ *
+ * Benchmark registration.
+ */
+
+#pragma once
+
+#include <ozCore/ozCore.hh>
+
+/**
+ * @def OZ_BENCHMARK
+ * Define and register a benchmark.
+ *
+ * The body is timed as a whole and the result is divided by `nOps`, so it should perform `nOps`
+ * repetitions of the measured operation. Data that should not be part of the measurement can be
+ * prepared in function-local statics, they are initialised during warm-up runs.
+ *
+ * @code
+ * OZ_BENCHMARK(ListAdd, 10000)
+ * {
+ *   List<int> list;
+ *
+ *   for (int i = 0; i < 10000; ++i) {
+ *     list.add(i);
+ *   }
+ *   benchmarkKeep(list);
+ * }
+ * @endcode
+ */
+#define OZ_BENCHMARK(name, nOps) \
+  static void name##Benchmark(); \
+  static Benchmark name##BenchmarkEntry(#name, nOps, name##Benchmark); \
+  static void name##Benchmark()
+
+/**
+ * Registered benchmark, created by `OZ_BENCHMARK`.
+ */
+struct Benchmark
+{
+  /// Benchmark body.
+  typedef void Function();
+
+  const char* name;     ///< Name used in reports and baselines.
+  int         nOps;     ///< Number of operations performed per call.
+  Function*   function; ///< Body.
+  Benchmark*  next;     ///< Next registered benchmark.
+
+  /// Registered benchmarks, in no particular order.
+  static Benchmark* first;
+
+  /**
+   * Register a benchmark.
+   */
+  explicit Benchmark(const char* name_, int nOps_, Function* function_)
+    : name(name_), nOps(nOps_), function(function_), next(first)
+  {
+    first = this;
+  }
+};
+
+/**
+ * Prevent the compiler from optimising away computation of a value.
+ */
+template <typename Value>
+OZ_ALWAYS_INLINE
+inline void benchmarkKeep(const Value& value)
+{
+  asm volatile("" : : "r"(&value) : "memory");
+}
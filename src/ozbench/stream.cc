@@ -0,0 +1,78 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "ozbench.hh"
+
+using namespace oz;
+
+static const int SIZE = 256 * 1024;
+
+/**
+ * Semi-compressible data: random words from a small vocabulary mixed with random bytes.
+ */
+static const Stream& data()
+{
+  static Stream stream(0);
+
+  if (stream.tell() == 0) {
+    static const char* const WORDS[] = { "player", "vehicle", "weapon", "bot", "terrain", "bsp" };
+
+    while (stream.tell() < SIZE) {
+      if (Math::rand() < 0.1f) {
+        stream.writeChar(char(Math::rand(256)));
+      }
+      else {
+        const char* word = WORDS[Math::rand(Arrays::size(WORDS))];
+        stream.write(word, String::length(word));
+      }
+    }
+  }
+  return stream;
+}
+
+OZ_BENCHMARK(StreamCompressDeflate, 1)
+{
+  Stream os = data().compress(Stream::DEFLATE);
+  benchmarkKeep(os);
+}
+
+OZ_BENCHMARK(StreamCompressLZ4, 1)
+{
+  Stream os = data().compress(Stream::LZ4);
+  benchmarkKeep(os);
+}
+
+OZ_BENCHMARK(StreamDecompressDeflate, 1)
+{
+  static Stream compressed = data().compress(Stream::DEFLATE);
+
+  Stream os = compressed.decompress();
+  benchmarkKeep(os);
+}
+
+OZ_BENCHMARK(StreamDecompressLZ4, 1)
+{
+  static Stream compressed = data().compress(Stream::LZ4);
+
+  Stream os = compressed.decompress();
+  benchmarkKeep(os);
+}
@@ -0,0 +1,194 @@
+/*
+ * OpenZone - simple cross-platform FPS/RTS game engine.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ozCore/ozCore.hh>
+
+#include <cstdio>
+
+using namespace oz;
+
+static const int MAX          = 4096;
+static const int N_ITERATIONS = 10000;
+
+static Point  points[MAX];
+static Vec3   dims[MAX];
+static float  radii[MAX];
+static Vec3   moves[MAX];
+
+static float  x[MAX], y[MAX], z[MAX], dx[MAX], dy[MAX], dz[MAX], r[MAX];
+static float  mx[MAX], my[MAX], mz[MAX], outX[MAX], outY[MAX], outZ[MAX], ratios[MAX];
+static int    indices[MAX];
+static Point  outPoints[MAX];
+
+static volatile int sink = 0;
+
+static void report(const char* name, Duration scalar, Duration batch)
+{
+  printf("%-16s scalar %7.2f ns/elem  batch %7.2f ns/elem  speedup %5.2fx\n", name,
+         double(scalar.ns()) / (double(N_ITERATIONS) * MAX),
+         double(batch.ns()) / (double(N_ITERATIONS) * MAX),
+         double(scalar.ns()) / double(batch.ns()));
+}
+
+int main()
+{
+  System::init();
+
+  for (int i = 0; i < MAX; ++i) {
+    points[i] = Point(Math::rand() * 200.0f - 100.0f, Math::rand() * 200.0f - 100.0f,
+                      Math::rand() * 20.0f);
+    dims[i]   = Vec3(Math::rand() + 0.2f, Math::rand() + 0.2f, Math::rand() + 0.2f);
+    radii[i]  = dims[i].fastN();
+    moves[i]  = Vec3(Math::rand() * 4.0f - 2.0f, Math::rand() * 4.0f - 2.0f, -Math::rand());
+
+    x[i]  = points[i].x;
+    y[i]  = points[i].y;
+    z[i]  = points[i].z;
+    dx[i] = dims[i].x;
+    dy[i] = dims[i].y;
+    dz[i] = dims[i].z;
+    r[i]  = radii[i];
+    mx[i] = moves[i].x;
+    my[i] = moves[i].y;
+    mz[i] = moves[i].z;
+  }
+
+  Batch::Coords centres = {x, y, z};
+  Batch::Coords extents = {dx, dy, dz};
+  Batch::Coords offsets = {mx, my, mz};
+
+  Plane planes[5] = {
+    Plane(~Vec3( 1.0f,  0.0f, 0.2f), -20.0f),
+    Plane(~Vec3(-1.0f,  0.0f, 0.2f), -20.0f),
+    Plane(~Vec3( 0.0f,  1.0f, 0.2f), -20.0f),
+    Plane(~Vec3( 0.0f, -1.0f, 0.2f), -20.0f),
+    Plane(~Vec3( 0.0f,  0.0f, 1.0f), -5.0f)
+  };
+
+  printf("Batch width: %d\n", Batch::WIDTH);
+
+  // Spheres against frustum planes.
+  Instant t0 = Instant::now();
+
+  for (int k = 0; k < N_ITERATIONS; ++k) {
+    int n = 0;
+
+    for (int i = 0; i < MAX; ++i) {
+      bool isVisible = true;
+
+      for (int j = 0; j < 5; ++j) {
+        isVisible &= points[i] * planes[j] > -radii[i];
+      }
+      indices[n] = i;
+      n += isVisible;
+    }
+    sink = sink + n;
+  }
+
+  Instant t1 = Instant::now();
+
+  for (int k = 0; k < N_ITERATIONS; ++k) {
+    sink = sink + Batch::spheresInPlanes(centres, r, MAX, planes, 5, indices);
+  }
+
+  report("spheres/planes", t1 - t0, Instant::now() - t1);
+
+  // AABBs against one AABB.
+  Point box    = Point(10.0f, -5.0f, 5.0f);
+  Vec3  boxDim = Vec3(30.0f, 20.0f, 5.0f);
+
+  t0 = Instant::now();
+
+  for (int k = 0; k < N_ITERATIONS; ++k) {
+    int n = 0;
+
+    for (int i = 0; i < MAX; ++i) {
+      Vec3 d = abs(points[i] - box) - dims[i];
+
+      indices[n] = i;
+      n += d.x <= boxDim.x && d.y <= boxDim.y && d.z <= boxDim.z;
+    }
+    sink = sink + n;
+  }
+
+  t1 = Instant::now();
+
+  for (int k = 0; k < N_ITERATIONS; ++k) {
+    sink = sink + Batch::boxesOverlapBox(centres, extents, MAX, box, boxDim, indices);
+  }
+
+  report("AABBs/AABB", t1 - t0, Instant::now() - t1);
+
+  // Points transformed by a matrix.
+  Mat4 tf = Mat4::translation(Vec3(1.0f, 2.0f, 3.0f)) ^ Mat4::rotationZ(0.7f);
+
+  t0 = Instant::now();
+
+  for (int k = 0; k < N_ITERATIONS; ++k) {
+    for (int i = 0; i < MAX; ++i) {
+      outPoints[i] = tf * points[i];
+    }
+    sink = sink + int(outPoints[k % MAX].x);
+  }
+
+  t1 = Instant::now();
+
+  for (int k = 0; k < N_ITERATIONS; ++k) {
+    Batch::transformPoints(tf, centres, MAX, outX, outY, outZ);
+    sink = sink + int(outX[k % MAX]);
+  }
+
+  report("Mat4 * points", t1 - t0, Instant::now() - t1);
+
+  // Rays against AABBs.
+  t0 = Instant::now();
+
+  for (int k = 0; k < N_ITERATIONS; ++k) {
+    int n = 0;
+
+    for (int i = 0; i < MAX; ++i) {
+      Point o    = points[(i + 1) % MAX];
+      float near = 0.0f;
+      float far  = 1.0f;
+
+      for (int j = 0; j < 3; ++j) {
+        float move = abs(moves[i][j]) < 1e-20f ? 1e-20f : moves[i][j];
+        float t0   = (points[i][j] - dims[i][j] - o[j]) / move;
+        float t1   = (points[i][j] + dims[i][j] - o[j]) / move;
+
+        near = max(near, min(t0, t1));
+        far  = min(far, max(t0, t1));
+      }
+      ratios[i] = near <= far ? near : 1.0f;
+      n += near <= far;
+    }
+    sink = sink + n;
+  }
+
+  t1 = Instant::now();
+
+  Batch::Coords origins = {x + 1, y + 1, z + 1};
+
+  for (int k = 0; k < N_ITERATIONS; ++k) {
+    sink = sink + Batch::raysHitBoxes(origins, offsets, centres, extents, MAX - 1, ratios);
+  }
+
+  report("rays/AABBs", t1 - t0, Instant::now() - t1);
+  return 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * OpenZone - simple cross-platform FPS/RTS game engine.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ozCore/ozCore.hh>
+
+#include <cstdio>
+#include <cstring>
+
+using namespace oz;
+
+static const int N_OBJECTS    = 400000;
+static const int N_ITERATIONS = 5;
+
+static const char* const CLASSES[] = {
+  "beast", "bauul", "droid", "goblin", "knight", "tree", "smallCrate", "bigCrate", "rifle", "medKit"
+};
+
+// Synthetic world state that resembles what Orbis/Synapse write into a save stream.
+static Stream makeWorld()
+{
+  Stream os(0, Endian::LITTLE);
+
+  os.writeInt(N_OBJECTS);
+
+  for (int i = 0; i < N_OBJECTS; ++i) {
+    os.writeInt(i);
+    os.writeString(CLASSES[Math::rand(10)]);
+    os.write<Point>(Point(float(Math::rand(4096)), float(Math::rand(4096)), Math::rand() * 64.0f));
+    os.write<Vec3>(Math::rand() < 0.8f ? Vec3::ZERO : Vec3(Math::rand(), Math::rand(), 0.0f));
+    os.writeFloat(float(Math::rand(10)) * 10.0f);
+    os.writeInt(Math::rand(4) << 4 | 0x0100);
+
+    int nItems = Math::rand(4) == 0 ? Math::rand(6) : 0;
+    os.writeInt(nItems);
+
+    for (int j = 0; j < nItems; ++j) {
+      os.writeInt(Math::rand(N_OBJECTS));
+    }
+  }
+  return os;
+}
+
+static void benchmark(const char* name, const Stream& world, Stream::Codec codec)
+{
+  Duration compressTime;
+  Duration decompressTime;
+  int      compressedSize = 0;
+  bool     isCorrect      = true;
+
+  for (int i = 0; i < N_ITERATIONS; ++i) {
+    Instant t0 = Instant::now();
+    Stream  compressed = world.compress(codec);
+    Instant t1 = Instant::now();
+    Stream  decompressed = compressed.decompress();
+    Instant t2 = Instant::now();
+
+    compressTime   += t1 - t0;
+    decompressTime += t2 - t1;
+    compressedSize  = compressed.capacity();
+    isCorrect      &= decompressed.capacity() == world.tell() &&
+                      memcmp(decompressed.begin(), world.begin(), size_t(world.tell())) == 0;
+  }
+
+  printf("%-12s %6.2f MiB -> %6.2f MiB  save %7.2f ms  load %7.2f ms  %s\n", name,
+         double(world.tell()) / (1024.0 * 1024.0), double(compressedSize) / (1024.0 * 1024.0),
+         double(compressTime.ns()) / 1e6 / N_ITERATIONS,
+         double(decompressTime.ns()) / 1e6 / N_ITERATIONS, isCorrect ? "OK" : "MISMATCH");
+}
+
+int main()
+{
+  System::init();
+
+  Stream world = makeWorld();
+
+  benchmark("deflate", world, Stream::DEFLATE);
+  benchmark("lz4", world, Stream::LZ4);
+
+  JobSystem::init();
+  printf("JobSystem: %d workers\n", JobSystem::nWorkers());
+
+  benchmark("deflate", world, Stream::DEFLATE);
+  benchmark("lz4", world, Stream::LZ4);
+
+  JobSystem::destroy();
+  return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * OpenZone - simple cross-platform FPS/RTS game engine.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ozCore/ozCore.hh>
+
+#include <cstdio>
+
+using namespace oz;
+
+static const int MAX_SIZE = 1 << 20;
+
+static int keys[MAX_SIZE];
+
+template <class Table>
+static void benchmark(const char* name, int size)
+{
+  Table table;
+  uint  sum = 0;
+
+  Instant t0 = Instant::now();
+  for (int i = 0; i < size; ++i) {
+    table.add(keys[i], i);
+  }
+
+  Instant t1 = Instant::now();
+  for (int k = 0; k < 4; ++k) {
+    for (int i = 0; i < size; ++i) {
+      sum += *table.find(keys[i]);
+    }
+  }
+
+  Instant t2 = Instant::now();
+  for (int k = 0; k < 4; ++k) {
+    for (int i = 0; i < size; ++i) {
+      sum += table.find(~keys[i]) != nullptr;
+    }
+  }
+
+  Instant t3 = Instant::now();
+  for (int i = 0; i < size; ++i) {
+    table.exclude(keys[i]);
+  }
+
+  Instant t4 = Instant::now();
+
+  printf("%-12s %8d  add %6.2f  hit %6.2f  miss %6.2f  exclude %6.2f ns/op  [%u]\n", name, size,
+         double((t1 - t0).ns()) / size, double((t2 - t1).ns()) / (4 * size),
+         double((t3 - t2).ns()) / (4 * size), double((t4 - t3).ns()) / size, sum);
+}
+
+int main()
+{
+  System::init();
+
+  // Non-negative unique keys, so `~key` is never found.
+  for (int i = 0; i < MAX_SIZE; ++i) {
+    keys[i] = i;
+  }
+  for (int i = MAX_SIZE - 1; i > 0; --i) {
+    swap(keys[i], keys[Math::rand(i + 1)]);
+  }
+
+  for (int size = 1000; size <= MAX_SIZE; size *= 4) {
+    benchmark<HashMap<int, int>>("HashMap", size);
+    benchmark<FlatHashMap<int, int>>("FlatHashMap", size);
+  }
+
+  Log::printMemoryLeaks();
+  return 0;
+}
@@ -0,0 +1,125 @@
+/*
+ * OpenZone - simple cross-platform FPS/RTS game engine.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ozCore/ozCore.hh>
+
+#include <cstdio>
+
+using namespace oz;
+
+static const int N_STRUCTS     = 20000;
+static const int N_OBJECTS     = 200000;
+static const int N_ITERATIONS  = 3;
+static const char* const PATH  = "/tmp/oz-json-benchmark.json";
+
+static const char* const CLASSES[] = {
+  "beast", "bauul", "droid", "goblin", "knight", "tree", "smallCrate", "bigCrate", "rifle", "medKit"
+};
+
+// Synthetic layout that resembles what Orbis::write() produces for a large world.
+static Stream makeLayout()
+{
+  Stream os(0);
+
+  os.write("{\n  \"structs\": [\n", 17);
+
+  for (int i = 0; i < N_STRUCTS; ++i) {
+    String entry = String::format("    { \"bsp\": \"castle\", \"pos\": [%d, %d, %g], "
+                                  "\"heading\": \"NORTH\", \"life\": 1000.0, \"entities\": "
+                                  "[{ \"state\": \"CLOSED\", \"time\": 0.0 }] }%s\n",
+                                  Math::rand(4096), Math::rand(4096), Math::rand() * 64.0f,
+                                  i == N_STRUCTS - 1 ? "" : ",");
+    os.write(entry, entry.length());
+  }
+
+  os.write("  ],\n  \"objects\": [\n", 20);
+
+  for (int i = 0; i < N_OBJECTS; ++i) {
+    String items = "[";
+
+    for (int j = Math::rand(4) == 0 ? Math::rand(6) : 0; j > 0; --j) {
+      items += String::format("%d%s", Math::rand(N_OBJECTS), j == 1 ? "" : ", ");
+    }
+    items += "]";
+
+    String entry = String::format("    { \"class\": \"%s\", \"pos\": [%g, %g, %g], "
+                                  "\"heading\": \"EAST\", \"life\": %g, \"flags\": %d, "
+                                  "\"items\": %s }%s\n",
+                                  CLASSES[Math::rand(10)], Math::rand() * 4096.0f,
+                                  Math::rand() * 4096.0f, Math::rand() * 64.0f,
+                                  float(Math::rand(10)) * 10.0f, Math::rand(4) << 4,
+                                  items.c(), i == N_OBJECTS - 1 ? "" : ",");
+    os.write(entry, entry.length());
+  }
+
+  os.write("  ]\n}\n", 6);
+  return os;
+}
+
+int main()
+{
+  System::init();
+
+  File   file   = PATH;
+  Stream layout = makeLayout();
+
+  file.write(layout);
+
+  Duration domTime;
+  Duration readerTime;
+  Duration documentTime;
+  int      nNumbers[2] = {};
+
+  for (int i = 0; i < N_ITERATIONS; ++i) {
+    Instant t0 = Instant::now();
+
+    Json json;
+    json.load(file);
+
+    Instant t1 = Instant::now();
+
+    Stream       is = file.map();
+    Json::Reader reader(&is, PATH);
+
+    for (Json::Reader::Event event; (event = reader.next()) != Json::Reader::END;) {
+      nNumbers[0] += event == Json::Reader::NUMBER;
+    }
+
+    Instant t2 = Instant::now();
+
+    Json::Document document;
+    document.load(file);
+
+    Instant t3 = Instant::now();
+
+    nNumbers[1] = json["objects"].size() + document.root()["objects"].size();
+    domTime      += t1 - t0;
+    readerTime   += t2 - t1;
+    documentTime += t3 - t2;
+  }
+
+  printf("%.2f MiB, %d numbers, %d objects\n", double(layout.tell()) / (1024.0 * 1024.0),
+         nNumbers[0] / N_ITERATIONS, nNumbers[1] / 2);
+  printf("Json::load      %8.2f ms\n", double(domTime.ns()) / 1e6 / N_ITERATIONS);
+  printf("Json::Reader    %8.2f ms\n", double(readerTime.ns()) / 1e6 / N_ITERATIONS);
+  printf("Json::Document  %8.2f ms\n", double(documentTime.ns()) / 1e6 / N_ITERATIONS);
+
+  file.remove();
+  return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * OpenZone - simple cross-platform FPS/RTS game engine.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ozCore/ozCore.hh>
+
+#include <cstdio>
+
+using namespace oz;
+
+static const int   N_THREADS = 2;
+static const int   N_LINES   = 1000;
+static const char* const PATH = "/tmp/oz-log-benchmark.log";
+
+static Atomic<long64> callerTime = {0};
+
+static void logMain(void* data)
+{
+  int thread = int(reinterpret_cast<size_t>(data));
+
+  Log::indent();
+
+  Instant t0 = Instant::now();
+
+  for (int i = 0; i < N_LINES; ++i) {
+    Log::println("thread %d line %d: loading '%s' ... %g", thread, i, "@class/beast.json", i * 0.5);
+  }
+
+  callerTime.fetchAdd<ATOMIC_RELAXED>((Instant::now() - t0).ns());
+
+  Log::unindent();
+}
+
+static void benchmark(const char* name, bool async)
+{
+  Log::init(PATH, true, async);
+  Log::verboseMode = true;
+  callerTime.store<ATOMIC_RELAXED>(0);
+
+  Thread threads[N_THREADS];
+  for (int i = 0; i < N_THREADS; ++i) {
+    threads[i] = Thread("logger", logMain, reinterpret_cast<void*>(size_t(i)));
+  }
+  for (int i = 0; i < N_THREADS; ++i) {
+    threads[i].join();
+  }
+
+  Log::verboseMode = false;
+
+  Instant t1 = Instant::now();
+
+  Log::destroy();
+
+  Instant t2 = Instant::now();
+
+  Stream is     = File(PATH).read();
+  int    nLines = 0;
+
+  for (const char* s = is.begin(); s != is.end(); ++s) {
+    nLines += *s == '\n';
+  }
+
+  printf("%-6s %6.3f us/line on caller, %7.2f ms to drain, %d/%d lines\n", name,
+         double(callerTime.load<ATOMIC_RELAXED>()) / 1e3 / (N_THREADS * N_LINES),
+         double((t2 - t1).ns()) / 1e6,
+         nLines, N_THREADS * N_LINES);
+}
+
+int main()
+{
+  System::init();
+
+  benchmark("sync", false);
+  benchmark("async", true);
+
+  File(PATH).remove();
+  return 0;
+}
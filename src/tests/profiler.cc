@@ -0,0 +1,89 @@
+/*
+ * OpenZone - simple cross-platform FPS/RTS game engine.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ozCore/ozCore.hh>
+
+#include <cstdio>
+
+using namespace oz;
+
+static const int N_THREADS    = 4;
+static const int N_ITERATIONS = 100000;
+
+static volatile int sink = 0;
+
+static void work(int n)
+{
+  OZ_PROFILER_ZONE("work");
+
+  for (int i = 0; i < n; ++i) {
+    sink = sink + i;
+  }
+}
+
+static void workerMain(void*)
+{
+  for (int i = 0; i < N_ITERATIONS; ++i) {
+    OZ_PROFILER_ZONE("iteration");
+
+    work(10);
+    work(20);
+  }
+}
+
+int main()
+{
+  System::init();
+
+  Instant begin = Instant::now();
+
+  for (int i = 0; i < N_ITERATIONS; ++i) {
+    OZ_PROFILER_ZONE("empty");
+  }
+
+  Duration overhead = (Instant::now() - begin) / N_ITERATIONS;
+  printf("Zone overhead: %d ns\n", int(overhead.ns()));
+
+  List<Thread> threads;
+
+  for (int i = 0; i < N_THREADS; ++i) {
+    threads.add(Thread("worker", workerMain));
+  }
+
+  // Read buffers while they are being overwritten.
+  for (int i = 0; i < 10; ++i) {
+    Profiler::citerator();
+    Thread::sleepFor(5_ms);
+  }
+
+  threads.clear();
+
+  for (const auto& i : Profiler::citerator()) {
+    printf("%.6f s\t %s\n", double(i.value.ns()) / 1e9, i.key.c());
+  }
+
+  File file = "profiler.json";
+  if (!Profiler::exportTrace(file)) {
+    printf("Failed to write '%s'\n", file.c());
+    return 1;
+  }
+
+  printf("Trace written to '%s' (%d bytes)\n", file.c(), file.size());
+  return 0;
+}
@@ -24,168 +24,83 @@
 
 using namespace oz;
 
-template <typename Type, int STACK_SIZE>
-inline void aSort(Type* array, int count)
+static const int MAX   = 10000;
+static const int TESTS = 500;
+
+struct Identity
 {
-  Type*  stack[STACK_SIZE];
-  Type** sp = stack;
-  Type*  first = array;
-  Type*  last = array + count - 1;
-
-  *(++sp) = first;
-  *(++sp) = last;
-
-  do {
-    last = *(--sp);
-    first = *(--sp);
-
-    if (first < last) {
-      if (last - first > 10) {
-        int pivotValue = *last;
-        Type* top = first;
-        Type* bottom = last - 1;
-
-        do {
-          while (top <= bottom && *top <= pivotValue) {
-            ++top;
-          }
-          while (top < bottom && *bottom > pivotValue) {
-            --bottom;
-          }
-          if (top >= bottom) {
-            break;
-          }
-          swap(*top, *bottom);
-        }
-        while (true);
-
-        swap(*top, *last);
-
-        *(++sp) = first;
-        *(++sp) = top - 1;
-        *(++sp) = top + 1;
-        *(++sp) = last;
-      }
-      else {
-        // selection sort
-        for (Type* i = first; i < last;) {
-          Type* pivot = i;
-          Type* min = i;
-          ++i;
-
-          for (Type* j = i; j <= last; ++j) {
-            if (*j < *min) {
-              min = j;
-            }
-          }
-          swap(*pivot, *min);
-        }
-      }
-    }
+  int operator()(int i) const
+  {
+    return i;
   }
-  while (sp != stack);
-}
+};
 
-template <typename Type>
-inline void arSort(Type* first, Type* last)
+static void fillRandom(int* array, int size)
 {
-  if (first < last) {
-    if (last - first > 1) {
-      int pivotValue = *last;
-      Type* top = first;
-      Type* bottom = last - 1;
-
-      do {
-        while (top <= bottom && *top <= pivotValue) {
-          ++top;
-        }
-        while (top < bottom && *bottom > pivotValue) {
-          --bottom;
-        }
-        if (top >= bottom) {
-          break;
-        }
-        swap(*top, *bottom);
-      }
-      while (true);
-
-      swap(*top, *last);
-
-      arSort(first, top - 1);
-      arSort(top + 1, last);
-    }
-    else if (*first > *last) {
-      swap(*first, *last);
-    }
+  for (int i = 0; i < size; ++i) {
+    array[i] = rand() % size;
   }
 }
 
-template <typename Type>
-static void oaSort(Type* array, int begin, int end)
+static void fillSorted(int* array, int size)
 {
-  int first = begin;
-  int last = end - 1;
-
-  if (first < last) {
-    if (first + 1 == last) {
-      if (array[first] > array[last]) {
-        swap(array[first], array[last]);
-      }
-    }
-    else {
-      int pivotValue = array[last];
-      int top = first;
-      int bottom = last - 1;
-
-      do {
-        while (top <= bottom && array[top] <= pivotValue) {
-          ++top;
-        }
-        while (top < bottom && array[bottom] > pivotValue) {
-          --bottom;
-        }
-        if (top < bottom) {
-          swap(array[top], array[bottom]);
-        }
-        else {
-          break;
-        }
-      }
-      while (true);
-
-      swap(array[top], array[last]);
-      oaSort(array, begin, top);
-      oaSort(array, top + 1, end);
-    }
+  for (int i = 0; i < size; ++i) {
+    array[i] = i;
   }
 }
 
-#define MAX 10000
-#define TESTS 2000
+static void fillReverse(int* array, int size)
+{
+  for (int i = 0; i < size; ++i) {
+    array[i] = size - i;
+  }
+}
 
-int main()
+static void fillNearlySorted(int* array, int size)
 {
-  System::init();
+  fillSorted(array, size);
+
+  for (int i = 0; i < size / 100; ++i) {
+    swap(array[rand() % size], array[rand() % size]);
+  }
+}
 
-  int array[MAX];
+static void benchmark(const char* name, void (* fill)(int*, int))
+{
+  static int array[MAX];
+  static int buffer[MAX];
 
-  srand(32);
+  Duration sortTime  = Duration::ZERO;
+  Duration radixTime = Duration::ZERO;
 
-  Instant t0 = Instant::now();
   for (int i = 0; i < TESTS; ++i) {
-    for (int j = 0; j < MAX; ++j) {
-      array[j] = rand() % MAX;
-    }
-    //sort(array, 0, MAX);
-    //quickSort(array, MAX);
-    //arSort(array, array + MAX - 1);
+    fill(array, MAX);
+
+    Instant t0 = Instant::now();
     Arrays::sort(array, MAX);
-    //aSort<int, 100>(array, MAX);
+    sortTime += Instant::now() - t0;
+
+    fill(array, MAX);
+
+    t0 = Instant::now();
+    Arrays::radixSort<int, Identity>(array, MAX, buffer);
+    radixTime += Instant::now() - t0;
   }
-  printf("%d ms\n", int((Instant::now() - t0).ms()));
-//   for (int i = 0; i < MAX; ++i) {
-//     printf("%d ", array[i]);
-//   }
+
+  printf("%-14s sort %6d us    radixSort %6d us\n", name, int(sortTime.us() / TESTS),
+         int(radixTime.us() / TESTS));
+}
+
+int main()
+{
+  System::init();
+
+  srand(32);
+
+  benchmark("random", fillRandom);
+  benchmark("sorted", fillSorted);
+  benchmark("reverse", fillReverse);
+  benchmark("nearly sorted", fillNearlySorted);
 
   Log::printMemoryLeaks();
   return 0;
@@ -90,6 +90,8 @@ int main(int argc, char** argv)
     }
   }
 
+  Log::destroy();
+
   return exitCode;
 }
 
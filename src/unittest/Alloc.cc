@@ -22,8 +22,68 @@
 
 #include "unittest.hh"
 
+#include <cstring>
+
 using namespace oz;
 
+static void testSampling()
+{
+  Alloc::setSampleInterval(256);
+  OZ_CHECK(Alloc::sampleInterval() == 256);
+
+  int    oCount  = Alloc::count;
+  size_t oAmount = Alloc::amount;
+
+  // Counters stay exact when sampling, only call sites are sampled.
+  {
+    Alloc::Tag tag("unittest");
+    Alloc::Tag innerTag("unittest.inner");
+
+    char* chunks[100];
+    for (int i = 0; i < 100; ++i) {
+      chunks[i] = new char[100];
+    }
+    OZ_CHECK(Alloc::count == oCount + 100);
+    OZ_CHECK(Alloc::amount == oAmount + 100 * 100);
+
+    for (int i = 0; i < 100; ++i) {
+      delete[] chunks[i];
+    }
+    OZ_CHECK(Alloc::count == oCount);
+    OZ_CHECK(Alloc::amount == oAmount);
+  }
+
+  Alloc::setSampleInterval(0);
+  OZ_CHECK(Alloc::sampleInterval() == 0);
+
+#ifdef OZ_ALLOCATOR
+  // 10000 bytes at 256-byte interval give about 39 samples, all from the loop above.
+  File   samplesFile = "/tmp/ozUnittest-samples.json";
+  String samples;
+
+  OZ_CHECK(Alloc::exportSamples(samplesFile));
+
+  Stream is = samplesFile.read();
+  samples   = String(is.begin(), is.available());
+
+  OZ_CHECK(strstr(samples, "\"tag\": \"unittest.inner\"") != nullptr);
+  OZ_CHECK(strstr(samples, "\"frames\": [\"") != nullptr);
+
+  Alloc::clearSamples();
+
+  OZ_CHECK(Alloc::exportSamples(samplesFile));
+
+  is      = samplesFile.read();
+  samples = String(is.begin(), is.available());
+
+  OZ_CHECK(strstr(samples, "\"tag\"") == nullptr);
+
+  samplesFile.remove();
+#else
+  Alloc::clearSamples();
+#endif
+}
+
 void test_Alloc()
 {
   Log() << "+ Alloc";
@@ -75,4 +135,6 @@ void test_Alloc()
   OZ_CHECK(Alloc::alignUp(zeroptr + 1) == oneptr);
   OZ_CHECK(Alloc::alignUp(oneptr - 1) == oneptr);
   OZ_CHECK(Alloc::alignUp(oneptr) == oneptr);
+
+  testSampling();
 }
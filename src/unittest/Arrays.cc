@@ -129,4 +129,61 @@ void test_arrays()
                (r[index - 1] < i && r[index] >= i));
     }
   }
+
+  int s[1000];
+  for (int i = 0; i < 1000; ++i) {
+    s[i] = i / 3;
+  }
+  Arrays::sort(s, 1000);
+  for (int i = 1; i < 1000; ++i) {
+    OZ_CHECK(s[i - 1] <= s[i]);
+  }
+
+  Arrays::reverse(s, 1000);
+  Arrays::sort(s, 1000);
+  for (int i = 1; i < 1000; ++i) {
+    OZ_CHECK(s[i - 1] <= s[i]);
+  }
+
+  struct Keyed
+  {
+    float key;
+    int   order;
+
+    struct Key
+    {
+      float operator()(const Keyed& k) const
+      {
+        return k.key;
+      }
+    };
+  };
+
+  Keyed k[1000];
+  Keyed kBuffer[1000];
+  for (int i = 0; i < 1000; ++i) {
+    k[i] = {float(Math::rand(100) - 50) * 0.25f, i};
+  }
+  Arrays::radixSort<Keyed, Keyed::Key>(k, 1000, kBuffer);
+
+  for (int i = 1; i < 1000; ++i) {
+    OZ_CHECK(k[i - 1].key < k[i].key || (k[i - 1].key == k[i].key && k[i - 1].order < k[i].order));
+  }
+
+  struct Identity
+  {
+    int operator()(int i) const
+    {
+      return i;
+    }
+  };
+
+  int rBuffer[1000];
+  for (int i = 0; i < 1000; ++i) {
+    s[i] = Math::rand(2000) - 1000;
+  }
+  Arrays::radixSort<int, Identity>(s, 1000, rBuffer);
+  for (int i = 1; i < 1000; ++i) {
+    OZ_CHECK(s[i - 1] <= s[i]);
+  }
 }
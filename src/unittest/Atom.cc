@@ -0,0 +1,81 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "unittest.hh"
+
+using namespace oz;
+
+void test_Atom()
+{
+  Log() << "+ Atom";
+
+  static const int N = 10000;
+
+  Atom empty;
+  Atom beast = Atom("beast");
+
+  OZ_CHECK(empty == Atom::EMPTY && empty == Atom("") && empty.isEmpty());
+  OZ_CHECK(String::equals(empty.c(), "") && empty.length() == 0);
+  OZ_CHECK(empty.hash() == Hash<const char*>()(""));
+
+  OZ_CHECK(beast == Atom(String("beast")) && beast == Atom("beasts", 5));
+  OZ_CHECK(beast != Atom("beasts") && beast != empty);
+  OZ_CHECK(String::equals(beast.c(), "beast") && beast.length() == 5);
+  OZ_CHECK(beast.hash() == Hash<const char*>()("beast"));
+  OZ_CHECK(Atom::find("beast") == beast && Atom::find("no such atom").isEmpty());
+  OZ_CHECK(Atom::fromHandle(beast.handle()) == beast);
+
+  Less<Atom> less;
+  OZ_CHECK(less(Atom("bauul"), beast) && !less(beast, beast) && less(empty, beast));
+
+  // Concurrent interning of overlapping names must always yield the same atoms.
+  static Atom atoms[2][N];
+
+  JobSystem::init(4);
+
+  int nAtoms = Atom::count();
+
+  for (int pass = 0; pass < 2; ++pass) {
+    JobSystem::parallelFor(0, N, 100, [pass](int begin, int end)
+    {
+      for (int i = begin; i < end; ++i) {
+        atoms[pass][i] = Atom(String::format("atom %d", i % (N / 2)));
+      }
+    });
+  }
+
+  JobSystem::destroy();
+
+  OZ_CHECK(Atom::count() == nAtoms + N / 2);
+
+  for (int i = 0; i < N; ++i) {
+    OZ_CHECK(atoms[0][i] == atoms[1][i] && atoms[0][i] == atoms[0][i % (N / 2)]);
+    OZ_CHECK(String::equals(atoms[0][i].c(), String::format("atom %d", i % (N / 2))));
+  }
+
+  HashMap<Atom, int> indices;
+  indices.add(beast, 1);
+  indices.add(atoms[0][1], 2);
+
+  OZ_CHECK(indices.contains(Atom("beast")) && *indices.find(atoms[1][N / 2 + 1]) == 2);
+  OZ_CHECK(!indices.contains(empty));
+}
@@ -0,0 +1,157 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "unittest.hh"
+
+using namespace oz;
+
+// Odd size so that both vector and single-lane paths are exercised.
+static const int COUNT = 67;
+
+static float cx[COUNT], cy[COUNT], cz[COUNT], dx[COUNT], dy[COUNT], dz[COUNT];
+static float ox[COUNT], oy[COUNT], oz_[COUNT], mx[COUNT], my[COUNT], mz[COUNT];
+static float radii[COUNT], outX[COUNT], outY[COUNT], outZ[COUNT], ratios[COUNT];
+static int   indices[COUNT];
+
+static float randRange(float scale)
+{
+  return (Math::rand() * 2.0f - 1.0f) * scale;
+}
+
+void test_Batch()
+{
+  Log() << "+ Batch";
+
+  for (int i = 0; i < COUNT; ++i) {
+    cx[i]    = randRange(10.0f);
+    cy[i]    = randRange(10.0f);
+    cz[i]    = randRange(10.0f);
+    dx[i]    = Math::rand() * 2.0f;
+    dy[i]    = Math::rand() * 2.0f;
+    dz[i]    = Math::rand() * 2.0f;
+    ox[i]    = randRange(15.0f);
+    oy[i]    = randRange(15.0f);
+    oz_[i]   = randRange(15.0f);
+    mx[i]    = i % 5 == 0 ? 0.0f : randRange(30.0f);
+    my[i]    = randRange(30.0f);
+    mz[i]    = randRange(30.0f);
+    radii[i] = Math::rand() * 3.0f;
+  }
+
+  Batch::Coords centres = {cx, cy, cz};
+  Batch::Coords dims    = {dx, dy, dz};
+  Batch::Coords origins = {ox, oy, oz_};
+  Batch::Coords moves   = {mx, my, mz};
+
+  Plane planes[] = {
+    Plane(Vec3(1.0f, 0.0f, 0.0f), -2.0f),
+    Plane(Vec3(0.0f, 1.0f, 0.0f), -3.0f),
+    Plane(~Vec3(-1.0f, 0.0f, 1.0f), -4.0f)
+  };
+
+  int nSpheres = Batch::spheresInPlanes(centres, radii, COUNT, planes, 3, indices);
+  int n        = 0;
+
+  for (int i = 0; i < COUNT; ++i) {
+    Point p    = Point(cx[i], cy[i], cz[i]);
+    bool  isIn = p * planes[0] > -radii[i] && p * planes[1] > -radii[i] &&
+                 p * planes[2] > -radii[i];
+
+    if (isIn) {
+      OZ_CHECK(n < nSpheres && indices[n] == i);
+      ++n;
+    }
+  }
+  OZ_CHECK(n == nSpheres);
+
+  Point box    = Point(1.0f, -2.0f, 0.5f);
+  Vec3  boxDim = Vec3(4.0f, 3.0f, 5.0f);
+  int   nBoxes = Batch::boxesOverlapBox(centres, dims, COUNT, box, boxDim, indices);
+
+  n = 0;
+  for (int i = 0; i < COUNT; ++i) {
+    bool overlaps = abs(cx[i] - box.x) <= dx[i] + boxDim.x &&
+                    abs(cy[i] - box.y) <= dy[i] + boxDim.y &&
+                    abs(cz[i] - box.z) <= dz[i] + boxDim.z;
+
+    if (overlaps) {
+      OZ_CHECK(n < nBoxes && indices[n] == i);
+      ++n;
+    }
+  }
+  OZ_CHECK(n == nBoxes);
+
+  Batch::boxPlaneDistances(origins, cx, COUNT, box, boxDim, outX);
+
+  for (int i = 0; i < COUNT; ++i) {
+    Plane plane    = Plane(Vec3(ox[i], oy[i], oz_[i]), cx[i]);
+    float distance = box * plane - boxDim * abs(plane.n);
+
+    OZ_CHECK(abs(distance - outX[i]) < 1e-3f);
+  }
+
+  Mat4 tf = Mat4::translation(Vec3(1.0f, 2.0f, 3.0f)) ^ Mat4::rotationZ(0.3f);
+  Batch::transformPoints(tf, centres, COUNT, outX, outY, outZ);
+
+  for (int i = 0; i < COUNT; ++i) {
+    Point p = tf * Point(cx[i], cy[i], cz[i]);
+    OZ_CHECK(abs(p.x - outX[i]) < 1e-4f && abs(p.y - outY[i]) < 1e-4f &&
+             abs(p.z - outZ[i]) < 1e-4f);
+  }
+
+  int nHits = Batch::raysHitBoxes(origins, moves, centres, dims, COUNT, ratios);
+
+  n = 0;
+  for (int i = 0; i < COUNT; ++i) {
+    float near = 0.0f;
+    float far  = 1.0f;
+
+    for (int j = 0; j < 3; ++j) {
+      const float* o = j == 0 ? ox : j == 1 ? oy : oz_;
+      const float* m = j == 0 ? mx : j == 1 ? my : mz;
+      const float* c = j == 0 ? cx : j == 1 ? cy : cz;
+      const float* d = j == 0 ? dx : j == 1 ? dy : dz;
+
+      if (m[i] == 0.0f) {
+        if (o[i] < c[i] - d[i] || o[i] > c[i] + d[i]) {
+          far = -1.0f;
+        }
+      }
+      else {
+        float t0 = (c[i] - d[i] - o[i]) / m[i];
+        float t1 = (c[i] + d[i] - o[i]) / m[i];
+
+        near = max(near, min(t0, t1));
+        far  = min(far, max(t0, t1));
+      }
+    }
+
+    if (near <= far) {
+      OZ_CHECK(abs(ratios[i] - near) < 1e-4f);
+      ++n;
+    }
+    else {
+      OZ_CHECK(ratios[i] == 1.0f);
+    }
+  }
+  OZ_CHECK(n == nHits);
+}
@@ -0,0 +1,137 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "unittest.hh"
+
+using namespace oz;
+
+template <class BitsetType>
+static void testScan(BitsetType& b)
+{
+  static const int INDICES[] = { 0, 1, 63, 64, 200, 4095, 4096, 4100, 20000, 32767 };
+
+  OZ_CHECK(b.findNextSet(0) == -1);
+  OZ_CHECK(b.count() == 0);
+
+  for (int i : INDICES) {
+    b.set(i);
+  }
+
+  OZ_CHECK(b.count() == Arrays::size(INDICES));
+
+  // findNextSet() walks exactly the set bits.
+  int n = 0;
+  for (int i = b.findNextSet(0); i != -1; i = b.findNextSet(i + 1)) {
+    OZ_CHECK(i == INDICES[n]);
+    ++n;
+  }
+  OZ_CHECK(n == Arrays::size(INDICES));
+  OZ_CHECK(b.findNextSet(b.size()) == -1);
+  OZ_CHECK(b.findNextSet(4097) == 4100);
+
+  // So does forEachSet().
+  n = 0;
+  b.forEachSet([&n](int i)
+  {
+    OZ_CHECK(i == INDICES[n]);
+    ++n;
+  });
+  OZ_CHECK(n == Arrays::size(INDICES));
+
+  b.clear(4095);
+  b.clear(4096);
+  b.clear(4100);
+  OZ_CHECK(b.findNextSet(201) == 20000);
+  OZ_CHECK(b.count() == Arrays::size(INDICES) - 3);
+
+  b.clear();
+  OZ_CHECK(b.isNoneSet() && b.findNextSet(0) == -1);
+}
+
+void test_Bitset()
+{
+  Log() << "+ Bitset";
+
+  SBitset<32768> sb;
+  Bitset         db(32768);
+  HBitset<32768> hb;
+
+  testScan(sb);
+  testScan(db);
+  testScan(hb);
+
+  // findNextClear().
+  sb.set(0);
+  sb.set(1);
+  sb.set(64);
+  OZ_CHECK(sb.findNextClear(0) == 2);
+  OZ_CHECK(sb.findNextClear(64) == 65);
+
+  for (int i = 0; i < 128; ++i) {
+    db.set(i);
+  }
+  OZ_CHECK(db.findNextClear(0) == 128);
+
+  // Word-parallel operations.
+  SBitset<128> a("1100110011");
+  SBitset<128> b("1010101010");
+
+  OZ_CHECK((a & b) == SBitset<128>("1000100010"));
+  OZ_CHECK((a | b) == SBitset<128>("1110111011"));
+  OZ_CHECK(SBitset<128>(a).andNot(b) == SBitset<128>("0100010001"));
+
+  Bitset da("1100110011");
+  Bitset dc("1010101010");
+
+  OZ_CHECK(da.andNot(dc) == Bitset("0100010001"));
+
+  HBitset<8192> ha;
+  HBitset<8192> hc;
+
+  ha.set(3);
+  ha.set(5000);
+  hc.set(5000);
+  hc.set(8000);
+
+  HBitset<8192> hor = ha;
+  hor |= hc;
+  OZ_CHECK(hor.count() == 3 && hor.get(3) && hor.get(5000) && hor.get(8000));
+
+  HBitset<8192> hand = ha;
+  hand &= hc;
+  OZ_CHECK(hand.count() == 1 && hand.get(5000));
+  OZ_CHECK(hand.findNextSet(0) == 5000 && hand.findNextSet(5001) == -1);
+
+  ha.andNot(hc);
+  OZ_CHECK(ha.count() == 1 && ha.get(3));
+  OZ_CHECK(ha.findNextSet(4) == -1);
+
+  // Restoring from units keeps the summary consistent.
+  HBitset<8192> hr;
+  int           unit = 0;
+
+  for (size_t bits : hor) {
+    hr.setUnit(unit, bits);
+    ++unit;
+  }
+  OZ_CHECK(hr == hor && hr.findNextSet(4) == 5000);
+}
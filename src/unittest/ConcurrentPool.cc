@@ -0,0 +1,133 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "unittest.hh"
+
+using namespace oz;
+
+struct PoolElem
+{
+  int  value;
+  char padding[60];
+};
+
+static ConcurrentPool<PoolElem> pool("unittest", 64);
+
+static void testSingleThreaded()
+{
+  OZ_CHECK(pool.isEmpty() && pool.capacity() == 0);
+  OZ_CHECK(pool.slotSize() >= int(sizeof(PoolElem)) && pool.blockSlots() >= 64);
+
+  PoolElem* elems[1000];
+
+  for (int i = 0; i < 1000; ++i) {
+    elems[i] = static_cast<PoolElem*>(pool.allocate());
+    elems[i]->value = i;
+  }
+  OZ_CHECK(pool.size() == 1000 && pool.capacity() >= 1000);
+
+  for (int i = 0; i < 1000; ++i) {
+    OZ_CHECK(elems[i]->value == i);
+  }
+
+  for (int i = 0; i < 1000; ++i) {
+    pool.deallocate(elems[i]);
+  }
+  OZ_CHECK(pool.size() == 0);
+
+  ConcurrentPoolAlloc::Stats stats = pool.statistics();
+  OZ_CHECK(stats.size == 0 && stats.highWater >= 1000 && stats.fragmentation == 1.0f);
+  OZ_CHECK(stats.bytesHeld >= size_t(stats.capacity) * size_t(pool.slotSize()));
+
+  // Empty blocks are released after the delay, only once slots are back in the depot.
+  pool.setReleaseDelay(Duration::ZERO);
+  pool.flush();
+  OZ_CHECK(pool.trim() > 0 && pool.capacity() == 0);
+  pool.setReleaseDelay(ConcurrentPoolAlloc::DEFAULT_RELEASE_DELAY);
+
+  bool isRegistered = false;
+  for (ConcurrentPoolAlloc* i = ConcurrentPoolAlloc::first(); i != nullptr; i = i->next()) {
+    isRegistered |= i == &pool;
+  }
+  OZ_CHECK(isRegistered);
+}
+
+static void testMultiThreaded()
+{
+  static const int N_THREADS = 4;
+  static const int N_ROUNDS  = 100;
+  static const int N_ELEMS   = 500;
+
+  // Elements allocated on one thread are freed on the next one.
+  static PoolElem* elems[N_THREADS][N_ELEMS];
+
+  Thread threads[N_THREADS];
+
+  for (int i = 0; i < N_THREADS; ++i) {
+    threads[i] = Thread("pool", [](void* data)
+    {
+      int id = int(size_t(data));
+
+      for (int round = 0; round < N_ROUNDS; ++round) {
+        for (int j = 0; j < N_ELEMS; ++j) {
+          elems[id][j] = static_cast<PoolElem*>(pool.allocate());
+          elems[id][j]->value = id * N_ELEMS + j;
+        }
+        for (int j = 0; j < N_ELEMS; ++j) {
+          OZ_CHECK(elems[id][j]->value == id * N_ELEMS + j);
+          pool.deallocate(elems[id][j]);
+        }
+      }
+    }, reinterpret_cast<void*>(size_t(i)));
+  }
+  for (int i = 0; i < N_THREADS; ++i) {
+    threads[i].join();
+  }
+  OZ_CHECK(pool.size() == 0);
+
+  // Cross-thread frees.
+  for (int i = 0; i < N_ELEMS; ++i) {
+    elems[0][i] = static_cast<PoolElem*>(pool.allocate());
+  }
+
+  Thread freer("pool", [](void*)
+  {
+    for (int i = 0; i < N_ELEMS; ++i) {
+      pool.deallocate(elems[0][i]);
+    }
+  }, nullptr);
+  freer.join();
+
+  OZ_CHECK(pool.size() == 0);
+  OZ_CHECK(pool.statistics().highWater >= N_ELEMS);
+
+  pool.free();
+  OZ_CHECK(pool.capacity() == 0);
+}
+
+void test_ConcurrentPool()
+{
+  Log() << "+ ConcurrentPool";
+
+  testSingleThreaded();
+  testMultiThreaded();
+}
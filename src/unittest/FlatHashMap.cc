@@ -0,0 +1,101 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "unittest.hh"
+
+using namespace oz;
+
+void test_FlatHashMap()
+{
+  Log() << "+ FlatHashMap";
+
+  FlatHashMap<int, int> fm;
+  HashMap<int, int>     hm;
+
+  OZ_CHECK(fm.isEmpty() && fm.find(0) == nullptr && !fm.exclude(0));
+
+  // Random operations on a small key range exercise collisions, tail overflow and backward shifts.
+  for (int i = 0; i < 100000; ++i) {
+    int key = Math::rand(4000) - 2000;
+
+    switch (Math::rand(3)) {
+      case 0: {
+        fm.add(key, i);
+        hm.add(key, i);
+        break;
+      }
+      case 1: {
+        fm.include(key, i);
+        hm.include(key, i);
+        break;
+      }
+      default: {
+        OZ_CHECK(fm.exclude(key) == hm.exclude(key));
+        break;
+      }
+    }
+  }
+
+  OZ_CHECK(fm.size() == hm.size());
+
+  for (const auto& i : hm) {
+    const int* value = fm.find(i.key);
+    OZ_CHECK(value != nullptr && *value == i.value);
+  }
+
+  int count = 0;
+  for (const auto& i : fm) {
+    OZ_CHECK(hm.contains(i.key));
+    ++count;
+  }
+  OZ_CHECK(count == hm.size());
+
+  // Remove every other element while iterating.
+  for (auto i = fm.iterator(); i.isValid();) {
+    auto elem = i;
+    ++i;
+
+    if (elem->key % 2 == 0) {
+      hm.exclude(elem->key);
+      fm.exclude(elem->key);
+    }
+  }
+
+  OZ_CHECK(fm.size() == hm.size());
+  for (const auto& i : fm) {
+    OZ_CHECK(i.key % 2 != 0 && hm.contains(i.key));
+  }
+
+  FlatHashMap<int, int> fmCopy = fm;
+  OZ_CHECK(fmCopy == fm);
+
+  fm.clear();
+  fm.trim();
+  OZ_CHECK(fm.isEmpty() && fm.capacity() == 0 && fm.begin() == fm.end());
+
+  fm = static_cast<FlatHashMap<int, int>&&>(fmCopy);
+  OZ_CHECK(fmCopy.isEmpty() && fm.size() == hm.size());
+
+  FlatHashSet<String> fs = {"foo", "bar", "baz"};
+  OZ_CHECK(fs.contains("foo") && fs.contains("baz") && !fs.contains("qux"));
+  OZ_CHECK(fs.exclude("bar") && !fs.contains("bar") && fs.size() == 2);
+}
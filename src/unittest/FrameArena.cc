@@ -0,0 +1,141 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "unittest.hh"
+
+using namespace oz;
+
+struct Counted
+{
+  static int nAlive;
+
+  int value = 0;
+
+  Counted()
+  {
+    ++nAlive;
+  }
+
+  Counted(const Counted& c)
+    : value(c.value)
+  {
+    ++nAlive;
+  }
+
+  ~Counted()
+  {
+    --nAlive;
+  }
+
+  Counted& operator=(const Counted&) = default;
+};
+
+int Counted::nAlive = 0;
+
+static void tick(int n)
+{
+  FrameList<int>     ints;
+  FrameList<Counted> counted;
+
+  for (int i = 0; i < n; ++i) {
+    ints.add(i);
+    counted.add(Counted());
+    counted.last().value = i;
+  }
+
+  OZ_CHECK(ints.size() == n && counted.size() == n);
+
+  for (int i = 0; i < n; ++i) {
+    OZ_CHECK(ints[i] == i && counted[i].value == i);
+  }
+}
+
+void test_FrameArena()
+{
+  Log() << "+ FrameArena";
+
+  FrameArena arena(64);
+
+  OZ_CHECK(arena.capacity() == 0 && arena.used() == 0);
+
+  char* a = static_cast<char*>(arena.allocate(1));
+  char* b = static_cast<char*>(arena.allocate(3));
+
+  OZ_CHECK(a != nullptr && b == a + OZ_ALIGNMENT);
+  OZ_CHECK(Alloc::alignDown(a) == a && Alloc::alignDown(b) == b);
+  OZ_CHECK(!arena.resize(a, 2 * OZ_ALIGNMENT));
+  OZ_CHECK(arena.resize(b, 2 * OZ_ALIGNMENT) && arena.used() == 3 * OZ_ALIGNMENT);
+
+  // Overflow into a larger block, the exhausted one is freed on reset.
+  char* c = static_cast<char*>(arena.allocate(100));
+
+  OZ_CHECK(c != nullptr && arena.capacity() >= 100 && arena.used() == Alloc::alignUp(size_t(100)));
+
+  size_t capacity = arena.capacity();
+
+  arena.reset();
+  OZ_CHECK(arena.capacity() == capacity && arena.used() == 0);
+  OZ_CHECK(arena.allocate(1) == c);
+
+  // Lists grow in place while on the top of the arena and release elements on destruction.
+  tick(1000);
+  OZ_CHECK(Counted::nAlive == 0);
+
+  // Memory of the last allocation is reclaimed immediately.
+  size_t used = FrameArena::local().used();
+
+  {
+    FrameList<int> scoped;
+
+    for (int i = 0; i < 100; ++i) {
+      scoped.add(i);
+    }
+    OZ_CHECK(FrameArena::local().used() == used + Alloc::alignUp(scoped.capacity() * sizeof(int)));
+  }
+  OZ_CHECK(FrameArena::local().used() == used);
+
+  FrameArena::local().reset();
+  tick(1000);
+  FrameArena::local().reset();
+
+#ifdef OZ_ALLOCATOR
+  int sumCount = Alloc::sumCount;
+
+  tick(1000);
+  FrameArena::local().reset();
+
+  OZ_CHECK(Alloc::sumCount == sumCount);
+#endif
+
+  FrameList<int> l;
+
+  l.add(1);
+  l.add(2);
+  l.trim();
+  OZ_CHECK_CONTENTS(l, 1, 2);
+
+  l.clear();
+  l.trim();
+  OZ_CHECK(l.capacity() == 0 && l.begin() == nullptr);
+
+  FrameArena::local().reset();
+}
@@ -0,0 +1,157 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "unittest.hh"
+
+using namespace oz;
+
+static const int N_THREADS    = 4;
+static const int N_ITERATIONS = 20000;
+
+static Mutex        mutex;
+static RWLock       rwLock;
+static PhaseBarrier barrier(N_THREADS);
+static int          counter;
+static int          values[2];
+static Atomic<int>  nInconsistent;
+static Atomic<int>  nLast;
+static int          phaseValues[N_THREADS];
+
+static void testMutex()
+{
+  counter = 0;
+
+  Thread threads[N_THREADS];
+  for (Thread& thread : threads) {
+    thread = Thread("mutex", [](void*)
+    {
+      for (int i = 0; i < N_ITERATIONS; ++i) {
+        mutex.lock();
+        ++counter;
+        mutex.unlock();
+      }
+    });
+  }
+  for (Thread& thread : threads) {
+    thread.join();
+  }
+
+  OZ_CHECK(counter == N_THREADS * N_ITERATIONS);
+  OZ_CHECK(mutex.tryLock() && !mutex.tryLock());
+  mutex.unlock();
+}
+
+static void testRWLock()
+{
+  values[0] = 0;
+  values[1] = 0;
+  nInconsistent.store<ATOMIC_RELAXED>(0);
+
+  // Writers keep both values equal, readers must never see them differ.
+  Thread threads[N_THREADS];
+  for (int i = 0; i < N_THREADS; ++i) {
+    threads[i] = Thread("rwLock", [](void* data)
+    {
+      bool isWriter = data != nullptr;
+
+      for (int j = 0; j < N_ITERATIONS; ++j) {
+        if (isWriter && j % 8 == 0) {
+          LockGuard<RWLock> guard(rwLock);
+
+          ++values[0];
+          ++values[1];
+        }
+        else {
+          rwLock.lockRead();
+
+          if (values[0] != values[1]) {
+            nInconsistent.fetchAdd<ATOMIC_RELAXED>(1);
+          }
+
+          rwLock.unlockRead();
+        }
+      }
+    }, i % 2 == 0 ? &values : nullptr);
+  }
+  for (Thread& thread : threads) {
+    thread.join();
+  }
+
+  OZ_CHECK(nInconsistent.load<ATOMIC_RELAXED>() == 0);
+  OZ_CHECK(values[0] == N_THREADS / 2 * N_ITERATIONS / 8 && values[0] == values[1]);
+
+  OZ_CHECK(rwLock.tryLockRead() && rwLock.tryLockRead() && !rwLock.tryLock());
+  rwLock.unlockRead();
+  rwLock.unlockRead();
+  OZ_CHECK(rwLock.tryLock() && !rwLock.tryLockRead());
+  rwLock.unlock();
+}
+
+static void testPhaseBarrier()
+{
+  static const int N_PHASES = 2000;
+
+  nLast.store<ATOMIC_RELAXED>(0);
+  nInconsistent.store<ATOMIC_RELAXED>(0);
+  Arrays::fill<int, int>(phaseValues, N_THREADS, 0);
+
+  // In each phase every thread writes its value, after the barrier all of them must be current.
+  Thread threads[N_THREADS];
+  for (int i = 0; i < N_THREADS; ++i) {
+    threads[i] = Thread("barrier", [](void* data)
+    {
+      int id = int(size_t(data));
+
+      for (int phase = 1; phase <= N_PHASES; ++phase) {
+        phaseValues[id] = phase;
+
+        if (barrier.wait()) {
+          nLast.fetchAdd<ATOMIC_RELAXED>(1);
+        }
+
+        for (int j = 0; j < N_THREADS; ++j) {
+          if (phaseValues[j] != phase) {
+            nInconsistent.fetchAdd<ATOMIC_RELAXED>(1);
+          }
+        }
+
+        barrier.wait();
+      }
+    }, reinterpret_cast<void*>(size_t(i)));
+  }
+  for (Thread& thread : threads) {
+    thread.join();
+  }
+
+  OZ_CHECK(nInconsistent.load<ATOMIC_RELAXED>() == 0);
+  OZ_CHECK(nLast.load<ATOMIC_RELAXED>() == N_PHASES);
+  OZ_CHECK(barrier.phase() == 2 * N_PHASES);
+}
+
+void test_Futex()
+{
+  Log() << "+ Futex";
+
+  testMutex();
+  testRWLock();
+  testPhaseBarrier();
+}
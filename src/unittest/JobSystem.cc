@@ -0,0 +1,127 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "unittest.hh"
+
+using namespace oz;
+
+static void testJobs()
+{
+  static const int N = 100000;
+
+  static int values[N];
+
+  // parallelFor covers the whole range exactly once.
+  Arrays::fill<int, int>(values, N, 0);
+
+  JobSystem::parallelFor(0, N, 1000, [](int begin, int end)
+  {
+    for (int i = begin; i < end; ++i) {
+      ++values[i];
+    }
+  });
+
+  for (int i = 0; i < N; ++i) {
+    OZ_CHECK(values[i] == 1);
+  }
+
+  // Nested jobs, continuation runs after all of them.
+  Atomic<int> nDone = {0};
+  Atomic<int> nDoneAtContinuation = {-1};
+
+  {
+    JobSystem::Group group;
+
+    for (int i = 0; i < 100; ++i) {
+      JobSystem::run(group, [&nDone, &group]
+      {
+        for (int j = 0; j < 10; ++j) {
+          JobSystem::run(group, [&nDone]
+          {
+            nDone.fetchAdd<ATOMIC_RELAXED>(1);
+          });
+        }
+        nDone.fetchAdd<ATOMIC_RELAXED>(1);
+      });
+    }
+
+    group.then([&nDone, &nDoneAtContinuation]
+    {
+      nDoneAtContinuation.store<ATOMIC_RELAXED>(nDone.load<ATOMIC_RELAXED>());
+    });
+
+    JobSystem::wait(group);
+  }
+
+  OZ_CHECK(nDone.load<ATOMIC_RELAXED>() == 1100);
+  OZ_CHECK(nDoneAtContinuation.load<ATOMIC_RELAXED>() == 1100);
+
+  // Continuation set on a finished group runs immediately.
+  {
+    JobSystem::Group group;
+    bool             isRun = false;
+
+    group.then([&isRun]
+    {
+      isRun = true;
+    });
+
+    JobSystem::wait(group);
+    OZ_CHECK(isRun && group.isDone());
+  }
+
+  // Main-thread jobs.
+  {
+    JobSystem::Group group;
+    Atomic<int>      nMain = {0};
+
+    JobSystem::parallelFor(0, 16, 1, [&group, &nMain](int, int)
+    {
+      JobSystem::runMain(group, [&nMain]
+      {
+        OZ_CHECK(Thread::isMain());
+        nMain.fetchAdd<ATOMIC_RELAXED>(1);
+      });
+    });
+
+    JobSystem::wait(group);
+    OZ_CHECK(nMain.load<ATOMIC_RELAXED>() == 16);
+  }
+}
+
+void test_JobSystem()
+{
+  Log() << "+ JobSystem";
+
+  // Without workers everything runs on the caller's thread.
+  testJobs();
+
+  JobSystem::init(4);
+  OZ_CHECK(JobSystem::nWorkers() == 4);
+
+  for (int i = 0; i < 10; ++i) {
+    testJobs();
+  }
+
+  JobSystem::destroy();
+  OZ_CHECK(JobSystem::nWorkers() == 0);
+}
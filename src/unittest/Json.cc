@@ -0,0 +1,123 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "unittest.hh"
+
+using namespace oz;
+
+static const char SOURCE[] =
+  "// Layout\n"
+  "{\n"
+  "  \"name\": \"test\\tlayout\",\n"
+  "  \"objects\": [\n"
+  "    { \"class\": \"beast\", \"pos\": [1, 2.5, -3e2], \"items\": [] },\n"
+  "    /* second */ { \"class\": \"crate\", \"open\": true, \"owner\": null }\n"
+  "  ],\n"
+  "  \"empty\": {}\n"
+  "}\n";
+
+void test_Json()
+{
+  Log() << "+ Json";
+
+  typedef Json::Reader Reader;
+
+  Stream is(SOURCE, SOURCE + sizeof(SOURCE) - 1);
+  Reader reader(&is);
+
+  Reader::Event events[] = {
+    Reader::BEGIN_OBJECT,
+    Reader::STRING,
+    Reader::BEGIN_ARRAY,
+    Reader::BEGIN_OBJECT,
+    Reader::STRING,
+    Reader::BEGIN_ARRAY, Reader::NUMBER, Reader::NUMBER, Reader::NUMBER, Reader::END_ARRAY,
+    Reader::BEGIN_ARRAY, Reader::END_ARRAY,
+    Reader::END_OBJECT,
+    Reader::BEGIN_OBJECT,
+    Reader::STRING, Reader::BOOLEAN, Reader::NIL,
+    Reader::END_OBJECT,
+    Reader::END_ARRAY,
+    Reader::BEGIN_OBJECT, Reader::END_OBJECT,
+    Reader::END_OBJECT,
+    Reader::END,
+    Reader::END
+  };
+
+  for (Reader::Event event : events) {
+    OZ_CHECK(reader.next() == event);
+
+    if (event == Reader::STRING && reader.depth() == 1) {
+      OZ_CHECK(String::equals(reader.key(), "name"));
+      OZ_CHECK(String::equals(reader.string(), "test\tlayout") && reader.length() == 11);
+    }
+    else if (event == Reader::NUMBER && reader.depth() == 4) {
+      OZ_CHECK(reader.key() == nullptr);
+    }
+    else if (event == Reader::BEGIN_ARRAY && reader.depth() == 2) {
+      OZ_CHECK(String::equals(reader.key(), "objects"));
+    }
+  }
+  OZ_CHECK(is.available() == 0);
+
+  is.rewind();
+  reader = Reader(&is);
+
+  OZ_CHECK(reader.next() == Reader::BEGIN_OBJECT);
+  OZ_CHECK(reader.next() == Reader::STRING);
+  OZ_CHECK(reader.next() == Reader::BEGIN_ARRAY);
+  reader.skip();
+  OZ_CHECK(reader.next() == Reader::BEGIN_OBJECT && String::equals(reader.key(), "empty"));
+
+  is.rewind();
+
+  Json::Document document;
+  document.read(&is);
+
+  const Json::Document::Value& root = document.root();
+
+  OZ_CHECK(root.type() == Json::OBJECT && root.size() == 3);
+  OZ_CHECK(String::equals(root["name"].get(""), "test\tlayout") && root["name"].size() == 11);
+  OZ_CHECK(root["objects"].size() == 2 && root["empty"].type() == Json::OBJECT);
+  OZ_CHECK(root["empty"].size() == 0 && root.contains("empty") && !root.contains("missing"));
+  OZ_CHECK(root["missing"].isNull() && root["objects"][2].isNull());
+
+  const Json::Document::Value& beast = root["objects"][0];
+  const Json::Document::Value& crate = root["objects"][1];
+
+  OZ_CHECK(String::equals(beast["class"].get(""), "beast"));
+  OZ_CHECK(beast["pos"].get(Point::ORIGIN) == Point(1.0f, 2.5f, -300.0f));
+  OZ_CHECK(beast["items"].type() == Json::ARRAY && beast["items"].begin() == beast["items"].end());
+  OZ_CHECK(crate["open"].get(false) && crate.contains("owner") && crate["owner"].isNull());
+  OZ_CHECK(crate["pos"].get(Vec3(1.0f, 2.0f, 3.0f)) == Vec3(1.0f, 2.0f, 3.0f));
+  OZ_CHECK(String::equals(crate.entries()[0].key, "class"));
+
+  int nPositions = 0;
+  for (const Json::Document::Value& object : root["objects"]) {
+    nPositions += object.contains("pos");
+  }
+  OZ_CHECK(nPositions == 1);
+
+  Json::Document moved = static_cast<Json::Document&&>(document);
+
+  OZ_CHECK(document.root().isNull() && moved.root()["objects"].size() == 2);
+}
@@ -0,0 +1,95 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "unittest.hh"
+
+using namespace oz;
+
+void test_SmallList()
+{
+  Log() << "+ SmallList";
+
+  Foo::allowCopy = false;
+
+  SmallList<Foo, 4> l;
+  OZ_CHECK(l.isEmpty() && l.isInline() && l.capacity() == 4);
+
+  l.add(1);
+  l.add(2);
+  l.add(3);
+  l.add(4);
+  OZ_CHECK(l.isInline() && l.capacity() == 4);
+  OZ_CHECK_CONTENTS(l, 1, 2, 3, 4);
+
+  // Spill to heap.
+  l.add(5);
+  l.insert(0, 0);
+  OZ_CHECK(!l.isInline() && l.capacity() >= 6);
+  OZ_CHECK_CONTENTS(l, 0, 1, 2, 3, 4, 5);
+
+  // Moving heap storage steals it, moving inline elements moves them one by one.
+  SmallList<Foo, 4> m = static_cast<SmallList<Foo, 4>&&>(l);
+  OZ_CHECK(l.isEmpty() && l.isInline() && !m.isInline());
+  OZ_CHECK_CONTENTS(m, 0, 1, 2, 3, 4, 5);
+
+  m.erase(0);
+  m.eraseUnordered(0);
+  m.exclude(4);
+  OZ_CHECK_CONTENTS(m, 5, 2, 3);
+
+  // Trim moves elements back inline.
+  m.trim();
+  OZ_CHECK(m.isInline() && m.capacity() == 4);
+  OZ_CHECK_CONTENTS(m, 5, 2, 3);
+
+  l = static_cast<SmallList<Foo, 4>&&>(m);
+  OZ_CHECK(m.isEmpty() && l.isInline());
+  OZ_CHECK_CONTENTS(l, 5, 2, 3);
+
+  l.sort();
+  OZ_CHECK_CONTENTS(l, 2, 3, 5);
+  OZ_CHECK(l.contains(3) && l.index(5) == 2 && l.popLast() == 5 && l.popFirst() == 2);
+  OZ_CHECK_CONTENTS(l, 3);
+
+  Foo::allowCopy = true;
+
+  l.resize(10);
+  OZ_CHECK(l.size() == 10 && !l.isInline() && l[0] == 3 && l[9] == -1);
+
+  SmallList<Foo, 4> c = l;
+  OZ_CHECK(c == l && !c.isInline());
+
+  l.resize(2, true);
+  OZ_CHECK(l.isInline() && l.size() == 2 && l[0] == 3 && l[1] == -1);
+
+  l.reserve(8, true);
+  OZ_CHECK(!l.isInline() && l.capacity() == 8 && l.size() == 2);
+
+  l.clear();
+  l.trim();
+  OZ_CHECK(l.isEmpty() && l.isInline());
+
+  l = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  c = l;
+  OZ_CHECK(l.size() == 9 && c == l);
+  OZ_CHECK_CONTENTS(c, 1, 2, 3, 4, 5, 6, 7, 8, 9);
+}
@@ -0,0 +1,244 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "unittest.hh"
+
+using namespace oz;
+
+static void testVarInts()
+{
+  static const int     INTS[]   = { 0, 1, -1, 63, -64, 64, 127, 128, 300, -300, 0x7fffffff,
+                                    int(0x80000000) };
+  static const uint    UINTS[]  = { 0, 1, 127, 128, 16383, 16384, 0xffffffffu };
+  static const long64  LONGS[]  = { 0, -1, 1ll << 40, -(1ll << 40), 0x7fffffffffffffffll,
+                                    long64(0x8000000000000000ull) };
+
+  Stream os(0);
+
+  for (int i : INTS) {
+    os.writeVarInt(i);
+  }
+  for (uint i : UINTS) {
+    os.writeVarUInt(i);
+  }
+  for (long64 l : LONGS) {
+    os.writeVarLong64(l);
+  }
+  os.writeDeltaInt(1000005, 1000000);
+  os.writeDeltaInt(-2147483647 - 1, 2147483647);
+
+  Stream is(os.begin(), os.begin() + os.tell());
+
+  for (int i : INTS) {
+    OZ_CHECK(is.readVarInt() == i);
+  }
+  for (uint i : UINTS) {
+    OZ_CHECK(is.readVarUInt() == i);
+  }
+  for (long64 l : LONGS) {
+    OZ_CHECK(is.readVarLong64() == l);
+  }
+  OZ_CHECK(is.readDeltaInt(1000000) == 1000005);
+  OZ_CHECK(is.readDeltaInt(2147483647) == -2147483647 - 1);
+  OZ_CHECK(is.available() == 0);
+
+  // Sizes.
+  Stream ss(0);
+
+  ss.writeVarUInt(127);
+  OZ_CHECK(ss.tell() == 1);
+  ss.writeVarUInt(128);
+  OZ_CHECK(ss.tell() == 3);
+  ss.writeVarInt(-64);
+  OZ_CHECK(ss.tell() == 4);
+  ss.writeVarUInt(0xffffffffu);
+  OZ_CHECK(ss.tell() == 9);
+  ss.writeDeltaInt(1000005, 1000000);
+  OZ_CHECK(ss.tell() == 10);
+}
+
+static void testFlags()
+{
+  Stream os(0);
+
+  os.writeFlags(0xdeadbeef, 0);
+  OZ_CHECK(os.tell() == 0);
+
+  os.writeFlags(0xdeadbeef, 0xf0f0000f);
+  OZ_CHECK(os.tell() == 2);
+
+  os.writeFlags(0xdeadbeef, 0xffffffff);
+  OZ_CHECK(os.tell() == 6);
+
+  os.writeFlags(0x5, 0x7);
+  OZ_CHECK(os.tell() == 7);
+
+  Stream is(os.begin(), os.begin() + os.tell());
+
+  OZ_CHECK(is.readFlags(0xf0f0000f) == (0xdeadbeef & 0xf0f0000f));
+  OZ_CHECK(is.readFlags(0xffffffff) == 0xdeadbeef);
+  OZ_CHECK(is.readFlags(0x7) == 0x5);
+}
+
+static void testQuantized()
+{
+  const float PRECISION = 1.0f / 256.0f;
+
+  Point ref = Point(1000.0f, -1000.0f, 50.0f);
+  Point points[100];
+  Vec3  vectors[100];
+
+  for (int i = 0; i < 100; ++i) {
+    points[i]  = ref + Vec3(Math::centralRand(), Math::centralRand(), Math::centralRand()) * 20.0f;
+    vectors[i] = Vec3(Math::centralRand(), Math::centralRand(), Math::centralRand()) * 100.0f;
+  }
+
+  Stream os(0);
+
+  for (int i = 0; i < 100; ++i) {
+    os.writeQuantizedPoint(points[i], PRECISION);
+    os.writeQuantizedVec3(vectors[i], PRECISION);
+  }
+
+  int deltaBegin = os.tell();
+
+  for (int i = 0; i < 100; ++i) {
+    os.writeDeltaPoint(points[i], ref, PRECISION);
+  }
+
+  // Deltas of at most 20 m at 1/256 m precision fit into 2 bytes per component.
+  OZ_CHECK(os.tell() - deltaBegin <= 100 * 3 * 2);
+
+  Stream is(os.begin(), os.begin() + os.tell());
+  Point  quantized[100];
+
+  for (int i = 0; i < 100; ++i) {
+    quantized[i] = is.readQuantizedPoint(PRECISION);
+    Vec3 v = is.readQuantizedVec3(PRECISION);
+
+    Vec3 pd = abs(quantized[i] - points[i]);
+    Vec3 vd = abs(v - vectors[i]);
+
+    OZ_CHECK(max(max(pd.x, pd.y), pd.z) <= PRECISION * 0.5f);
+    OZ_CHECK(max(max(vd.x, vd.y), vd.z) <= PRECISION * 0.5f);
+  }
+
+  // Delta decoding returns exactly the quantised point.
+  for (int i = 0; i < 100; ++i) {
+    OZ_CHECK(is.readDeltaPoint(ref, PRECISION) == quantized[i]);
+  }
+  OZ_CHECK(is.available() == 0);
+}
+
+static void testQuats()
+{
+  Quat quats[] = {
+    Quat::ID,
+    Quat(0.0f, 0.0f, 0.0f, -1.0f),
+    Quat::rotationX(1.0f),
+    Quat::rotationZXZ(0.3f, -1.2f, 2.5f),
+    ~Quat(0.5f, -0.5f, 0.5f, -0.5f),
+    ~Quat(0.7f, 0.1f, -0.7f, 0.0f)
+  };
+
+  Stream os(0);
+
+  for (const Quat& q : quats) {
+    os.writeCompressedQuat(q);
+  }
+  OZ_CHECK(os.tell() == Arrays::size(quats) * 4);
+
+  Stream is(os.begin(), os.begin() + os.tell());
+
+  for (const Quat& q : quats) {
+    Quat r = is.readCompressedQuat();
+
+    // Either q or -q, both represent the same rotation.
+    Quat d = abs(q - r);
+    Quat e = abs(q + r);
+
+    float dMax = max(max(d.x, d.y), max(d.z, d.w));
+    float eMax = max(max(e.x, e.y), max(e.z, e.w));
+
+    OZ_CHECK(min(dMax, eMax) < 0.002f);
+    OZ_CHECK(abs(!r - 1.0f) < 0.002f);
+  }
+
+  // Decoding is stable, re-encoding a decoded quaternion yields the same bits.
+  Stream rs(0);
+
+  is.rewind();
+  for (int i = 0; i < Arrays::size(quats); ++i) {
+    rs.writeCompressedQuat(is.readCompressedQuat());
+  }
+  OZ_CHECK(Arrays::equals<char>(rs.begin(), rs.tell(), os.begin()));
+}
+
+static void testCompression()
+{
+  // Two full LZ4 chunks and a partial one.
+  int    size = 2 * Stream::CHUNK_SIZE + 1234;
+  Stream os(size, Endian::BIG);
+
+  for (int i = 0; i < size; ++i) {
+    os.writeChar(char(i % 251 < 128 ? i % 7 : i * 31 >> 3));
+  }
+
+  for (Stream::Codec codec : {Stream::LZ4, Stream::DEFLATE}) {
+    Stream cs = os.compress(codec, 6);
+    OZ_CHECK(cs.capacity() != 0 && cs.capacity() < size);
+
+    Stream ds = cs.decompress();
+    OZ_CHECK(ds.capacity() == size && ds.order() == Endian::BIG);
+    OZ_CHECK(Arrays::equals<char>(ds.begin(), size, os.begin()));
+
+    // Truncated data is rejected.
+    Stream ts(cs.begin(), cs.begin() + cs.capacity() - 1);
+    OZ_CHECK(ts.decompress().capacity() == 0);
+  }
+
+  // Legacy deflate streams only store the byte order in the second header int.
+  Stream ls = os.compress(6);
+  OZ_CHECK(ls.begin()[4] == char(Endian::BIG) && ls.begin()[5] == 0);
+
+  Stream ds = ls.decompress();
+  OZ_CHECK(ds.capacity() == size && Arrays::equals<char>(ds.begin(), size, os.begin()));
+
+  // Data shorter than one chunk.
+  Stream ss(0);
+  ss.writeString("short");
+
+  Stream cs = ss.compress(Stream::LZ4);
+  ds        = cs.decompress();
+  OZ_CHECK(ds.capacity() == ss.tell() && String::equals(ds.readString(), "short"));
+}
+
+void test_Stream()
+{
+  Log() << "+ Stream";
+
+  testVarInts();
+  testFlags();
+  testQuantized();
+  testQuats();
+  testCompression();
+}
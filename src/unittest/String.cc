@@ -0,0 +1,78 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "unittest.hh"
+
+#include <cstdio>
+
+using namespace oz;
+
+void test_String()
+{
+  Log() << "+ String";
+
+  static const long64 INTS[] = {
+    0, 1, -1, 9, 10, -10, 12345, -99999, 0x7fffffff, -0x7fffffffll - 1,
+    0x7fffffffffffffffll, -0x7fffffffffffffffll - 1
+  };
+
+  char buffer[String::INT_BUFFER_SIZE];
+  char expected[64];
+
+  for (long64 i : INTS) {
+    int length = String::formatInt(buffer, i);
+
+    snprintf(expected, sizeof(expected), "%lld", i);
+    OZ_CHECK(String::equals(buffer, expected));
+    OZ_CHECK(length == String::length(expected));
+  }
+
+  static const double FLOATS[] = {
+    0.0, 1.0, -1.0, 3.14159265, -2.71828, 1234.5678, -0.626, 100.0, 1e-7, 123456789.0, 9.99999
+  };
+
+  char floatBuffer[String::FLOAT_BUFFER_SIZE];
+
+  for (double d : FLOATS) {
+    for (int precision = 0; precision <= 9; ++precision) {
+      int length = String::formatFloat(floatBuffer, d, precision);
+
+      snprintf(expected, sizeof(expected), "%.*f", precision, d);
+
+      OZ_CHECK(String::equals(floatBuffer, expected));
+      OZ_CHECK(length == String::length(floatBuffer));
+    }
+  }
+
+  String::formatFloat(floatBuffer, -0.001, 2);
+  OZ_CHECK(String::equals(floatBuffer, "0.00"));
+
+  // Ties are rounded away from zero.
+  String::formatFloat(floatBuffer, 2.5, 0);
+  OZ_CHECK(String::equals(floatBuffer, "3"));
+
+  String::formatFloat(floatBuffer, -0.0625, 3);
+  OZ_CHECK(String::equals(floatBuffer, "-0.063"));
+
+  String::formatFloat(floatBuffer, 1e300, 3);
+  OZ_CHECK(String::equals(floatBuffer, "1.000e+300"));
+}
@@ -0,0 +1,64 @@
+/*
+ * liboz - OpenZone Core Library.
+ *
+ * Copyright © 2002-2016 Davorin Učakar
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgement in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "unittest.hh"
+
+using namespace oz;
+
+void test_System()
+{
+  Log() << "+ System";
+
+  const System::CpuTopology& topology = System::cpuTopology();
+
+  OZ_CHECK(topology.nCpus >= 1 && topology.nCpus <= System::MAX_CPUS);
+  OZ_CHECK(topology.nCores >= 1 && topology.nCores <= topology.nCpus);
+  OZ_CHECK(topology.nPackages >= 1 && topology.nPackages <= topology.nCores);
+
+  // Every core has exactly one primary hardware thread.
+  int nPrimaries = 0;
+
+  for (int i = 0; i < topology.nCpus; ++i) {
+    const System::Cpu& cpu = topology.cpus[i];
+
+    OZ_CHECK(cpu.core >= 0 && cpu.core < topology.nCores);
+    OZ_CHECK(i == 0 || cpu.id > topology.cpus[i - 1].id);
+
+    nPrimaries += cpu.isPrimary;
+  }
+  OZ_CHECK(nPrimaries == topology.nCores);
+
+  // Free placement leaves threads alone.
+  OZ_CHECK(!Thread::place(Thread::CRITICAL, 0));
+  OZ_CHECK(!Thread::place(Thread::BACKGROUND));
+
+#ifdef __linux__
+  int cpus[System::MAX_CPUS];
+
+  for (int i = 0; i < topology.nCpus; ++i) {
+    cpus[i] = topology.cpus[i].id;
+  }
+
+  OZ_CHECK(Thread::setAffinity(cpus, topology.nCpus));
+  OZ_CHECK(Thread::setPriority(Thread::NORMAL));
+#endif
+}
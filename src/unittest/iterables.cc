@@ -44,6 +44,10 @@ void test_iterables()
   HashSet<Foo>::Iterator       ihs;
   HashMap<Foo, Foo>::CIterator ichm;
   HashMap<Foo, Foo>::Iterator  ihtm;
+  FlatHashSet<Foo>::CIterator      icfhs;
+  FlatHashSet<Foo>::Iterator       ifhs;
+  FlatHashMap<Foo, Foo>::CIterator icfhm;
+  FlatHashMap<Foo, Foo>::Iterator  ifhm;
 
   List<Foo*>::Iterator         invalid;
 
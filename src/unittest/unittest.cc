@@ -47,6 +47,19 @@ int main()
   test_common();
   test_iterables();
   test_arrays();
+  test_Atom();
+  test_Batch();
+  test_Bitset();
+  test_ConcurrentPool();
+  test_FlatHashMap();
+  test_FrameArena();
+  test_Futex();
+  test_JobSystem();
+  test_Json();
+  test_SmallList();
+  test_Stream();
+  test_String();
+  test_System();
 
 #ifdef OZ_ALLOCATOR
   test_Alloc();
@@ -155,6 +155,19 @@ struct Foo : oz::DChainNode<Foo>
 void test_common();
 void test_iterables();
 void test_arrays();
+void test_Atom();
+void test_Batch();
+void test_Bitset();
+void test_ConcurrentPool();
+void test_FlatHashMap();
+void test_FrameArena();
+void test_Futex();
+void test_JobSystem();
+void test_Json();
+void test_SmallList();
+void test_Stream();
+void test_String();
+void test_System();
 
 void test_Alloc();
 